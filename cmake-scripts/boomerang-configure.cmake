@@ -12,6 +12,7 @@
 option(BOOMERANG_BUILD_GUI              "Build the GUI. Requires Qt5Widgets." ON)
 option(BOOMERANG_BUILD_CLI              "Build the command line interface." ON)
 option(BOOMERANG_BUILD_UNIT_TESTS       "Build the unit tests. Requires Qt5Test." OFF)
+option(BOOMERANG_BUILD_BENCHMARKS       "Build the benchmark suite." OFF)
 
 if (BOOMERANG_BUILD_CLI)
     option(BOOMERANG_BUILD_REGRESSION_TESTS "Build the regression tests. Requires Python 3." OFF)
@@ -22,6 +23,21 @@ if ("${CMAKE_CXX_COMPILER_ID}" MATCHES "GNU")
 endif ("${CMAKE_CXX_COMPILER_ID}" MATCHES "GNU")
 
 option(BOOMERANG_INSTALL_SAMPLES "Install sample binaries." OFF)
+option(BOOMERANG_ENABLE_ALLOC_PROFILING "Count heap allocations when profiling passes. Replaces the global operator new." OFF)
+
+if (BOOMERANG_ENABLE_ALLOC_PROFILING)
+    add_definitions(-DBOOMERANG_ALLOC_PROFILING=1)
+else ()
+    add_definitions(-DBOOMERANG_ALLOC_PROFILING=0)
+endif ()
+
+option(BOOMERANG_ENABLE_NODE_POOL "Allocate expressions and statements from pooled memory instead of the global heap." OFF)
+
+if (BOOMERANG_ENABLE_NODE_POOL)
+    add_definitions(-DBOOMERANG_NODE_POOL=1)
+else ()
+    add_definitions(-DBOOMERANG_NODE_POOL=0)
+endif ()
 
 
 # Check for big/little endian
@@ -29,3 +29,8 @@ if (BOOMERANG_BUILD_REGRESSION_TESTS)
         "${CMAKE_SOURCE_DIR}/tests/regression-tests/expected-outputs"
     )
 endif (BOOMERANG_BUILD_REGRESSION_TESTS)
+
+
+if (BOOMERANG_BUILD_BENCHMARKS)
+    add_subdirectory(${CMAKE_SOURCE_DIR}/tests/benchmarks)
+endif (BOOMERANG_BUILD_BENCHMARKS)
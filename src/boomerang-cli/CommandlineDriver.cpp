@@ -15,6 +15,7 @@
 #include "boomerang/util/log/Log.h"
 
 #include <QCoreApplication>
+#include <QFileInfo>
 #include <QTextStream>
 
 #include <iostream>
@@ -52,12 +53,17 @@ static void help()
 "Decoding/decompilation options\n"
 "  --decode-only    : Decode only, do not decompile\n"
 "  --ssl <file>     : Use <file> as SSL specification file\n"
+"  --cache <file>   : Load the decoded program from decode cache <file> instead of\n"
+"                     decoding it again; create <file> after decoding if it does not exist\n"
 "  -e <addr>        : Decode or decompile the procedure beginning at addr, and callees\n"
 "  -E <addr>        : Equivalent to -nc -e <addr>\n"
 "  -ic              : Decode through type 0 Indirect Calls\n"
 "  -S <min>         : Stop decompilation after specified number of minutes\n"
 "  -t               : Trace (print address of) every instruction decoded\n"
 "  -a               : Assume ABI compliance\n"
+"  --threads <n>    : Use <n> threads for procedure local analyses (default 1)\n"
+"  --profile <file> : Profile decompilation passes; write a summary to <file>.json\n"
+"                     and a Chrome trace to <file>.trace.json\n"
 "\n"
 "Output\n"
 "  --version        : Print version information and exit\n"
@@ -195,6 +201,41 @@ int CommandlineDriver::applyCommandline(const QStringList &args)
             m_project->getSettings()->sslFileName = args[i];
             continue;
         }
+        else if (arg == "--profile") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            m_project->getSettings()->profileFile = args[i];
+            continue;
+        }
+        else if (arg == "--cache") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            m_project->getSettings()->decodeCacheFile = args[i];
+            continue;
+        }
+        else if (arg == "--threads") {
+            if (++i == args.size()) {
+                help();
+                return 1;
+            }
+
+            bool converted       = false;
+            const int numThreads = args[i].toInt(&converted, 0);
+            if (!converted || numThreads < 1) {
+                std::cerr << "'--threads': Bad argument '" << args[i].toStdString()
+                          << "' (try --help)." << std::endl;
+                return 1;
+            }
+
+            m_project->getSettings()->numThreads = numThreads;
+            continue;
+        }
         else if (arg == "-o") {
             if (++i == args.size()) {
                 help();
@@ -508,6 +549,18 @@ bool CommandlineDriver::loadAndDecode(const QString &fname, const QString &pname
 {
     assert(m_project);
 
+    const QString &cacheFile = m_project->getSettings()->decodeCacheFile;
+
+    // The decode cache is only used if it was created from the same binary file.
+    if (!cacheFile.isEmpty() && QFileInfo(cacheFile).exists()) {
+        if (m_project->loadDecodeCache(cacheFile, fname)) {
+            m_project->getProg()->setName(pname);
+            return true;
+        }
+
+        LOG_WARN("Cannot use decode cache '%1', decoding '%2' again", cacheFile, fname);
+    }
+
     const bool ok = m_project->loadBinaryFile(fname);
     if (!ok) {
         LOG_ERROR("Loading '%1' failed.", fname);
@@ -518,7 +571,15 @@ bool CommandlineDriver::loadAndDecode(const QString &fname, const QString &pname
     assert(prog);
 
     prog->setName(pname);
-    return m_project->decodeBinaryFile();
+    if (!m_project->decodeBinaryFile()) {
+        return false;
+    }
+
+    if (!cacheFile.isEmpty() && !m_project->writeDecodeCache(cacheFile)) {
+        LOG_WARN("Writing decode cache '%1' failed", cacheFile);
+    }
+
+    return true;
 }
 
 
@@ -16,6 +16,7 @@
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
+#include "boomerang/decomp/ProcScheduler.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/RTL.h"
 #include "boomerang/ssl/Register.h"
@@ -36,6 +37,8 @@
 #include "boomerang/util/ByteUtil.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
+#include <map>
 #include <stdexcept>
 
 
@@ -45,6 +48,9 @@
 // index of the "else" branch of conditional jumps
 #define BELSE 1
 
+/// Number of procedures per thread whose code is generated before it is written
+static constexpr const std::size_t PROCS_PER_THREAD = 16;
+
 
 CCodeGenerator::CCodeGenerator(Project *project)
     : ICodeGenerator(project)
@@ -91,6 +97,9 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
         print(prog->getRootModule());
     }
 
+    std::vector<UserProc *> procs;
+    std::vector<const Module *> procModules;
+
     for (const auto &module : prog->getModuleList()) {
         if (!generate_all && (module.get() != cluster)) {
             continue;
@@ -111,8 +120,51 @@ void CCodeGenerator::generateCode(const Prog *prog, Module *cluster, UserProc *p
                 continue;
             }
 
-            generateCode(_proc);
-            print(module.get());
+            procs.push_back(_proc);
+            procModules.push_back(module.get());
+        }
+    }
+
+    // Structuring and emitting code only changes the procedure itself, so procedures
+    // are generated in parallel, each by its own generator. The procedures are generated
+    // in batches and written out after each batch, so only the code of a single batch
+    // is held in memory at a time.
+    const int numThreads        = std::max(1, prog->getProject()->getSettings()->numThreads);
+    const std::size_t batchSize = static_cast<std::size_t>(numThreads) * PROCS_PER_THREAD;
+
+    for (std::size_t batchStart = 0; batchStart < procs.size(); batchStart += batchSize) {
+        const std::size_t batchEnd = std::min(batchStart + batchSize, procs.size());
+        const std::vector<UserProc *> batch(procs.begin() + batchStart, procs.begin() + batchEnd);
+
+        // All entries of the map are created beforehand,
+        // so the workers do not modify the map itself.
+        std::map<const UserProc *, QStringList> procCode;
+        for (UserProc *_proc : batch) {
+            procCode[_proc];
+        }
+
+        // Removing unused locals notifies the project watchers, which are not thread safe,
+        // so it is done before generating the code in parallel.
+        for (UserProc *_proc : batch) {
+            if (_proc->getCFG() && _proc->getEntryFragment()) {
+                PassManager::get()->executePass(PassID::UnusedLocalRemoval, _proc);
+            }
+        }
+
+        ProcScheduler::forEachProc(batch, numThreads, [&procCode](UserProc *_proc) {
+            CCodeGenerator procGen(_proc->getProg()->getProject());
+            procGen.generateCode(_proc);
+            procCode.at(_proc) = std::move(procGen.m_lines);
+        });
+
+        // Write the code in the original order of modules and procedures.
+        for (std::size_t i = batchStart; i < batchEnd; ++i) {
+            m_lines = std::move(procCode.at(procs[i]));
+            print(procModules[i]);
+
+            if (procs[i]->getCFG() && procs[i]->getEntryFragment()) {
+                procs[i]->setStatus(ProcStatus::CodegenDone);
+            }
         }
     }
 }
@@ -424,7 +476,6 @@ void CCodeGenerator::generateCode(UserProc *proc)
     }
 
     m_analyzer.structureCFG(proc->getCFG());
-    PassManager::get()->executePass(PassID::UnusedLocalRemoval, proc);
 
     // Note: don't try to remove unused statements here; that requires the
     // RefExps, which are all gone now (transformed out of SSA form)!
@@ -462,8 +513,6 @@ void CCodeGenerator::generateCode(UserProc *proc)
     if (m_proc->getProg()->getProject()->getSettings()->removeLabels) {
         removeUnusedLabels();
     }
-
-    proc->setStatus(ProcStatus::CodegenDone);
 }
 
 
@@ -476,13 +525,21 @@ void CCodeGenerator::generateDataSectionCode(const BinaryImage *image, QString s
               Const::get(size ? size : static_cast<uint32_t>(-1)));
     auto l = Terminal::get(opNil);
 
-    for (unsigned int i = 0; i < size; i++) {
-        Byte value = 0;
-        if (!image->readNative1(section_start + size - 1 - i, value)) {
-            break;
+    std::vector<Byte> data(size);
+    if (size > 0 && image->readNativeArray1(section_start, data.data(), size)) {
+        for (unsigned int i = 0; i < size; i++) {
+            l = Binary::get(opList, Const::get(data[size - 1 - i] & 0xFF), l);
         }
+    }
+    else {
+        for (unsigned int i = 0; i < size; i++) {
+            Byte value = 0;
+            if (!image->readNative1(section_start + size - 1 - i, value)) {
+                break;
+            }
 
-        l = Binary::get(opList, Const::get(value & 0xFF), l);
+            l = Binary::get(opList, Const::get(value & 0xFF), l);
+        }
     }
 
     addGlobal(section_name, ArrayType::get(IntegerType::get(8, Sign::Unsigned), size), l);
@@ -137,7 +137,9 @@ private:
     /// Add a prototype (for forward declaration)
     void addPrototype(UserProc *proc);
 
-    /// Generate code for a single procedure.
+    /// Generate code for a single procedure into m_lines. Unused locals must have been
+    /// removed before (cf. UnusedLocalRemovalPass).
+    /// Does not notify any watchers, so it can be called from worker threads.
     void generateCode(UserProc *proc);
 
     /// Generate global variables from data sections.
@@ -15,23 +15,55 @@
 #include <stdexcept>
 
 
+/// Size of the blocks written to the output files
+static constexpr const int FLUSH_SIZE = 1024 * 1024;
+
+
 CodeWriter::WriteDest::WriteDest(const QString &outFileName)
     : m_outFile(outFileName)
-    , m_os(&m_outFile)
 {
     if (!m_outFile.open(QFile::WriteOnly | QFile::Text)) {
         throw std::runtime_error("Could not open file!");
     }
+
+    // Reserving the capacity keeps the allocation when the buffer is flushed.
+    m_buffer.reserve(FLUSH_SIZE + FLUSH_SIZE / 4);
 }
 
 
-CodeWriter::CodeWriter::WriteDest::~WriteDest()
+CodeWriter::WriteDest::~WriteDest()
 {
-    m_os.flush();
+    flush();
     m_outFile.close();
 }
 
 
+void CodeWriter::WriteDest::write(const QStringList &lines)
+{
+    if (lines.isEmpty()) {
+        m_buffer.append('\n');
+    }
+
+    for (const QString &line : lines) {
+        m_buffer.append(line.toUtf8());
+        m_buffer.append('\n');
+
+        if (m_buffer.size() >= FLUSH_SIZE) {
+            flush();
+        }
+    }
+}
+
+
+void CodeWriter::WriteDest::flush()
+{
+    if (!m_buffer.isEmpty()) {
+        m_outFile.write(m_buffer);
+        m_buffer.resize(0);
+    }
+}
+
+
 CodeWriter::CodeWriter()
 {
 }
@@ -58,6 +90,6 @@ bool CodeWriter::writeCode(const Module *module, const QStringList &lines)
     }
 
     assert(it != m_dests.end());
-    it->second << lines.join('\n') << '\n';
+    it->second.write(lines);
     return true;
 }
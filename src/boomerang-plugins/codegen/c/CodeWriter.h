@@ -10,8 +10,7 @@
 #pragma once
 
 
-#include "boomerang/util/OStream.h"
-
+#include <QByteArray>
 #include <QFile>
 #include <QStringList>
 
@@ -21,6 +20,11 @@
 class Module;
 
 
+/**
+ * Writes generated code to the output files of the modules.
+ * The code is encoded as UTF-8 into a buffer per file, which is written to the file
+ * in large blocks, so the memory used does not grow with the size of the output.
+ */
 class CodeWriter
 {
     struct WriteDest
@@ -37,17 +41,15 @@ class CodeWriter
         WriteDest &operator=(WriteDest &&) = delete;
 
     public:
-        template<typename T>
-        OStream &operator<<(T val)
-        {
-            m_os << val;
-            m_os.flush();
-            return m_os;
-        }
+        /// Append \p lines to the buffer, each line terminated by a newline.
+        void write(const QStringList &lines);
+
+        /// Write the contents of the buffer to the file.
+        void flush();
 
     private:
         QFile m_outFile;
-        OStream m_os;
+        QByteArray m_buffer;
     };
 
     typedef std::map<const Module *, WriteDest> WriteDestMap;
@@ -19,15 +19,95 @@
 #include "boomerang/ssl/statements/CaseStatement.h"
 #include "boomerang/util/log/Log.h"
 
+#include <atomic>
+#include <vector>
+
+
+/// Capstone contexts of the threads other than the owner thread of a decoder.
+/// There are at most as many contexts as threads that used the decoder at the same time.
+struct CapstoneDecoder::ContextPool
+{
+    explicit ContextPool(cs::cs_mode initialMode)
+        : mode(initialMode)
+    {
+    }
+
+    /// \returns a context that is not used by any other thread.
+    DisassemblyContext acquire(cs::cs_arch arch)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (unusedContexts.empty()) {
+            return createContext(arch, mode);
+        }
+
+        DisassemblyContext context = unusedContexts.back();
+        unusedContexts.pop_back();
+        return context;
+    }
+
+    /// Make \p context available to other threads again.
+    void release(DisassemblyContext &context)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (closed) {
+            destroyContext(context);
+        }
+        else {
+            unusedContexts.push_back(context);
+        }
+    }
+
+    /// Called when the decoder is destroyed. Contexts that are still used by other threads
+    /// are destroyed when these threads exit.
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        closed = true;
+        for (DisassemblyContext &context : unusedContexts) {
+            destroyContext(context);
+        }
+
+        unusedContexts.clear();
+    }
+
+    std::atomic<cs::cs_mode> mode; ///< Disassembly mode of the decoder
+    std::atomic<bool> closed{ false };
+
+    std::mutex mutex;
+    std::vector<DisassemblyContext> unusedContexts;
+};
+
+
+/// A context used by the current thread. Returned to its pool when the thread exits.
+struct CapstoneDecoder::ThreadContext
+{
+    ThreadContext(std::shared_ptr<ContextPool> _pool, DisassemblyContext _context)
+        : pool(std::move(_pool))
+        , context(_context)
+    {
+    }
+
+    ~ThreadContext() { pool->release(context); }
+
+    std::shared_ptr<ContextPool> pool;
+    DisassemblyContext context;
+};
+
 
 CapstoneDecoder::CapstoneDecoder(Project *project, cs::cs_arch arch, cs::cs_mode mode,
                                  const QString &sslFileName)
     : IDecoder(project)
     , m_dict(project->getSettings()->debugDecoder)
     , m_debugMode(project->getSettings()->debugDecoder)
+    , m_arch(arch)
+    , m_ownerThread(std::this_thread::get_id())
+    , m_contextPool(std::make_shared<ContextPool>(mode))
 {
-    cs::cs_open(arch, mode, &m_handle);
-    cs::cs_option(m_handle, cs::CS_OPT_DETAIL, cs::CS_OPT_ON);
+    m_ownerContext = createContext(arch, mode);
+    m_handle       = m_ownerContext.handle;
 
     const Settings *settings = project->getSettings();
     QString realSSLFileName;
@@ -48,7 +128,8 @@ CapstoneDecoder::CapstoneDecoder(Project *project, cs::cs_arch arch, cs::cs_mode
 
 CapstoneDecoder::~CapstoneDecoder()
 {
-    cs::cs_close(&m_handle);
+    m_contextPool->close();
+    destroyContext(m_ownerContext);
 }
 
 
@@ -59,6 +140,114 @@ bool CapstoneDecoder::initialize(Project *project)
 }
 
 
+CapstoneDecoder::TemplateInfo CapstoneDecoder::lookupTemplate(const QString &templateName,
+                                                              int numOperands) const
+{
+    // Take the argument, convert it to upper case and remove any .'s
+    const QString sanitizedName = QString(templateName).remove(".").toUpper();
+
+    TemplateInfo info;
+    info.name       = templateName;
+    info.templateID = m_dict.getTemplateID(sanitizedName, numOperands);
+    return info;
+}
+
+
+std::unique_ptr<RTL> CapstoneDecoder::instantiateRTL(const MachineInstruction &insn)
+{
+    if (m_debugMode) {
+        QString argNames;
+        for (std::size_t i = 0; i < insn.getNumOperands(); i++) {
+            if (i != 0) {
+                argNames += " ";
+            }
+            argNames += insn.m_operands[i]->toString();
+        }
+
+        LOG_MSG("Instantiating RTL at %1: %2 %3", insn.m_addr, insn.m_templateName, argNames);
+    }
+
+    if (insn.m_templateID != -1) {
+        return m_dict.instantiateRTL(insn.m_templateID, insn.m_addr, insn.m_operands);
+    }
+
+    // Take the argument, convert it to upper case and remove any .'s
+    const QString sanitizedName = QString(insn.m_templateName).remove(".").toUpper();
+    return m_dict.instantiateRTL(sanitizedName, insn.m_addr, insn.m_operands);
+}
+
+
+void CapstoneDecoder::setMode(cs::cs_mode mode)
+{
+    // The contexts of other threads are updated when they are used next.
+    m_contextPool->mode = mode;
+
+    cs::cs_option(m_ownerContext.handle, cs::CS_OPT_MODE, mode);
+    m_ownerContext.mode = mode;
+}
+
+
+CapstoneDecoder::DisassemblyContext &CapstoneDecoder::getContext()
+{
+    if (std::this_thread::get_id() == m_ownerThread) {
+        return m_ownerContext;
+    }
+
+    // The contexts of the current thread, one for each decoder used by the thread.
+    static thread_local std::vector<std::unique_ptr<ThreadContext>> threadContexts;
+
+    DisassemblyContext *context = nullptr;
+
+    for (auto it = threadContexts.begin(); it != threadContexts.end();) {
+        if ((*it)->pool == m_contextPool) {
+            context = &(*it)->context;
+            ++it;
+        }
+        else if ((*it)->pool->closed) {
+            it = threadContexts.erase(it); // the decoder does not exist anymore
+        }
+        else {
+            ++it;
+        }
+    }
+
+    if (context == nullptr) {
+        threadContexts.emplace_back(
+            new ThreadContext(m_contextPool, m_contextPool->acquire(m_arch)));
+        context = &threadContexts.back()->context;
+    }
+
+    const cs::cs_mode mode = m_contextPool->mode;
+    if (context->mode != mode) {
+        cs::cs_option(context->handle, cs::CS_OPT_MODE, mode);
+        context->mode = mode;
+    }
+
+    return *context;
+}
+
+
+CapstoneDecoder::DisassemblyContext CapstoneDecoder::createContext(cs::cs_arch arch,
+                                                                   cs::cs_mode mode)
+{
+    DisassemblyContext context;
+
+    cs::cs_open(arch, mode, &context.handle);
+    cs::cs_option(context.handle, cs::CS_OPT_DETAIL, cs::CS_OPT_ON);
+    context.insn = cs::cs_malloc(context.handle);
+    context.mode = mode;
+
+    return context;
+}
+
+
+void CapstoneDecoder::destroyContext(DisassemblyContext &context)
+{
+    cs::cs_free(context.insn, 1);
+    cs::cs_close(&context.handle);
+}
+
+
 bool CapstoneDecoder::isInstructionInGroup(const cs::cs_insn *instruction, uint8_t group) const
 {
     for (int i = 0; i < instruction->detail->groups_count; i++) {
@@ -13,6 +13,13 @@
 #include "boomerang/ifc/IDecoder.h"
 #include "boomerang/ssl/RTLInstDict.h"
 
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+
 
 namespace cs
 {
@@ -43,14 +50,74 @@ public:
 public:
     const RTLInstDict *getDict() const override { return &m_dict; }
 
+    /// \copydoc IDecoder::supportsConcurrentDisassembly
+    bool supportsConcurrentDisassembly() const override { return true; }
+
+protected:
+    /// The SSL template of an instruction, as determined by the derived decoder.
+    struct TemplateInfo
+    {
+        QString name;        ///< e.g. MOV.reg32.imm32
+        int templateID = -1; ///< ID of the template in m_dict, or -1 if there is none
+    };
+
+    /// Capstone state used for disassembling instructions on a single thread.
+    struct DisassemblyContext
+    {
+        cs::csh handle    = 0;
+        cs::cs_insn *insn = nullptr;                   ///< Buffer for cs_disasm_iter
+        cs::cs_mode mode  = cs::CS_MODE_LITTLE_ENDIAN; ///< Current mode of \ref handle
+    };
+
 protected:
     bool initialize(Project *project) override;
 
+    /// Change the disassembly mode of all Capstone handles.
+    void setMode(cs::cs_mode mode);
+
+    /**
+     * \returns the Capstone state of the current thread. Threads other than the thread
+     * that created the decoder get their own Capstone handles, so they can disassemble
+     * instructions concurrently. A thread keeps its handle until it exits;
+     * the handle is then reused by the next thread that needs one.
+     */
+    DisassemblyContext &getContext();
+
     bool isInstructionInGroup(const cs::cs_insn *instruction, uint8_t group) const;
 
+    /// Looks up the ID of the SSL template \p templateName taking \p numOperands operands.
+    TemplateInfo lookupTemplate(const QString &templateName, int numOperands) const;
+
+    /**
+     * Instantiates the SSL template of \p insn, replacing formal parameters
+     * with the operands of \p insn.
+     * If the template ID of \p insn is known, no string operations are performed.
+     */
+    std::unique_ptr<RTL> instantiateRTL(const MachineInstruction &insn);
+
+private:
+    struct ContextPool;
+    struct ThreadContext;
+
+    static DisassemblyContext createContext(cs::cs_arch arch, cs::cs_mode mode);
+    static void destroyContext(DisassemblyContext &context);
+
 protected:
     cs::csh m_handle;
     Prog *m_prog = nullptr;
     RTLInstDict m_dict;
     bool m_debugMode = false;
+
+    /// Protects the template caches of derived decoders during concurrent disassembly.
+    std::mutex m_templateMutex;
+
+private:
+    cs::cs_arch m_arch;
+
+    std::thread::id m_ownerThread;
+    DisassemblyContext m_ownerContext; ///< Context of the thread that created the decoder
+
+    /// Contexts of other threads. Shared with these threads, since they might exit
+    /// (and return their contexts) after the decoder has been destroyed.
+    std::shared_ptr<ContextPool> m_contextPool;
 };
@@ -138,14 +138,6 @@ CapstoneX86Decoder::CapstoneX86Decoder(Project *project)
     if (m_dict.getRegDB()->getRegNameByNum(REG_X86_ESP).isEmpty()) {
         throw std::runtime_error("Required register #28 (%esp) not present");
     }
-
-    m_insn = cs::cs_malloc(m_handle);
-}
-
-
-CapstoneX86Decoder::~CapstoneX86Decoder()
-{
-    cs::cs_free(m_insn, 1);
 }
 
 
@@ -157,9 +149,9 @@ bool CapstoneX86Decoder::initialize(Project *project)
 
     const int bitness = project->getLoadedBinaryFile()->getBitness();
     switch (bitness) {
-    case 16: cs::cs_option(m_handle, cs::CS_OPT_MODE, cs::CS_MODE_16); break;
-    case 32: cs::cs_option(m_handle, cs::CS_OPT_MODE, cs::CS_MODE_32); break;
-    case 64: cs::cs_option(m_handle, cs::CS_OPT_MODE, cs::CS_MODE_64); break;
+    case 16: setMode(cs::CS_MODE_16); break;
+    case 32: setMode(cs::CS_MODE_32); break;
+    case 64: setMode(cs::CS_MODE_64); break;
     default: return false;
     }
 
@@ -174,35 +166,40 @@ bool CapstoneX86Decoder::disassembleInstruction(Address pc, ptrdiff_t delta,
     size_t size                 = X86_MAX_INSTRUCTION_LENGTH;
     uint64 addr                 = pc.value();
 
-    const bool valid = cs_disasm_iter(m_handle, &instructionData, &size, &addr, m_insn);
+    DisassemblyContext &context = getContext();
+    cs::cs_insn *insn           = context.insn;
+
+    const bool valid = cs_disasm_iter(context.handle, &instructionData, &size, &addr, insn);
 
     if (!valid) {
         return false;
     }
 
-    result.m_addr = Address(m_insn->address);
-    result.m_id   = m_insn->id;
-    result.m_size = m_insn->size;
+    result.m_addr = Address(insn->address);
+    result.m_id   = insn->id;
+    result.m_size = insn->size;
 
-    std::strncpy(result.m_mnem.data(), m_insn->mnemonic, MNEM_SIZE);
-    std::strncpy(result.m_opstr.data(), m_insn->op_str, OPSTR_SIZE);
+    std::strncpy(result.m_mnem.data(), insn->mnemonic, MNEM_SIZE);
+    std::strncpy(result.m_opstr.data(), insn->op_str, OPSTR_SIZE);
     result.m_mnem[MNEM_SIZE - 1]   = '\0';
     result.m_opstr[OPSTR_SIZE - 1] = '\0';
 
-    const std::size_t numOperands = m_insn->detail->x86.op_count;
+    const std::size_t numOperands = insn->detail->x86.op_count;
     result.m_operands.resize(numOperands);
 
     for (std::size_t i = 0; i < numOperands; ++i) {
-        result.m_operands[i] = operandToExp(m_insn->detail->x86.operands[i]);
+        result.m_operands[i] = operandToExp(insn->detail->x86.operands[i]);
     }
 
-    result.m_templateName = getTemplateName(m_insn);
+    const TemplateInfo templ = getTemplate(insn);
+    result.m_templateName    = templ.name;
+    result.m_templateID      = templ.templateID;
 
-    result.setGroup(MIGroup::Jump, isInstructionInGroup(m_insn, cs::CS_GRP_JUMP));
-    result.setGroup(MIGroup::Call, isInstructionInGroup(m_insn, cs::CS_GRP_CALL));
+    result.setGroup(MIGroup::Jump, isInstructionInGroup(insn, cs::CS_GRP_JUMP));
+    result.setGroup(MIGroup::Call, isInstructionInGroup(insn, cs::CS_GRP_CALL));
     result.setGroup(MIGroup::BoolAsgn, result.m_templateName.startsWith("SET"));
-    result.setGroup(MIGroup::Ret, isInstructionInGroup(m_insn, cs::CS_GRP_RET) ||
-                                      isInstructionInGroup(m_insn, cs::CS_GRP_IRET));
+    result.setGroup(MIGroup::Ret, isInstructionInGroup(insn, cs::CS_GRP_RET) ||
+                                      isInstructionInGroup(insn, cs::CS_GRP_IRET));
 
     if (result.isInGroup(MIGroup::Jump) || result.isInGroup(MIGroup::Call)) {
         assert(result.getNumOperands() > 0);
@@ -419,28 +416,6 @@ std::unique_ptr<RTL> CapstoneX86Decoder::createRTLForInstruction(const MachineIn
 }
 
 
-std::unique_ptr<RTL> CapstoneX86Decoder::instantiateRTL(const MachineInstruction &insn)
-{
-    // Take the argument, convert it to upper case and remove any .'s
-    const QString sanitizedName   = QString(insn.m_templateName).remove(".").toUpper();
-    const std::size_t numOperands = insn.getNumOperands();
-
-    if (m_debugMode) {
-        QString argNames;
-        for (std::size_t i = 0; i < numOperands; i++) {
-            if (i != 0) {
-                argNames += " ";
-            }
-            argNames += insn.m_operands[i]->toString();
-        }
-
-        LOG_MSG("Instantiating RTL at %1: %2 %3", insn.m_addr, insn.m_templateName, argNames);
-    }
-
-    return m_dict.instantiateRTL(sanitizedName, insn.m_addr, insn.m_operands);
-}
-
-
 bool CapstoneX86Decoder::genBSFR(const MachineInstruction &insn, LiftedInstruction &result)
 {
     // Note the horrible hack needed here. We need initialisation code, and an extra branch, so the
@@ -546,6 +521,39 @@ bool CapstoneX86Decoder::genBSFR(const MachineInstruction &insn, LiftedInstructi
 }
 
 
+CapstoneDecoder::TemplateInfo CapstoneX86Decoder::getTemplate(const cs::cs_insn *instruction)
+{
+    const int numOperands         = instruction->detail->x86.op_count;
+    const cs::cs_x86_op *operands = instruction->detail->x86.operands;
+
+    // The template only depends on the instruction ID, the prefix and the types and sizes
+    // of the operands, so pack them into a single key: 16 bits instruction ID,
+    // 8 bits prefix, 4 bits number of operands and 9 bits per operand.
+    if (numOperands > 4 || instruction->id > 0xFFFF) {
+        return lookupTemplate(getTemplateName(instruction), numOperands);
+    }
+
+    uint64 key = instruction->id;
+    key        = (key << 8) | instruction->detail->x86.prefix[0];
+    key        = (key << 4) | numOperands;
+
+    for (int i = 0; i < numOperands; i++) {
+        key = (key << 2) | (operands[i].type & 0x3);
+        key = (key << 7) | (operands[i].size & 0x7F);
+    }
+
+    std::lock_guard<std::mutex> lock(m_templateMutex);
+
+    auto it = m_templates.find(key);
+    if (it == m_templates.end()) {
+        const QString name = getTemplateName(instruction);
+        it                 = m_templates.emplace(key, lookupTemplate(name, numOperands)).first;
+    }
+
+    return it->second;
+}
+
+
 QString CapstoneX86Decoder::getTemplateName(const cs::cs_insn *instruction) const
 {
     const int numOperands         = instruction->detail->x86.op_count;
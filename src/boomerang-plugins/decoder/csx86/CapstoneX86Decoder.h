@@ -24,7 +24,6 @@ class BOOMERANG_PLUGIN_API CapstoneX86Decoder : public CapstoneDecoder
 {
 public:
     CapstoneX86Decoder(Project *project);
-    ~CapstoneX86Decoder();
 
 public:
     /// \copydoc IDecoder::decodeInstruction
@@ -53,17 +52,6 @@ private:
      */
     std::unique_ptr<RTL> createRTLForInstruction(const MachineInstruction &insn);
 
-    /**
-     * Instantiates an RTL for a single instruction, replacing formal parameters with actual
-     * arguments from \p operands.
-     *
-     * \param pc the address of the instruction.
-     * \param instructionID the unique name of the instruction (e.g. MOV.reg32.reg32)
-     * \param numOperands number of instruction operands (e.g. 2 for MOV.reg32.reg32)
-     * \param operands Array containing actual arguments containing \p numOperands elements.
-     */
-    std::unique_ptr<RTL> instantiateRTL(const MachineInstruction &insn);
-
     /**
      * Generate statements for the BSF and BSR instructions (Bit Scan Forward/Reverse)
      * \note Since SSL does not support loops yet, we have to build the semantics using a state
@@ -76,6 +64,11 @@ private:
     /// \returns the name of the SSL template for \p instruction
     QString getTemplateName(const cs::cs_insn *instruction) const;
 
+    /// \returns the SSL template for \p instruction. The template name is only built
+    /// the first time an instruction with the same operand types and sizes is encountered.
+    TemplateInfo getTemplate(const cs::cs_insn *instruction);
+
 private:
-    cs::cs_insn *m_insn; ///< decoded instruction;
+    /// Templates of already decoded instructions, see \ref getTemplate
+    std::unordered_map<uint64, TemplateInfo> m_templates;
 };
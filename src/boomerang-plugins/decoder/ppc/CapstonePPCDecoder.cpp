@@ -96,8 +96,8 @@ bool CapstonePPCDecoder::disassembleInstruction(Address pc, ptrdiff_t delta,
     const Byte *instructionData = reinterpret_cast<const Byte *>((HostAddress(delta) + pc).value());
 
     cs::cs_insn *decodedInstruction;
-    size_t numInstructions = cs_disasm(m_handle, instructionData, PPC_INSN_LENGTH, pc.value(), 1,
-                                       &decodedInstruction);
+    size_t numInstructions = cs_disasm(getContext().handle, instructionData, PPC_INSN_LENGTH,
+                                       pc.value(), 1, &decodedInstruction);
     const bool valid       = numInstructions > 0;
 
     if (!valid) {
@@ -134,7 +134,9 @@ bool CapstonePPCDecoder::disassembleInstruction(Address pc, ptrdiff_t delta,
         result.m_operands[i] = operandToExp(decodedInstruction->detail->ppc.operands[i]);
     }
 
-    result.m_templateName = getTemplateName(decodedInstruction);
+    const TemplateInfo templ = getTemplate(decodedInstruction);
+    result.m_templateName    = templ.name;
+    result.m_templateID      = templ.templateID;
 
     result.setGroup(MIGroup::Call, isCall(decodedInstruction));
     result.setGroup(MIGroup::Jump, isJump(decodedInstruction));
@@ -321,26 +323,6 @@ std::unique_ptr<RTL> CapstonePPCDecoder::createRTLForInstruction(const MachineIn
 }
 
 
-std::unique_ptr<RTL> CapstonePPCDecoder::instantiateRTL(const MachineInstruction &insn)
-{
-    if (m_debugMode) {
-        QString argNames;
-        for (std::size_t i = 0; i < insn.getNumOperands(); i++) {
-            if (i != 0) {
-                argNames += " ";
-            }
-            argNames += insn.m_operands[i]->toString();
-        }
-
-        LOG_MSG("Instantiating RTL at %1: %2 %3", insn.m_addr, insn.m_templateName, argNames);
-    }
-
-    // Take the argument, convert it to upper case and remove any .'s
-    const QString sanitizedName = QString(insn.m_templateName).remove(".").toUpper();
-    return m_dict.instantiateRTL(sanitizedName, insn.m_addr, insn.m_operands);
-}
-
-
 bool CapstonePPCDecoder::isCRManip(const cs::cs_insn *instruction) const
 {
     switch (instruction->id) {
@@ -378,6 +360,36 @@ QString CapstonePPCDecoder::getTemplateName(const cs::cs_insn *instruction) cons
 }
 
 
+CapstoneDecoder::TemplateInfo CapstonePPCDecoder::getTemplate(const cs::cs_insn *instruction)
+{
+    const int numOperands = instruction->detail->ppc.op_count;
+
+    // The template name is derived from the mnemonic, which only depends on the instruction ID,
+    // the branch condition and whether CR0 is updated (e.g. add vs. add.). Some mnemonics
+    // take a varying number of operands (e.g. cmpwi with or without CR field), so pack
+    // all of them into a single key: 16 bits instruction ID, 8 bits branch condition,
+    // 1 bit CR0 update and 4 bits number of operands.
+    if (numOperands > 0xF || instruction->id > 0xFFFF) {
+        return lookupTemplate(getTemplateName(instruction), numOperands);
+    }
+
+    uint64 key = instruction->id;
+    key        = (key << 8) | (instruction->detail->ppc.bc & 0xFF);
+    key        = (key << 1) | (instruction->detail->ppc.update_cr0 ? 1 : 0);
+    key        = (key << 4) | numOperands;
+
+    std::lock_guard<std::mutex> lock(m_templateMutex);
+
+    auto it = m_templates.find(key);
+    if (it == m_templates.end()) {
+        const QString name = getTemplateName(instruction);
+        it                 = m_templates.emplace(key, lookupTemplate(name, numOperands)).first;
+    }
+
+    return it->second;
+}
+
+
 bool CapstonePPCDecoder::isCall(const cs::cs_insn *instruction) const
 {
     const int id = instruction->id;
@@ -41,8 +41,6 @@ public:
 private:
     std::unique_ptr<RTL> createRTLForInstruction(const MachineInstruction &insn);
 
-    std::unique_ptr<RTL> instantiateRTL(const MachineInstruction &insn);
-
     /// \returns true if the instruction is a CR manipulation instruction, e.g. crxor
     bool isCRManip(const cs::cs_insn *instruction) const;
 
@@ -54,4 +52,13 @@ private:
 
     /// \returns the name of the SSL template for \p instruction
     QString getTemplateName(const cs::cs_insn *instruction) const;
+
+    /// \returns the SSL template for \p instruction. The template name is only built
+    /// the first time an instruction with the same instruction ID, branch condition
+    /// and number of operands is encountered.
+    TemplateInfo getTemplate(const cs::cs_insn *instruction);
+
+private:
+    /// Templates of already decoded instructions, see \ref getTemplate
+    std::unordered_map<uint64, TemplateInfo> m_templates;
 };
@@ -322,8 +322,8 @@ void X86FrontEnd::processOverlapped(UserProc *proc)
 {
     // first, lets look for any uses of the registers
     std::set<RegNum> usedRegs;
-    StatementList stmts;
-    proc->getStatements(stmts);
+    std::vector<SharedStmt> stmts;
+    proc->getStatementSnapshot(stmts);
 
     for (SharedStmt s : stmts) {
         LocationSet locs;
@@ -95,13 +95,26 @@ void ElfBinaryLoader::init()
 }
 
 
+bool ElfBinaryLoader::loadFromFile(BinaryFile *file)
+{
+    initialize(file, file->getSymbols());
+
+    BinaryImage *image = file->getImage();
+    return loadFromBytes(image->getRawBytes(), image->getRawSize());
+}
+
+
 bool ElfBinaryLoader::loadFromMemory(QByteArray &img)
 {
-    m_loadedImageSize = img.size();
+    return loadFromBytes(reinterpret_cast<Byte *>(img.data()), img.size());
+}
 
-    // Allocate memory to hold the file
-    m_loadedImage = reinterpret_cast<Byte *>(img.data());
-    m_elfHeader   = reinterpret_cast<Elf32_Ehdr *>(img.data()); // Save a lot of casts
+
+bool ElfBinaryLoader::loadFromBytes(Byte *img, size_t imgSize)
+{
+    m_loadedImageSize = imgSize;
+    m_loadedImage     = img;
+    m_elfHeader       = reinterpret_cast<Elf32_Ehdr *>(img); // Save a lot of casts
 
     if (m_loadedImageSize < sizeof(Elf32_Ehdr)) {
         LOG_ERROR("Cannot load ELF file: File size too small");
@@ -44,6 +44,10 @@ public:
     /// \copydoc IFileLoader::canLoad
     int canLoad(QIODevice &fl) const override;
 
+    /// \copydoc IFileLoader::loadFromFile
+    /// Loads the image in place, i.e. memory mapped files are not copied.
+    bool loadFromFile(BinaryFile *file) override;
+
     /// \copydoc IFileLoader::loadFromMemory
     /// Note that empty sections will not be added to the image.
     bool loadFromMemory(QByteArray &img) override;
@@ -75,6 +79,9 @@ private:
     /// we're up to
     void init();
 
+    /// Load the ELF file in \p img. All sections will point into \p img.
+    bool loadFromBytes(Byte *img, size_t imgSize);
+
     /// \returns true if this file is a shared library file.
     bool isLibrary() const;
 
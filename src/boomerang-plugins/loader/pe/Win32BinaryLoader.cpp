@@ -84,7 +84,6 @@ Win32BinaryLoader::Win32BinaryLoader(Project *project)
     , m_peHeader(nullptr)
     , m_numRelocs(0)
     , m_hasDebugInfo(false)
-    , m_mingwMain(false)
     , m_binaryImage(nullptr)
     , m_symbols(nullptr)
 {
@@ -410,7 +409,6 @@ Address Win32BinaryLoader::getMainEntryPoint()
                         const BinarySymbol *dest_sym = m_symbols->findSymbolByAddress(desti);
 
                         if (dest_sym && (dest_sym->getName() == "ExitProcess")) {
-                            m_mingwMain = true;
                             return Address(READ4_LE(m_peHeader->Imagebase)) + lastlastcall + 5 +
                                    READ4_LE_P(m_image + lastlastcall.value() + 1);
                         }
@@ -1022,149 +1020,16 @@ bool Win32BinaryLoader::isStaticLinkedLibProc(Address addr) const
     if (m_hasDebugInfo && (line.FileName == nullptr) || line.FileName && (*line.FileName == 'f')) {
         return true;
     }
+#else
+    Q_UNUSED(addr);
 #endif
 
-    return (isMinGWsAllocStack(addr) || isMinGWsFrameInit(addr) || isMinGWsFrameEnd(addr) ||
-            isMinGWsCleanupSetup(addr) || isMinGWsMalloc(addr));
-}
-
-
-bool Win32BinaryLoader::isMinGWsAllocStack(Address addr) const
-{
-    if (m_mingwMain) {
-        const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-        if (section) {
-            HostAddress hostAddr    = section->getHostAddr() - section->getSourceAddr() + addr;
-            unsigned char pattern[] = { 0x51, 0x89, 0xE1, 0x83, 0xC1, 0x08, 0x3D, 0x00, 0x10,
-                                        0x00, 0x00, 0x72, 0x10, 0x81, 0xE9, 0x00, 0x10, 0x00,
-                                        0x00, 0x83, 0x09, 0x00, 0x2D, 0x00, 0x10, 0x00, 0x00,
-                                        0xEB, 0xE9, 0x29, 0xC1, 0x83, 0x09, 0x00, 0x89, 0xE0,
-                                        0x89, 0xCC, 0x8B, 0x08, 0x8B, 0x40, 0x04, 0xFF, 0xE0 };
-
-            if (memcmp(hostAddr, pattern, sizeof(pattern)) == 0) {
-                return true;
-            }
-        }
-    }
-
+    // Code of statically linked runtime libraries (e.g. MinGW's) is recognized
+    // by byte patterns, cf. DefaultFrontEnd::recognizeLibraryProcs
     return false;
 }
 
 
-bool Win32BinaryLoader::isMinGWsFrameInit(Address addr) const
-{
-    if (!m_mingwMain) {
-        return false;
-    }
-
-    const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-    if (!section) {
-        return false;
-    }
-
-    HostAddress hostAddr = section->getHostAddr() - section->getSourceAddr() + addr;
-    unsigned char pat1[] = { 0x55, 0x89, 0xE5, 0x83, 0xEC, 0x18, 0x89, 0x7D, 0xFC,
-                             0x8B, 0x7D, 0x08, 0x89, 0x5D, 0xF4, 0x89, 0x75, 0xF8 };
-
-    if (memcmp(hostAddr, pat1, sizeof(pat1)) != 0) {
-        return false;
-    }
-
-    unsigned char pat2[] = { 0x85, 0xD2, 0x74, 0x24, 0x8B, 0x42, 0x2C, 0x85, 0xC0, 0x78,
-                             0x3D, 0x8B, 0x42, 0x2C, 0x85, 0xC0, 0x75, 0x56, 0x8B, 0x42,
-                             0x28, 0x89, 0x07, 0x89, 0x7A, 0x28, 0x8B, 0x5D, 0xF4, 0x8B,
-                             0x75, 0xF8, 0x8B, 0x7D, 0xFC, 0x89, 0xEC, 0x5D, 0xC3 };
-    return memcmp(hostAddr + sizeof(pat1) + 6, pat2, sizeof(pat2)) == 0;
-}
-
-
-bool Win32BinaryLoader::isMinGWsFrameEnd(Address addr) const
-{
-    if (!m_mingwMain) {
-        return false;
-    }
-
-    const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-    if (!section) {
-        return false;
-    }
-
-    HostAddress host     = section->getHostAddr() - section->getSourceAddr() + addr;
-    unsigned char pat1[] = {
-        0x55, 0x89, 0xE5, 0x53, 0x83, 0xEC, 0x14, 0x8B, 0x45, 0x08, 0x8B, 0x18
-    };
-
-    if (memcmp(host, pat1, sizeof(pat1)) != 0) {
-        return false;
-    }
-
-    unsigned char pat2[] = { 0x85, 0xC0, 0x74, 0x1B, 0x8B, 0x48, 0x2C, 0x85, 0xC9,
-                             0x78, 0x34, 0x8B, 0x50, 0x2C, 0x85, 0xD2, 0x75, 0x4D,
-                             0x89, 0x58, 0x28, 0x8B, 0x5D, 0xFC, 0xC9, 0xC3 };
-    return memcmp(host + sizeof(pat1) + 5, pat2, sizeof(pat2)) == 0;
-}
-
-
-bool Win32BinaryLoader::isMinGWsCleanupSetup(Address addr) const
-{
-    if (!m_mingwMain) {
-        return false;
-    }
-
-    const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-    if (!section) {
-        return false;
-    }
-
-    HostAddress host     = section->getHostAddr() - section->getSourceAddr() + addr;
-    unsigned char pat1[] = { 0x55, 0x89, 0xE5, 0x53, 0x83, 0xEC, 0x04 };
-
-    if (memcmp(host, pat1, sizeof(pat1)) != 0) {
-        return false;
-    }
-
-    unsigned char pat2[] = { 0x85, 0xDB, 0x75, 0x35 };
-
-    if (memcmp(host + sizeof(pat1) + 6, pat2, sizeof(pat2)) != 0) {
-        return false;
-    }
-
-    unsigned char pat3[] = { 0x83, 0xF8, 0xFF, 0x74, 0x24, 0x85, 0xC0, 0x89,
-                             0xC3, 0x74, 0x0E, 0x8D, 0x74, 0x26, 0x00 };
-    return memcmp(host + sizeof(pat1) + 6 + sizeof(pat2) + 16, pat3, sizeof(pat3)) == 0;
-}
-
-
-bool Win32BinaryLoader::isMinGWsMalloc(Address addr) const
-{
-    if (!m_mingwMain) {
-        return false;
-    }
-
-    const BinarySection *section = m_binaryImage->getSectionByAddr(addr);
-
-    if (!section) {
-        return false;
-    }
-
-    HostAddress host     = section->getHostAddr() - section->getSourceAddr() + addr;
-    unsigned char pat1[] = { 0x55, 0x89, 0xE5, 0x8D, 0x45, 0xF4, 0x83, 0xEC, 0x58,
-                             0x89, 0x45, 0xE0, 0x8D, 0x45, 0xC0, 0x89, 0x04, 0x24,
-                             0x89, 0x5D, 0xF4, 0x89, 0x75, 0xF8, 0x89, 0x7D, 0xFC };
-
-    if (memcmp(host, pat1, sizeof(pat1)) != 0) {
-        return false;
-    }
-
-    unsigned char pat2[] = { 0x89, 0x65, 0xE8 };
-    return memcmp((host + sizeof(pat1) + 0x15), pat2, sizeof(pat2)) == 0;
-}
-
-
 Address Win32BinaryLoader::getJumpTarget(Address addr) const
 {
     Byte opcode = 0;
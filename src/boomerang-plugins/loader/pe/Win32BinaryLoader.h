@@ -198,11 +198,6 @@ protected:
 
 public:
     bool isStaticLinkedLibProc(Address addr) const;
-    bool isMinGWsAllocStack(Address addr) const;
-    bool isMinGWsFrameInit(Address addr) const;
-    bool isMinGWsFrameEnd(Address addr) const;
-    bool isMinGWsCleanupSetup(Address addr) const;
-    bool isMinGWsMalloc(Address addr) const;
 
 protected:
     void processIAT();
@@ -220,7 +215,6 @@ private:
     PEHeader *m_peHeader; ///< Pointer to pe header
     int m_numRelocs;      ///< Number of relocation entries
     bool m_hasDebugInfo;
-    bool m_mingwMain;
 
     BinaryImage *m_binaryImage;
     BinarySymbolTable *m_symbols;
@@ -9,8 +9,11 @@
 #pragma endregion License
 #include "CSymbolProvider.h"
 
+#include "SignatureDatabase.h"
 #include "parser/AnsiCParserDriver.h"
 
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
 #include "boomerang/core/plugin/Plugin.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/binary/BinarySymbol.h"
@@ -20,9 +23,10 @@
 #include "boomerang/ifc/IFrontEnd.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QCryptographicHash>
 #include <QDir>
 #include <QFileInfo>
-#include <QTextStream>
+#include <QSaveFile>
 
 
 CSymbolProvider::CSymbolProvider(Project *project)
@@ -31,66 +35,74 @@ CSymbolProvider::CSymbolProvider(Project *project)
 }
 
 
+CSymbolProvider::~CSymbolProvider()
+{
+}
+
+
 bool CSymbolProvider::readLibraryCatalog(const Prog *prog, const QString &filePath)
 {
     // TODO: this is a work for generic semantics provider plugin : HeaderReader
-    QFile file(filePath);
+    const Machine machine       = prog->getMachine();
+    const QByteArray sourceHash = SignatureDatabase::computeSourceHash(filePath);
 
-    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+    if (sourceHash.isEmpty()) {
         LOG_ERROR("Cannot open library signature catalog `%1'", filePath);
         return false;
     }
 
-    QTextStream is(&file);
-
-    while (!is.atEnd()) {
-        QString sigFilePath;
-        is >> sigFilePath;
-        sigFilePath = sigFilePath.mid(0, sigFilePath.indexOf('#')); // cut the line to first '#'
-
-        if ((sigFilePath.size() > 0) && sigFilePath.endsWith('\n')) {
-            sigFilePath = sigFilePath.mid(0, sigFilePath.size() - 1);
-        }
-
-        if (sigFilePath.isEmpty()) {
-            continue;
-        }
-
-        CallConv cc = CallConv::C; // Most APIs are C calling convention
+    const QString dbPath = getDatabasePath(prog, filePath);
+    std::unique_ptr<SignatureDatabase> db(new SignatureDatabase);
 
-        if (sigFilePath == "windows.h") {
-            cc = CallConv::Pascal; // One exception
+    if (db->open(dbPath, machine, sourceHash)) {
+        if (!db->registerNamedTypes()) {
+            LOG_ERROR("Cannot read library signature database '%1'", dbPath);
+            return false;
         }
+    }
+    else {
+        LOG_VERBOSE("Compiling library signature catalog '%1'", filePath);
 
-        if (sigFilePath == "mfc.h") {
-            cc = CallConv::ThisCall; // Another exception
+        QByteArray data;
+        if (!SignatureDatabase::compile(filePath, machine, sourceHash, data) ||
+            !db->open(data, machine, sourceHash)) {
+            return false;
         }
 
-        const QString sig_path = QFileInfo(filePath).absoluteDir().absoluteFilePath(sigFilePath);
-        if (!readLibrarySignatures(qPrintable(sig_path), prog, cc)) {
-            return false;
+        QSaveFile dbFile(dbPath);
+        if (!QDir().mkpath(QFileInfo(dbPath).absolutePath()) ||
+            !dbFile.open(QFile::WriteOnly) || dbFile.write(data) != data.size() ||
+            !dbFile.commit()) {
+            LOG_WARN("Cannot write library signature database '%1'", dbPath);
         }
     }
 
+    std::lock_guard<std::mutex> lock(m_librarySignaturesMutex);
+
+    // Signatures in this catalog override the signatures of previous catalogs.
+    m_librarySignatures.clear();
+    m_databases.push_back(std::move(db));
     return true;
 }
 
 
-bool CSymbolProvider::readLibrarySignatures(const QString &signatureFile, const Prog *prog,
-                                            CallConv cc)
+QString CSymbolProvider::getDatabasePath(const Prog *prog, const QString &catalogPath) const
 {
-    AnsiCParserDriver driver;
-    if (driver.parse(signatureFile, prog->getMachine(), cc) != 0) {
-        LOG_ERROR("Cannot read library signature file '%1'", signatureFile);
-        return false;
-    }
+    const QString absCatalogPath = QFileInfo(catalogPath).absoluteFilePath();
 
-    for (std::shared_ptr<Signature> &signature : driver.signatures) {
-        m_librarySignatures[signature->getName()] = signature;
-        signature->setSigFilePath(signatureFile);
-    }
+    // Catalogs with the same name in different data directories must not share a database
+    const QString pathHash = QCryptographicHash::hash(absCatalogPath.toUtf8(),
+                                                      QCryptographicHash::Sha1)
+                                 .toHex()
+                                 .left(8);
 
-    return true;
+    const QString dbName = QString("%1-%2-%3.sigdb")
+                               .arg(QFileInfo(catalogPath).completeBaseName())
+                               .arg(static_cast<int>(prog->getMachine()))
+                               .arg(pathHash);
+
+    const QDir cacheDir = prog->getProject()->getSettings()->getCacheDirectory();
+    return cacheDir.absoluteFilePath("signatures/" + dbName);
 }
 
 
@@ -137,8 +149,24 @@ bool CSymbolProvider::addSymbolsFromSymbolFile(Prog *prog, const QString &fname)
 
 std::shared_ptr<Signature> CSymbolProvider::getSignatureByName(const QString &functionName) const
 {
+    std::lock_guard<std::mutex> lock(m_librarySignaturesMutex);
+
     auto it = m_librarySignatures.find(functionName);
-    return it != m_librarySignatures.end() ? it.value() : nullptr;
+    if (it != m_librarySignatures.end()) {
+        return it.value();
+    }
+
+    // Later catalogs override earlier ones
+    for (auto db = m_databases.rbegin(); db != m_databases.rend(); ++db) {
+        std::shared_ptr<Signature> signature = (*db)->getSignatureByName(functionName);
+
+        if (signature) {
+            m_librarySignatures[functionName] = signature;
+            return signature;
+        }
+    }
+
+    return nullptr;
 }
 
 
@@ -16,17 +16,28 @@
 
 #include <QMap>
 
+#include <memory>
+#include <mutex>
+#include <vector>
+
 
 class Prog;
+class SignatureDatabase;
 
 
-/// Symbol provider for reading signatures and symbols from C-like headers.
-/// (cf. also the files in data/signature/)
+/**
+ * Symbol provider for reading signatures and symbols from C-like headers.
+ * (cf. also the files in data/signature/)
+ *
+ * Library signature catalogs are compiled into signature databases which are stored
+ * in the cache directory (cf. Settings::getCacheDirectory) and reused as long as
+ * the catalog and its headers do not change.
+ */
 class BOOMERANG_PLUGIN_API CSymbolProvider : public ISymbolProvider
 {
 public:
     CSymbolProvider(Project *project);
-    virtual ~CSymbolProvider() = default;
+    virtual ~CSymbolProvider();
 
 public:
     /// \copydoc ISymbolProvider::readLibraryCatalog
@@ -39,8 +50,14 @@ public:
     std::shared_ptr<Signature> getSignatureByName(const QString &functionName) const override;
 
 private:
-    bool readLibrarySignatures(const QString &signatureFile, const Prog *prog, CallConv cc);
+    /// \returns the path of the compiled signature database for the catalog \p catalogPath
+    QString getDatabasePath(const Prog *prog, const QString &catalogPath) const;
 
 private:
-    QMap<QString, std::shared_ptr<Signature>> m_librarySignatures;
+    /// Databases of all catalogs read so far, in the order they were read
+    std::vector<std::unique_ptr<SignatureDatabase>> m_databases;
+
+    /// Signatures that have been looked up already
+    mutable QMap<QString, std::shared_ptr<Signature>> m_librarySignatures;
+    mutable std::mutex m_librarySignaturesMutex;
 };
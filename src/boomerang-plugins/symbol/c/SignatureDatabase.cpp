@@ -0,0 +1,410 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "SignatureDatabase.h"
+
+#include "parser/AnsiCParserDriver.h"
+
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/ssl/type/Type.h"
+#include "boomerang/util/ProgSerializer.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QtEndian>
+
+#include <algorithm>
+#include <cstring>
+#include <map>
+
+
+/// Number of quint32 fields of an index entry
+static constexpr const int INDEX_ENTRY_FIELDS = 4;
+
+enum IndexField
+{
+    NameOffset = 0,
+    NameLength,
+    SigOffset,
+    SigLength
+};
+
+
+/// Use the same stream settings as ProgSerializer, so the database does not depend on the
+/// Qt version it was written with.
+static void setupStream(QDataStream &stream)
+{
+    stream.setVersion(QDataStream::Qt_5_0);
+    stream.setByteOrder(QDataStream::LittleEndian);
+}
+
+
+static void writeHeader(QByteArray &data, Machine machine, const QByteArray &sourceHash,
+                        quint32 numSignatures, quint32 typesOffset, quint32 indexOffset,
+                        quint32 namesOffset, quint32 sigsOffset)
+{
+    data.clear();
+
+    QDataStream os(&data, QIODevice::WriteOnly);
+    setupStream(os);
+
+    os << SignatureDatabase::MAGIC << SignatureDatabase::FORMAT_VERSION
+       << ProgSerializer::FORMAT_VERSION << static_cast<quint8>(machine) << sourceHash;
+    os << numSignatures << typesOffset << indexOffset << namesOffset << sigsOffset;
+}
+
+
+SignatureDatabase::SignatureDatabase()
+{
+}
+
+
+SignatureDatabase::~SignatureDatabase()
+{
+    close();
+}
+
+
+bool SignatureDatabase::readCatalog(const QString &catalogPath,
+                                    std::vector<std::pair<QString, CallConv>> &headers)
+{
+    QFile file(catalogPath);
+
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        return false;
+    }
+
+    QTextStream is(&file);
+
+    while (!is.atEnd()) {
+        QString sigFilePath;
+        is >> sigFilePath;
+        sigFilePath = sigFilePath.mid(0, sigFilePath.indexOf('#')); // cut the line to first '#'
+
+        if ((sigFilePath.size() > 0) && sigFilePath.endsWith('\n')) {
+            sigFilePath = sigFilePath.mid(0, sigFilePath.size() - 1);
+        }
+
+        if (sigFilePath.isEmpty()) {
+            continue;
+        }
+
+        CallConv cc = CallConv::C; // Most APIs are C calling convention
+
+        if (sigFilePath == "windows.h") {
+            cc = CallConv::Pascal; // One exception
+        }
+
+        if (sigFilePath == "mfc.h") {
+            cc = CallConv::ThisCall; // Another exception
+        }
+
+        headers.push_back({ QFileInfo(catalogPath).absoluteDir().absoluteFilePath(sigFilePath),
+                            cc });
+    }
+
+    return true;
+}
+
+
+QByteArray SignatureDatabase::computeSourceHash(const QString &catalogPath)
+{
+    std::vector<std::pair<QString, CallConv>> headers;
+    if (!readCatalog(catalogPath, headers)) {
+        return QByteArray();
+    }
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    QFile catalogFile(catalogPath);
+
+    if (!catalogFile.open(QFile::ReadOnly) || !hash.addData(&catalogFile)) {
+        return QByteArray();
+    }
+
+    for (const auto &header : headers) {
+        const QString &headerPath = header.first;
+        QFile headerFile(headerPath);
+
+        if (!headerFile.open(QFile::ReadOnly)) {
+            return QByteArray();
+        }
+
+        // Hash the name as well, so that moving a declaration to another header
+        // (which changes the signature file path) also changes the hash.
+        hash.addData(QFileInfo(headerPath).fileName().toUtf8());
+
+        if (!hash.addData(&headerFile)) {
+            return QByteArray();
+        }
+    }
+
+    return hash.result();
+}
+
+
+bool SignatureDatabase::compile(const QString &catalogPath, Machine machine,
+                                const QByteArray &sourceHash, QByteArray &data)
+{
+    std::vector<std::pair<QString, CallConv>> headers;
+    if (!readCatalog(catalogPath, headers)) {
+        LOG_ERROR("Cannot open library signature catalog `%1'", catalogPath);
+        return false;
+    }
+
+    // Later definitions override earlier ones, as when reading the headers directly.
+    std::map<QByteArray, std::shared_ptr<Signature>> signatures;
+    std::vector<std::pair<QString, SharedType>> namedTypes;
+
+    for (const auto &[headerPath, cc] : headers) {
+        AnsiCParserDriver driver;
+        if (driver.parse(headerPath, machine, cc) != 0) {
+            LOG_ERROR("Cannot read library signature file '%1'", headerPath);
+            return false;
+        }
+
+        for (std::shared_ptr<Signature> &signature : driver.signatures) {
+            signature->setSigFilePath(headerPath);
+            signatures[signature->getName().toUtf8()] = signature;
+        }
+
+        namedTypes.insert(namedTypes.end(), driver.namedTypes.begin(), driver.namedTypes.end());
+    }
+
+    QByteArray types, index, names, sigs;
+
+    {
+        QDataStream os(&types, QIODevice::WriteOnly);
+        ProgSerializer serializer(os);
+
+        os << static_cast<quint32>(namedTypes.size());
+        for (const auto &[name, type] : namedTypes) {
+            os << name;
+            serializer.writeType(type);
+        }
+    }
+
+    index.reserve(static_cast<int>(signatures.size() * INDEX_ENTRY_FIELDS * sizeof(quint32)));
+
+    for (const auto &[name, signature] : signatures) {
+        QByteArray sigData;
+        QDataStream os(&sigData, QIODevice::WriteOnly);
+        ProgSerializer(os).writeSignature(signature);
+
+        const quint32 entry[INDEX_ENTRY_FIELDS] = {
+            qToLittleEndian<quint32>(names.size()), qToLittleEndian<quint32>(name.size()),
+            qToLittleEndian<quint32>(sigs.size()), qToLittleEndian<quint32>(sigData.size())
+        };
+
+        index.append(reinterpret_cast<const char *>(entry), sizeof(entry));
+        names.append(name);
+        sigs.append(sigData);
+    }
+
+    // The header has a fixed size for a given hash, so write it once to determine the offsets.
+    writeHeader(data, machine, sourceHash, 0, 0, 0, 0, 0);
+
+    const quint32 typesOffset = data.size();
+    const quint32 indexOffset = typesOffset + types.size();
+    const quint32 namesOffset = indexOffset + index.size();
+    const quint32 sigsOffset  = namesOffset + names.size();
+
+    writeHeader(data, machine, sourceHash, static_cast<quint32>(signatures.size()), typesOffset,
+                indexOffset, namesOffset, sigsOffset);
+
+    data.reserve(sigsOffset + sigs.size());
+    data.append(types).append(index).append(names).append(sigs);
+    return true;
+}
+
+
+bool SignatureDatabase::open(const QString &dbPath, Machine machine, const QByteArray &sourceHash)
+{
+    close();
+
+    m_file.setFileName(dbPath);
+    if (!m_file.open(QFile::ReadOnly) || m_file.size() == 0) {
+        close();
+        return false;
+    }
+
+    m_mapped = m_file.map(0, m_file.size());
+    if (!m_mapped) {
+        close();
+        return false;
+    }
+
+    m_data = QByteArray::fromRawData(reinterpret_cast<const char *>(m_mapped),
+                                     static_cast<int>(m_file.size()));
+
+    if (!readHeader(machine, sourceHash)) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+bool SignatureDatabase::open(const QByteArray &data, Machine machine,
+                             const QByteArray &sourceHash)
+{
+    close();
+
+    m_data = data;
+    if (!readHeader(machine, sourceHash)) {
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+
+void SignatureDatabase::close()
+{
+    m_data.clear();
+
+    if (m_mapped) {
+        m_file.unmap(m_mapped);
+        m_mapped = nullptr;
+    }
+
+    m_file.close();
+
+    m_numSignatures = 0;
+    m_typesOffset = m_indexOffset = m_namesOffset = m_sigsOffset = 0;
+}
+
+
+bool SignatureDatabase::readHeader(Machine machine, const QByteArray &sourceHash)
+{
+    QDataStream is(m_data);
+    setupStream(is);
+
+    quint32 magic = 0, version = 0, serializerVersion = 0;
+    quint8 dbMachine = 0;
+    QByteArray dbSourceHash;
+
+    is >> magic >> version >> serializerVersion >> dbMachine >> dbSourceHash;
+    is >> m_numSignatures >> m_typesOffset >> m_indexOffset >> m_namesOffset >> m_sigsOffset;
+
+    if (is.status() != QDataStream::Ok || magic != MAGIC || version != FORMAT_VERSION ||
+        serializerVersion != ProgSerializer::FORMAT_VERSION ||
+        dbMachine != static_cast<quint8>(machine) || dbSourceHash != sourceHash) {
+        return false;
+    }
+
+    const quint64 indexSize = static_cast<quint64>(m_numSignatures) * INDEX_ENTRY_FIELDS *
+                              sizeof(quint32);
+
+    return m_typesOffset <= m_indexOffset && m_indexOffset + indexSize <= m_namesOffset &&
+           m_namesOffset <= m_sigsOffset && m_sigsOffset <= static_cast<quint32>(m_data.size());
+}
+
+
+bool SignatureDatabase::registerNamedTypes() const
+{
+    if (!isOpen()) {
+        return false;
+    }
+
+    const QByteArray types = QByteArray::fromRawData(m_data.constData() + m_typesOffset,
+                                                     m_indexOffset - m_typesOffset);
+
+    QDataStream is(types);
+    ProgSerializer serializer(is);
+
+    quint32 numTypes = 0;
+    is >> numTypes;
+
+    for (quint32 i = 0; i < numTypes && is.status() == QDataStream::Ok; ++i) {
+        QString name;
+        is >> name;
+
+        SharedType type = serializer.readType();
+        if (type == nullptr) {
+            return false;
+        }
+
+        Type::addNamedType(name, type);
+    }
+
+    return is.status() == QDataStream::Ok;
+}
+
+
+std::shared_ptr<Signature> SignatureDatabase::getSignatureByName(const QString &functionName) const
+{
+    const int entry = findEntry(functionName.toUtf8());
+    if (entry < 0) {
+        return nullptr;
+    }
+
+    const quint32 sigOffset = readIndexField(entry, SigOffset);
+    const quint32 sigLength = readIndexField(entry, SigLength);
+
+    if (static_cast<quint64>(m_sigsOffset) + sigOffset + sigLength >
+        static_cast<quint64>(m_data.size())) {
+        LOG_WARN("Corrupt library signature database entry for '%1'", functionName);
+        return nullptr;
+    }
+
+    const QByteArray sigData = QByteArray::fromRawData(
+        m_data.constData() + m_sigsOffset + sigOffset, sigLength);
+
+    QDataStream is(sigData);
+    return ProgSerializer(is).readSignature();
+}
+
+
+quint32 SignatureDatabase::readIndexField(int entry, int field) const
+{
+    const char *fieldData = m_data.constData() + m_indexOffset +
+                            (entry * INDEX_ENTRY_FIELDS + field) * sizeof(quint32);
+
+    return qFromLittleEndian<quint32>(fieldData);
+}
+
+
+int SignatureDatabase::findEntry(const QByteArray &name) const
+{
+    int lo = 0;
+    int hi = static_cast<int>(m_numSignatures) - 1;
+
+    while (lo <= hi) {
+        const int mid = lo + (hi - lo) / 2;
+
+        const quint32 nameOffset = readIndexField(mid, NameOffset);
+        const quint32 nameLength = readIndexField(mid, NameLength);
+
+        if (static_cast<quint64>(m_namesOffset) + nameOffset + nameLength > m_sigsOffset) {
+            return -1; // corrupt index
+        }
+
+        const char *entryName = m_data.constData() + m_namesOffset + nameOffset;
+        const int cmp         = std::memcmp(entryName, name.constData(),
+                                    std::min<quint32>(nameLength, name.size()));
+
+        if (cmp < 0 || (cmp == 0 && nameLength < static_cast<quint32>(name.size()))) {
+            lo = mid + 1;
+        }
+        else if (cmp > 0 || nameLength > static_cast<quint32>(name.size())) {
+            hi = mid - 1;
+        }
+        else {
+            return mid;
+        }
+    }
+
+    return -1;
+}
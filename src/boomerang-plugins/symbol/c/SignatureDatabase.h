@@ -0,0 +1,138 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/db/binary/BinaryFile.h"
+#include "boomerang/frontend/SigEnum.h"
+
+#include <QByteArray>
+#include <QFile>
+#include <QString>
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+class Signature;
+
+
+/**
+ * A precompiled library signature catalog (cf. data/signatures/*.hs).
+ *
+ * Parsing all C headers listed in a catalog takes much longer than decoding small binaries,
+ * although only a few of the signatures are ever used. \ref compile parses the headers once
+ * and stores the signatures in a binary database that is indexed by function name.
+ * \ref open memory maps a database; signatures are only deserialized when they are looked up.
+ * Named types defined by the headers are stored in the database as well and must be registered
+ * via \ref registerNamedTypes, since type analysis may refer to them at any time.
+ *
+ * Each database stores a hash of the contents of the catalog and of all headers it lists
+ * (cf. \ref computeSourceHash). Databases that do not match the current hash are rejected
+ * by \ref open and have to be compiled again.
+ *
+ * Layout of a database (little endian):
+ *  - header: magic, format versions, machine, source hash, number of signatures
+ *    and offsets of the following sections
+ *  - named types (serialized by ProgSerializer)
+ *  - index: 4 x quint32 per signature (name offset, name length, signature offset,
+ *    signature length), sorted by the UTF-8 name of the function
+ *  - UTF-8 encoded function names
+ *  - signatures (serialized by ProgSerializer)
+ */
+class BOOMERANG_PLUGIN_API SignatureDatabase
+{
+public:
+    /// Identifies signature databases ("BMSD")
+    static constexpr const quint32 MAGIC = 0x424D5344;
+
+    /// Increment this every time the database format changes.
+    static constexpr const quint32 FORMAT_VERSION = 1;
+
+public:
+    SignatureDatabase();
+    SignatureDatabase(const SignatureDatabase &other) = delete;
+    SignatureDatabase(SignatureDatabase &&other)      = delete;
+
+    ~SignatureDatabase();
+
+    SignatureDatabase &operator=(const SignatureDatabase &other) = delete;
+    SignatureDatabase &operator=(SignatureDatabase &&other) = delete;
+
+public:
+    /**
+     * Read the names of the headers listed in the catalog \p catalogPath
+     * together with the calling convention of the functions declared in them.
+     * \returns false if the catalog cannot be read.
+     */
+    static bool readCatalog(const QString &catalogPath,
+                            std::vector<std::pair<QString, CallConv>> &headers);
+
+    /**
+     * \returns the hash of the contents of the catalog \p catalogPath
+     * and of all headers listed in it, or an empty hash if any of them cannot be read.
+     */
+    static QByteArray computeSourceHash(const QString &catalogPath);
+
+    /**
+     * Parse all headers listed in the catalog \p catalogPath and write the database to \p data.
+     * Named types defined by the headers are registered while parsing.
+     * \returns false if the catalog or any of the headers cannot be read.
+     */
+    static bool compile(const QString &catalogPath, Machine machine,
+                        const QByteArray &sourceHash, QByteArray &data);
+
+public:
+    /**
+     * Memory map the database in the file \p dbPath.
+     * \returns false if the file cannot be read, or if it is not a database for \p machine
+     * compiled from sources with the hash \p sourceHash.
+     */
+    bool open(const QString &dbPath, Machine machine, const QByteArray &sourceHash);
+
+    /// Open the database in \p data, as written by \ref compile.
+    /// \copydetails open(const QString &, Machine, const QByteArray &)
+    bool open(const QByteArray &data, Machine machine, const QByteArray &sourceHash);
+
+    void close();
+
+    bool isOpen() const { return !m_data.isEmpty(); }
+
+    /// Register all named types stored in the database (cf. Type::addNamedType).
+    bool registerNamedTypes() const;
+
+    int getNumSignatures() const { return m_numSignatures; }
+
+    /// \returns the signature of the function \p functionName,
+    /// or nullptr if there is no such function in the database.
+    std::shared_ptr<Signature> getSignatureByName(const QString &functionName) const;
+
+private:
+    /// Read and verify the header of the database in \ref m_data.
+    bool readHeader(Machine machine, const QByteArray &sourceHash);
+
+    /// \returns the index entry for \p name, or -1 if \p name is not in the database.
+    int findEntry(const QByteArray &name) const;
+
+    quint32 readIndexField(int entry, int field) const;
+
+private:
+    QFile m_file;
+    uchar *m_mapped = nullptr;
+    QByteArray m_data; ///< Contents of the database; does not own the data if it is mapped
+
+    quint32 m_numSignatures = 0;
+    quint32 m_typesOffset   = 0;
+    quint32 m_indexOffset   = 0;
+    quint32 m_namesOffset   = 0;
+    quint32 m_sigsOffset    = 0;
+};
@@ -171,7 +171,7 @@ decl:
 
 type_decl:
     KW_TYPEDEF type_ident SEMICOLON {
-        Type::addNamedType($2->name, $2->ty);
+        drv.addNamedType($2->name, $2->ty);
     }
   | KW_TYPEDEF type LPAREN STAR IDENTIFIER RPAREN LPAREN param_list RPAREN SEMICOLON {
         std::shared_ptr<Signature> sig = Signature::instantiate(drv.plat, drv.cc, NULL);
@@ -186,7 +186,7 @@ type_decl:
             }
         }
 
-        Type::addNamedType($5, PointerType::get(FuncType::get(sig)));
+        drv.addNamedType($5, PointerType::get(FuncType::get(sig)));
     }
   | KW_TYPEDEF type_ident LPAREN param_list RPAREN SEMICOLON  {
         std::shared_ptr<Signature> sig = Signature::instantiate(drv.plat, drv.cc, $2->name);
@@ -200,7 +200,7 @@ type_decl:
             }
         }
 
-        Type::addNamedType($2->name, FuncType::get(sig));
+        drv.addNamedType($2->name, FuncType::get(sig));
     }
   | KW_STRUCT IDENTIFIER LBRACE type_ident_list RBRACE SEMICOLON {
         std::shared_ptr<CompoundType> ty = CompoundType::get();
@@ -208,7 +208,7 @@ type_decl:
             ty->addMember(ti->ty, ti->name);
         }
 
-        Type::addNamedType(QString("struct ") + $2, ty);
+        drv.addNamedType(QString("struct ") + $2, ty);
     }
   ;
 
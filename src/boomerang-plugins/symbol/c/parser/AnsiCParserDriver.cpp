@@ -40,3 +40,10 @@ int AnsiCParserDriver::parse(const QString &fileName, Machine machine, CallConv
     scanEnd();
     return res;
 }
+
+
+void AnsiCParserDriver::addNamedType(const QString &name, SharedType type)
+{
+    Type::addNamedType(name, type);
+    namedTypes.push_back({ name, type });
+}
@@ -32,6 +32,9 @@ public:
     /// Parse the file with name. return 0 on success.
     int parse(const QString &fileName, Machine machine, CallConv cc);
 
+    /// Define a named type (typedef or struct) and remember it in \ref namedTypes.
+    void addNamedType(const QString &name, SharedType type);
+
 public:
     // The token's location used by the scanner.
     AnsiC::location location;
@@ -43,6 +46,9 @@ public:
     std::list<std::shared_ptr<Symbol>> symbols;
     std::list<std::shared_ptr<SymbolRef>> refs;
 
+    /// All named types defined by the parsed file, in order of definition.
+    std::list<std::pair<QString, SharedType>> namedTypes;
+
 private:
     // Handling the scanner.
     bool scanBegin();
@@ -140,6 +140,7 @@ void DFATypeAnalyzer::visit(const std::shared_ptr<Assign> &stmt, bool &visitChil
     SharedType newType = stmt->getType()->meetWith(tr, thisChanged, true);
     if (thisChanged) {
         stmt->setType(newType);
+        m_changed = true;
     }
 
     // This will effect rhs = rhs MEET lhs
@@ -227,8 +228,13 @@ void DFATypeAnalyzer::visit(const std::shared_ptr<CallStatement> &callStmt, bool
             std::shared_ptr<RefExp> ref = callStmt->getDest()->access<RefExp>();
             SharedStmt def              = ref->getDef();
 
-            def->setTypeForExp(ref->getSubExp1(),
-                               PointerType::get(FuncType::get(callStmt->getSignature())));
+            const SharedType destType = PointerType::get(FuncType::get(callStmt->getSignature()));
+            const SharedType oldType  = def->getTypeForExp(ref->getSubExp1());
+
+            if (!oldType || *oldType != *destType) {
+                def->setTypeForExp(ref->getSubExp1(), destType);
+                m_changed = true;
+            }
         }
     }
 
@@ -41,15 +41,20 @@
 #include "boomerang/ssl/type/SizeType.h"
 #include "boomerang/ssl/type/UnionType.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/LocationSet.h"
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expvisitor/ConstFinder.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
 #include "boomerang/visitor/stmtexpvisitor/StmtConstFinder.h"
 
+#include <algorithm>
 #include <cstring>
+#include <numeric>
 #include <sstream>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 
 #define DFA_ITER_LIMIT (100)
@@ -64,6 +69,15 @@ DFATypeRecovery::DFATypeRecovery(Project *project)
 }
 
 
+DFATypeRecovery::AnalysisStats DFATypeRecovery::getAnalysisStats(const UserProc *proc) const
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+
+    auto it = m_stats.find(proc);
+    return it != m_stats.end() ? it->second : AnalysisStats();
+}
+
+
 void DFATypeRecovery::printResults(StatementList &stmts, int iter)
 {
     LOG_VERBOSE("%1 iterations", iter);
@@ -215,6 +229,11 @@ void DFATypeRecovery::recoverFunctionTypes(Function *function)
     UserProc *up = dynamic_cast<UserProc *>(function);
     assert(up != nullptr);
 
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        m_stats[up] = AnalysisStats();
+    }
+
     do {
         if (first) {
             // Subscript the discovered extra parameters
@@ -247,49 +266,104 @@ void DFATypeRecovery::dfaTypeAnalysis(UserProc *proc)
 
     // First use the type information from the signature.
     // Sometimes needed to split variables
-    bool ch = dfaTypeAnalysis(proc->getSignature().get(), cfg);
+    dfaTypeAnalysis(proc->getSignature().get(), cfg);
     StatementList stmts;
     proc->getStatements(stmts);
 
-    int iter = 0;
+    const std::vector<SharedStmt> stmtVec(stmts.begin(), stmts.end());
+    const std::size_t numStmts = stmtVec.size();
+
+    // Visiting a statement can change its own type and the types of the definitions it uses
+    // (by descending types into its operands). So when a statement changes, the statement itself,
+    // its users, the definitions it uses and their users have to be visited again.
+    std::vector<std::vector<std::size_t>> users;
+    std::vector<std::vector<std::size_t>> defs;
+    findTypeDependencies(stmtVec, users, defs);
+
+    // The first iteration visits all statements; all later iterations only visit the statements
+    // affected by a change in the previous iteration. Types only flow along SSA references,
+    // so the analysis has reached a fixpoint when no statement is affected any more.
+    std::vector<std::size_t> toVisit(numStmts);
+    std::iota(toVisit.begin(), toVisit.end(), 0);
+
+    std::vector<std::size_t> affected;
+    std::vector<bool> isAffected(numStmts, false);
+
+    auto markAffected = [&affected, &isAffected](std::size_t idx) {
+        if (!isAffected[idx]) {
+            isAffected[idx] = true;
+            affected.push_back(idx);
+        }
+    };
 
-    for (iter = 1; iter <= DFA_ITER_LIMIT; ++iter) {
-        ch = false;
+    const bool debugTA    = proc->getProg()->getProject()->getSettings()->debugTA;
+    std::size_t numVisits = 0;
+    int iter              = 0;
+    DFATypeAnalyzer ana;
 
-        for (SharedStmt stmt : stmts) {
-            SharedStmt before = nullptr;
+    while (!toVisit.empty() && iter < DFA_ITER_LIMIT) {
+        ++iter;
 
-            if (proc->getProg()->getProject()->getSettings()->debugTA) {
-                before = stmt->clone();
-            }
+        for (std::size_t idx : toVisit) {
+            const SharedStmt &stmt = stmtVec[idx];
+            SharedStmt before      = debugTA ? stmt->clone() : nullptr;
 
-            DFATypeAnalyzer ana;
+            ana.resetChanged();
             stmt->accept(&ana);
-            const bool thisCh = ana.hasChanged();
+            numVisits++;
 
-            if (thisCh) {
-                ch = true;
+            if (!ana.hasChanged()) {
+                continue;
+            }
+
+            if (debugTA) {
+                LOG_VERBOSE("  Caused change:\n"
+                            "    FROM: %1\n"
+                            "    TO:   %2",
+                            before, stmt);
+            }
 
-                if (proc->getProg()->getProject()->getSettings()->debugTA) {
-                    LOG_VERBOSE("  Caused change:\n"
-                                "    FROM: %1\n"
-                                "    TO:   %2",
-                                before, stmt);
+            markAffected(idx);
+
+            for (std::size_t user : users[idx]) {
+                markAffected(user);
+            }
+
+            for (std::size_t def : defs[idx]) {
+                markAffected(def);
+
+                for (std::size_t user : users[def]) {
+                    markAffected(user);
                 }
             }
         }
 
-        if (!ch) {
-            // No more changes: round robin algorithm terminates
-            break;
+        // Visit the affected statements in program order, like the first iteration
+        std::sort(affected.begin(), affected.end());
+        for (std::size_t idx : affected) {
+            isAffected[idx] = false;
         }
+
+        toVisit.swap(affected);
+        affected.clear();
     }
 
-    if (ch) {
+    if (!toVisit.empty()) {
         LOG_VERBOSE("Iteration limit exceeded for dfaTypeAnalysis of procedure '%1'",
                     proc->getName());
     }
 
+    LOG_VERBOSE2("Data-flow based type analysis for '%1': %2 iterations, "
+                 "%3 visits of %4 statements",
+                 proc->getName(), iter, numVisits, numStmts);
+
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        AnalysisStats &stats = m_stats[proc];
+        stats.numIterations += iter;
+        stats.numVisits += numVisits;
+    }
+
     if (proc->getProg()->getProject()->getSettings()->debugTA) {
         LOG_MSG("### Results for data-flow based type analysis for %1 ###", proc->getName());
         printResults(stmts, iter);
@@ -550,6 +624,41 @@ bool DFATypeRecovery::doEllipsisProcessing(UserProc *proc)
 }
 
 
+void DFATypeRecovery::findTypeDependencies(const std::vector<SharedStmt> &stmts,
+                                           std::vector<std::vector<std::size_t>> &users,
+                                           std::vector<std::vector<std::size_t>> &defs)
+{
+    std::unordered_map<const Statement *, std::size_t> stmtIndex;
+    stmtIndex.reserve(stmts.size());
+
+    for (std::size_t i = 0; i < stmts.size(); ++i) {
+        stmtIndex[stmts[i].get()] = i;
+    }
+
+    users.assign(stmts.size(), {});
+    defs.assign(stmts.size(), {});
+
+    for (std::size_t i = 0; i < stmts.size(); ++i) {
+        LocationSet used;
+        stmts[i]->addUsedLocs(used);
+
+        for (const SharedExp &exp : used) {
+            if (!exp->isSubscript()) {
+                continue;
+            }
+
+            const SharedStmt &def = exp->access<RefExp>()->getDef();
+            auto it               = def ? stmtIndex.find(def.get()) : stmtIndex.end();
+
+            if (it != stmtIndex.end() && it->second != i) {
+                users[it->second].push_back(i);
+                defs[i].push_back(it->second);
+            }
+        }
+    }
+}
+
+
 void DFATypeRecovery::findConstantsInStmt(const SharedStmt &stmt,
                                           std::list<std::shared_ptr<Const>> &constants)
 {
@@ -16,6 +16,9 @@
 #include "boomerang/ssl/statements/Statement.h"
 
 #include <list>
+#include <map>
+#include <mutex>
+#include <vector>
 
 
 class ProcCFG;
@@ -42,6 +45,14 @@ class Const;
  */
 class BOOMERANG_PLUGIN_API DFATypeRecovery : public TypeRecoveryCommon
 {
+public:
+    /// Statistics of the data-flow based type analysis of a single procedure.
+    struct AnalysisStats
+    {
+        int numIterations     = 0; ///< Number of iterations over (a subset of) all statements
+        std::size_t numVisits = 0; ///< Number of visits of single statements
+    };
+
 public:
     DFATypeRecovery(Project *project);
     virtual ~DFATypeRecovery() = default;
@@ -50,6 +61,9 @@ public:
     /// \copydoc ITypeRecovery::recoverFunctionTypes
     void recoverFunctionTypes(Function *function) override;
 
+    /// \returns the statistics of the last type recovery of \p proc.
+    AnalysisStats getAnalysisStats(const UserProc *proc) const;
+
 private:
     void dfaTypeAnalysis(UserProc *proc);
     bool dfaTypeAnalysis(Signature *signature, ProcCFG *cfg);
@@ -57,6 +71,15 @@ private:
 
     void printResults(StatementList &stmts, int iter);
 
+    /**
+     * Find the SSA dependencies between \p stmts. \p users[i] will contain the indices
+     * of all statements using the definition \p stmts[i], and \p defs[i] the indices
+     * of all definitions used by \p stmts[i]. Definitions not in \p stmts are ignored.
+     */
+    void findTypeDependencies(const std::vector<SharedStmt> &stmts,
+                              std::vector<std::vector<std::size_t>> &users,
+                              std::vector<std::vector<std::size_t>> &defs);
+
     /// Replace array references of the form m[idx*K1 + K2]
     /// in \p s. Create global array variables as needed.
     void replaceArrayIndices(const SharedStmt &s);
@@ -72,4 +95,8 @@ private:
     bool doEllipsisProcessing(UserProc *proc);
 
     void findConstantsInStmt(const SharedStmt &stmt, std::list<std::shared_ptr<Const>> &constants);
+
+private:
+    mutable std::mutex m_statsMutex;
+    std::map<const UserProc *, AnalysisStats> m_stats;
 };
@@ -15,13 +15,36 @@
 #include "boomerang/db/binary/BinarySymbolTable.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/decomp/ProgDecompiler.h"
+#include "boomerang/passes/PassManager.h"
 #include "boomerang/util/CallGraphDotWriter.h"
+#include "boomerang/util/ProgSerializer.h"
 #include "boomerang/util/ProgSymbolWriter.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDir>
+#include <QFileInfo>
+#include <QSaveFile>
+
 #include <stdexcept>
 
 
+/// \returns the SHA-1 hash of the contents of the file at \p filePath,
+/// or an empty byte array if the file cannot be read.
+static QByteArray hashFile(const QString &filePath)
+{
+    QFile file(filePath);
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+
+    if (!file.open(QFile::ReadOnly) || !hash.addData(&file)) {
+        return QByteArray();
+    }
+
+    return hash.result();
+}
+
+
 Project::Project()
     : m_settings(new Settings())
     , m_pluginManager(new PluginManager(this))
@@ -123,18 +146,21 @@ bool Project::loadBinaryFile(const QString &filePath)
         unloadBinaryFile();
     }
 
-    QFile srcFile(filePath);
-    if (!srcFile.open(QFile::ReadOnly)) {
-        LOG_WARN("Opening '%1' failed");
+    // The file is memory mapped, so only the parts that are accessed are read from disk.
+    std::unique_ptr<QFile> srcFile(new QFile(filePath));
+    if (!srcFile->open(QFile::ReadOnly)) {
+        LOG_WARN("Opening '%1' failed", filePath);
         return false;
     }
 
-    m_loadedBinary.reset(new BinaryFile(srcFile.readAll(), loader));
+    m_loadedBinary.reset(new BinaryFile(std::move(srcFile), loader));
 
     if (loader->loadFromFile(m_loadedBinary.get()) == false) {
         return false;
     }
 
+    m_binaryFilePath = QFileInfo(filePath).absoluteFilePath();
+
     m_loadedBinary->getImage()->updateTextLimits();
 
     return createProg(m_loadedBinary.get(), QFileInfo(filePath).baseName()) != nullptr;
@@ -155,6 +181,98 @@ bool Project::writeSaveFile(const QString & /*filePath*/)
 }
 
 
+bool Project::loadDecodeCache(const QString &filePath, const QString &binaryFilePath)
+{
+    LOG_MSG("Loading decode cache '%1'", filePath);
+
+    QFile cacheFile(filePath);
+    if (!cacheFile.open(QFile::ReadOnly)) {
+        LOG_ERROR("Cannot load decode cache: Opening '%1' failed", filePath);
+        return false;
+    }
+
+    QDataStream stream(&cacheFile);
+    ProgSerializer serializer(stream);
+
+    QString cachedBinaryPath;
+    QByteArray binaryChecksum;
+
+    if (!serializer.readHeader(cachedBinaryPath, binaryChecksum)) {
+        LOG_ERROR("Cannot load decode cache '%1': Invalid header", filePath);
+        return false;
+    }
+
+    // The stored path is relative to the decode cache, so that the cache and the binary file
+    // can be moved together.
+    const QString binaryPath = !binaryFilePath.isEmpty()
+                                   ? binaryFilePath
+                                   : QFileInfo(filePath).absoluteDir().filePath(cachedBinaryPath);
+
+    if (!loadBinaryFile(binaryPath)) {
+        LOG_ERROR("Cannot load decode cache '%1': Loading binary file '%2' failed", filePath,
+                  binaryPath);
+        return false;
+    }
+    else if (hashFile(m_binaryFilePath) != binaryChecksum) {
+        LOG_ERROR("Cannot load decode cache '%1': Binary file '%2' was modified", filePath,
+                  binaryPath);
+        unloadBinaryFile();
+        return false;
+    }
+    else if (!m_fe) {
+        LOG_ERROR("Cannot load decode cache '%1': No suitable frontend found.", filePath);
+        unloadBinaryFile();
+        return false;
+    }
+
+    loadSymbols();
+
+    if (!serializer.readDecodedProg(getProg())) {
+        LOG_ERROR("Cannot load decode cache '%1': File is corrupt", filePath);
+        unloadBinaryFile();
+        return false;
+    }
+
+    this->alertEndDecode();
+
+    LOG_MSG("Found %1 procs", m_prog->getNumFunctions());
+    return true;
+}
+
+
+bool Project::writeDecodeCache(const QString &filePath)
+{
+    if (!m_prog) {
+        LOG_ERROR("Cannot write decode cache: No binary file is loaded.");
+        return false;
+    }
+
+    LOG_MSG("Writing decode cache '%1'", filePath);
+
+    // Do not leave a partially written decode cache behind on failure
+    QSaveFile cacheFile(filePath);
+    if (!cacheFile.open(QFile::WriteOnly)) {
+        LOG_ERROR("Cannot write decode cache: Opening '%1' failed", filePath);
+        return false;
+    }
+
+    QDataStream stream(&cacheFile);
+    ProgSerializer serializer(stream);
+
+    const QString relativeBinaryPath = QFileInfo(filePath).absoluteDir().relativeFilePath(
+        m_binaryFilePath);
+
+    if (!serializer.writeHeader(relativeBinaryPath, hashFile(m_binaryFilePath)) ||
+        !serializer.writeDecodedProg(getProg())) {
+        LOG_ERROR("Cannot write decode cache: Writing to '%1' failed", filePath);
+        cacheFile.cancelWriting();
+        return false;
+    }
+
+    return cacheFile.commit();
+}
+
+
 bool Project::isBinaryLoaded() const
 {
     return m_loadedBinary != nullptr;
@@ -165,6 +283,7 @@ void Project::unloadBinaryFile()
 {
     m_prog.reset();
     m_loadedBinary.reset();
+    m_binaryFilePath.clear();
 }
 
 
@@ -204,6 +323,7 @@ bool Project::decodeBinaryFile()
         CallGraphDotWriter().writeCallGraph(getProg(), "callgraph.dot");
     }
 
+    Log::getOrCreateLog().flush();
     return true;
 }
 
@@ -219,10 +339,29 @@ bool Project::decompileBinaryFile()
         return false;
     }
 
+    PassProfiler *profiler     = PassManager::get()->getProfiler();
+    const QString &profileFile = getSettings()->profileFile;
+
+    if (!profileFile.isEmpty()) {
+        profiler->clear();
+        profiler->setEnabled(true);
+    }
+
     LOG_MSG("Decompiling...");
     ProgDecompiler dcomp(m_prog.get());
     dcomp.decompile();
 
+    if (!profileFile.isEmpty()) {
+        profiler->setEnabled(false);
+
+        LOG_MSG("Writing pass profile to '%1.json'", profileFile);
+        if (!profiler->writeSummary(profileFile + ".json") ||
+            !profiler->writeTrace(profileFile + ".trace.json")) {
+            LOG_WARN("Writing pass profile failed");
+        }
+    }
+
+    Log::getOrCreateLog().flush();
     return true;
 }
 
@@ -244,6 +383,7 @@ bool Project::generateCode(Module *module)
         gen->generateCode(getProg(), module);
     }
 
+    Log::getOrCreateLog().flush();
     return true;
 }
 
@@ -15,6 +15,8 @@
 #include "boomerang/ifc/IFileLoader.h"
 #include "boomerang/util/Address.h"
 
+#include <QString>
+
 #include <memory>
 #include <set>
 #include <vector>
@@ -31,8 +33,6 @@ class Prog;
 class Settings;
 class UserProc;
 
-class QString;
-
 
 class BOOMERANG_API Project
 {
@@ -53,6 +53,9 @@ public:
     BinaryFile *getLoadedBinaryFile();
     const BinaryFile *getLoadedBinaryFile() const;
 
+    /// \returns the absolute path of the loaded binary file, or an empty string
+    const QString &getLoadedBinaryFilePath() const { return m_binaryFilePath; }
+
     Prog *getProg();
     const Prog *getProg() const;
 
@@ -94,6 +97,29 @@ public:
      */
     bool writeSaveFile(const QString &filePath);
 
+    /**
+     * Restore the decoded program from the decode cache at \p filePath
+     * instead of decoding the binary file again.
+     * If a binary file is already loaded, it is unloaded first (all unsaved data is lost).
+     *
+     * The binary file is loaded from \p binaryFilePath. If \p binaryFilePath is empty,
+     * the path stored in the decode cache is used, which is relative to the directory
+     * of the decode cache. The binary file must not have been modified since the
+     * decode cache was written. After loading, the program is in decoded state
+     * and can be decompiled directly.
+     * \returns true iff loading was successful.
+     */
+    bool loadDecodeCache(const QString &filePath, const QString &binaryFilePath = "");
+
+    /**
+     * Write the decoded program to the decode cache at \p filePath.
+     * If the file already exists, it is overwritten.
+     * Procedures that were already decompiled are written in decoded state.
+     * \sa ProgSerializer
+     * \returns true iff writing was successful.
+     */
+    bool writeDecodeCache(const QString &filePath);
+
     /**
      * Check if the project contains a loaded binary.
      */
@@ -213,6 +239,7 @@ private:
     std::unique_ptr<PluginManager> m_pluginManager;
 
     std::unique_ptr<BinaryFile> m_loadedBinary;
+    QString m_binaryFilePath; ///< Path of the loaded binary file
     std::unique_ptr<Prog> m_prog;
 
     IFrontEnd *m_fe = nullptr;
@@ -32,6 +32,7 @@ public:
     void setDataDirectory(const QString &directoryPath);
     void setPluginDirectory(const QString &directoryPath);
     void setOutputDirectory(const QString &directoryPath);
+    void setCacheDirectory(const QString &directoryPath);
 
     /// Get the path where the boomerang executable is run from.
     QDir getWorkingDirectory() const { return m_workingDirectory; }
@@ -45,6 +46,10 @@ public:
     /// Get the path where the decompiled files should be put
     QDir getOutputDirectory() const { return m_outputDirectory; }
 
+    /// Get the path where files that can be regenerated at any time
+    /// (e.g. compiled signature databases) are stored
+    QDir getCacheDirectory() const { return m_cacheDirectory; }
+
 public:
     // Command line flags
     bool verboseOutput       = false;
@@ -82,10 +87,18 @@ public:
     bool generateSymbols   = false;
     bool useGlobals        = true;
     bool assumeABI         = false; ///< Assume ABI compliance
+    int numThreads         = 1;     ///< Number of threads for procedure local analyses
 
     QString replayFile;  ///< file with commands to execute in interactive mode
     QString sslFileName; ///< Use this SSL file instead of one of the hard-coded ones.
 
+    /// Load the decoded program from this decode cache if it exists, and create it otherwise.
+    QString decodeCacheFile;
+
+    /// If not empty, profile all passes during decompilation and write the profile
+    /// to <profileFile>.json (summary) and <profileFile>.trace.json (Chrome trace events).
+    QString profileFile;
+
     /// Contains all known entrypoints for the Prog.
     std::vector<Address> m_entryPoints;
 
@@ -100,4 +113,5 @@ private:
     QDir m_dataDirectory;
     QDir m_pluginDirectory;
     QDir m_outputDirectory;
+    QDir m_cacheDirectory;
 };
@@ -24,6 +24,7 @@
 #include "boomerang/visitor/expmodifier/ExpSSAXformer.h"
 #include "boomerang/visitor/expmodifier/ImplicitConverter.h"
 
+#include <algorithm>
 #include <cstring>
 #include <sstream>
 
@@ -40,29 +41,6 @@ DataFlow::~DataFlow()
 }
 
 
-void DataFlow::dfs(FragIndex myIdx, FragIndex parentIdx)
-{
-    assert(myIdx != INDEX_INVALID);
-    if (m_dfnum[myIdx] >= 0) {
-        // already visited
-        return;
-    }
-
-    m_dfnum[myIdx]  = N;
-    m_vertex[N]     = myIdx;
-    m_parent[myIdx] = parentIdx;
-
-    N++;
-
-    // Recurse to successors
-    IRFragment *frag = m_frags[myIdx];
-
-    for (IRFragment *succ : frag->getSuccessors()) {
-        dfs(m_indices[succ], myIdx);
-    }
-}
-
-
 bool DataFlow::calculateDominators()
 {
     ProcCFG *cfg               = m_proc->getCFG();
@@ -86,13 +64,14 @@ bool DataFlow::calculateDominators()
 
         // These lines calculate the semi-dominator of n, based on the Semidominator Theorem
         for (IRFragment *pred : m_frags[n]->getPredecessors()) {
-            if (m_indices.find(pred) == m_indices.end()) {
+            const FragIndex v = fragToIdx(pred);
+
+            if (v == INDEX_INVALID) {
                 LOG_ERROR("Fragment not in indices: ", pred->toString());
                 return false;
             }
 
-            const FragIndex v = m_indices[pred];
-            FragIndex sdash   = v;
+            FragIndex sdash = v;
 
             if (isAncestorOf(v, n)) {
                 sdash = m_semi[getAncestorWithLowestSemi(v)];
@@ -107,11 +86,12 @@ bool DataFlow::calculateDominators()
 
         // Calculation of n's dominator is deferred until the path from s to n
         // has been linked into the forest
-        m_bucket[s].insert(n);
+        m_bucketNext[n] = m_bucketHead[s];
+        m_bucketHead[s] = n;
         link(p, n);
 
         // for each v in bucket[p]
-        for (FragIndex v : m_bucket[p]) {
+        for (FragIndex v = m_bucketHead[p]; v != INDEX_INVALID; v = m_bucketNext[v]) {
             // Now that the path from p to v has been linked into the spanning forest,
             // these lines calculate the dominator of v, based on the first clause of the
             // Dominator Theorem, or else defer the calculation until y's dominator is known.
@@ -125,7 +105,7 @@ bool DataFlow::calculateDominators()
             }
         }
 
-        m_bucket[p].clear();
+        m_bucketHead[p] = INDEX_INVALID;
     }
 
     for (std::size_t i = 1; i < N - 1; i++) {
@@ -145,22 +125,43 @@ bool DataFlow::calculateDominators()
     m_idom[entryIndex] = entryIndex;
     m_semi[entryIndex] = entryIndex;
 
-    computeDF(entryIndex); // Finally, compute the dominance frontiers
+    buildDominatorTree(entryIndex);
+    computeDF(); // Finally, compute the dominance frontiers
     return true;
 }
 
 
+FragIndex DataFlow::fragToIdx(const IRFragment *frag) const
+{
+    const FragIndex idx = frag->getIndex();
+    return (idx < m_frags.size() && m_frags[idx] == frag) ? idx : INDEX_INVALID;
+}
+
+
 FragIndex DataFlow::getAncestorWithLowestSemi(FragIndex v)
 {
     assert(v != INDEX_INVALID);
 
-    const FragIndex a = m_ancestor[v];
-    if (a != INDEX_INVALID && m_ancestor[a] != INDEX_INVALID) {
-        const FragIndex b = getAncestorWithLowestSemi(a);
-        m_ancestor[v]     = m_ancestor[a];
+    // Collect the path to the root of the forest; the last two nodes
+    // on the path do not need to be compressed.
+    std::vector<FragIndex> &path = m_evalPath;
+    path.clear();
+
+    FragIndex x = v;
+    while (m_ancestor[x] != INDEX_INVALID && m_ancestor[m_ancestor[x]] != INDEX_INVALID) {
+        path.push_back(x);
+        x = m_ancestor[x];
+    }
+
+    // Compress the path top down
+    for (auto it = path.rbegin(); it != path.rend(); ++it) {
+        const FragIndex u = *it;
+        const FragIndex a = m_ancestor[u];
+        const FragIndex b = m_best[a];
+        m_ancestor[u]     = m_ancestor[a];
 
-        if (isAncestorOf(m_semi[m_best[v]], m_semi[b])) {
-            m_best[v] = b;
+        if (isAncestorOf(m_semi[m_best[u]], m_semi[b])) {
+            m_best[u] = b;
         }
     }
 
@@ -177,64 +178,135 @@ void DataFlow::link(FragIndex p, FragIndex n)
 }
 
 
-bool DataFlow::doesDominate(FragIndex n, FragIndex w)
+void DataFlow::buildDominatorTree(FragIndex entryIdx)
 {
-    assert(n != INDEX_INVALID);
-    assert(w != INDEX_INVALID);
+    const std::size_t numFrags = m_frags.size();
 
-    while (w != INDEX_INVALID && m_idom[w] != w) {
-        if (m_idom[w] == n) {
-            return true;
+    // Count the children of each node, then fill them in ascending order
+    m_domChildrenStart.assign(numFrags + 1, 0);
+    for (FragIndex c = 0; c < numFrags; ++c) {
+        if (m_idom[c] != INDEX_INVALID && m_idom[c] != c) {
+            m_domChildrenStart[m_idom[c] + 1]++;
         }
+    }
+
+    for (std::size_t n = 0; n < numFrags; ++n) {
+        m_domChildrenStart[n + 1] += m_domChildrenStart[n];
+    }
+
+    m_domChildren.assign(m_domChildrenStart[numFrags], INDEX_INVALID);
+    std::vector<std::size_t> fill(m_domChildrenStart.begin(), m_domChildrenStart.end() - 1);
 
-        w = m_idom[w]; // Move up the dominator tree
+    for (FragIndex c = 0; c < numFrags; ++c) {
+        if (m_idom[c] != INDEX_INVALID && m_idom[c] != c) {
+            m_domChildren[fill[m_idom[c]]++] = c;
+        }
     }
 
-    return false;
+    // Number the dominator tree in depth first order
+    m_domPre.assign(numFrags, INDEX_INVALID);
+    m_domLast.assign(numFrags, INDEX_INVALID);
+    m_domPostOrder.clear();
+
+    std::vector<std::pair<FragIndex, std::size_t>> stack; // node, next child
+    FragIndex num = 0;
+
+    m_domPre[entryIdx] = num++;
+    stack.push_back({ entryIdx, m_domChildrenStart[entryIdx] });
+
+    while (!stack.empty()) {
+        const FragIndex n           = stack.back().first;
+        const std::size_t nextChild = stack.back().second;
+
+        if (nextChild < m_domChildrenStart[n + 1]) {
+            const FragIndex c = m_domChildren[nextChild];
+            stack.back().second++;
+
+            m_domPre[c] = num++;
+            stack.push_back({ c, m_domChildrenStart[c] });
+        }
+        else {
+            m_domLast[n] = num - 1;
+            m_domPostOrder.push_back(n);
+            stack.pop_back();
+        }
+    }
 }
 
 
-void DataFlow::computeDF(FragIndex n)
+bool DataFlow::doesDominate(FragIndex n, FragIndex w) const
 {
     assert(n != INDEX_INVALID);
+    assert(w != INDEX_INVALID);
 
-    std::set<FragIndex> S;
-    // This loop computes DF_local[n]
-    // for each node y in succ(n)
-    IRFragment *frag = m_frags[n];
+    if (m_domPre[n] == INDEX_INVALID || m_domPre[w] == INDEX_INVALID) {
+        return false; // not in the dominator tree
+    }
 
-    for (IRFragment *succ : frag->getSuccessors()) {
-        FragIndex y = m_indices[succ];
+    return m_domPre[n] < m_domPre[w] && m_domPre[w] <= m_domLast[n];
+}
 
-        if (m_idom[y] != n) {
-            S.insert(y);
-        }
-    }
 
-    // for each child c of n in the dominator tree
-    // Note: this is a linear search!
-    const size_t sz = m_idom.size(); // ? Was ancestor.size()
+void DataFlow::computeDF()
+{
+    const std::size_t numFrags = m_frags.size();
 
-    for (FragIndex c = FragIndex(0); c < sz; ++c) {
-        if (m_idom[c] != n) {
-            continue;
-        }
-        else if (c != n) { // do not calculate DF for entry fragment again
-            computeDF(c);
+    // The frontiers are computed bottom up, so they are collected in post order first
+    // and sorted into CSR format afterwards.
+    std::vector<std::size_t> start(numFrags, 0), count(numFrags, 0);
+    std::vector<FragIndex> frontiers;
+
+    std::vector<FragIndex> inS(numFrags, INDEX_INVALID); // inS[y] == n <=> y in DF[n]
+    std::vector<FragIndex> S;
+
+    for (FragIndex n : m_domPostOrder) {
+        S.clear();
+
+        auto addToS = [&S, &inS, n](FragIndex y) {
+            if (inS[y] != n) {
+                inS[y] = n;
+                S.push_back(y);
+            }
+        };
+
+        // This loop computes DF_local[n]
+        // for each node y in succ(n)
+        for (IRFragment *succ : m_frags[n]->getSuccessors()) {
+            const FragIndex y = fragToIdx(succ);
+
+            if (y != INDEX_INVALID && m_idom[y] != n) {
+                addToS(y);
+            }
         }
 
-        /* This loop computes DF_up[c] */
-        // for each element w of DF[c]
-        std::set<FragIndex> &s = m_DF[c];
+        // for each child c of n in the dominator tree
+        for (FragIndex c : getDomChildren(n)) {
+            /* This loop computes DF_up[c] */
+            // for each element w of DF[c]
+            for (std::size_t i = start[c]; i < start[c] + count[c]; ++i) {
+                const FragIndex w = frontiers[i];
 
-        for (FragIndex w : s) {
-            if (n == w || !doesDominate(n, w)) {
-                S.insert(w);
+                if (n == w || !doesDominate(n, w)) {
+                    addToS(w);
+                }
             }
         }
+
+        std::sort(S.begin(), S.end());
+        start[n] = frontiers.size();
+        count[n] = S.size();
+        frontiers.insert(frontiers.end(), S.begin(), S.end());
     }
 
-    m_DF[n] = S;
+    m_DFStart.assign(numFrags + 1, 0);
+    for (std::size_t n = 0; n < numFrags; ++n) {
+        m_DFStart[n + 1] = m_DFStart[n] + count[n];
+    }
+
+    m_DF.resize(frontiers.size());
+    for (std::size_t n = 0; n < numFrags; ++n) {
+        std::copy_n(frontiers.begin() + start[n], count[n], m_DF.begin() + m_DFStart[n]);
+    }
 }
 
 
@@ -283,21 +355,10 @@ bool DataFlow::placePhiFunctions()
     m_vertex.resize(0);
     m_parent.resize(0);
     m_best.resize(0);
-    m_bucket.resize(0);
+    m_bucketHead.resize(0);
+    m_bucketNext.resize(0);
     m_defsites.clear();
     m_defallsites.clear();
-
-    for (ExSet &exps : m_definedAt) {
-        for (auto iter = exps.begin(); iter != exps.end();) {
-            if (m_A_phi.find(*iter) == m_A_phi.end()) {
-                iter = exps.erase(iter);
-            }
-            else {
-                ++iter;
-            }
-        }
-    }
-
     m_definedAt.clear(); // and A_orig,
     m_defStmts.clear();  // and the map from variable to defining Stmt
 
@@ -306,10 +367,8 @@ bool DataFlow::placePhiFunctions()
     }
 
     // Set the sizes of needed vectors
-    const std::size_t numIndices = m_indices.size();
-    const std::size_t numFrags   = m_proc->getCFG()->getNumFragments();
-    assert(numIndices == numFrags);
-    Q_UNUSED(numIndices);
+    const std::size_t numFrags = m_proc->getCFG()->getNumFragments();
+    assert(m_frags.size() == numFrags);
 
     m_definedAt.resize(numFrags);
 
@@ -329,47 +388,68 @@ bool DataFlow::placePhiFunctions()
 
             // If this is a childless call, then this block defines every variable
             if (stmt->isCall() && stmt->as<CallStatement>()->isChildless()) {
-                m_defallsites.insert(n);
+                m_defallsites.set(n);
             }
 
             for (const SharedExp &exp : locationSet) {
                 if (canRename(exp)) {
-                    m_definedAt[n].insert(exp->clone());
+                    std::size_t loc = m_locations.find(exp);
+                    if (loc == LocationNumbering::INVALID) {
+                        loc = m_locations.insert(exp->clone());
+                    }
+
+                    m_definedAt[n].set(loc);
                     m_defStmts[exp] = stmt;
                 }
             }
         }
     }
 
+    // Locations numbered by earlier calls keep their index (and their phi sites)
+    const std::size_t numLocs = m_locations.size();
+    m_defsites.assign(numLocs, BitSet(numFrags));
+    m_A_phi.resize(numLocs);
+
     for (FragIndex n{ 0 }; n < numFrags; ++n) {
-        for (const SharedExp &a : m_definedAt[n]) {
-            m_defsites[a].insert(n);
-        }
+        m_definedAt[n].forEach([this, n](std::size_t loc) { m_defsites[loc].set(n); });
     }
 
-    bool change = false;
-
     // Those variables that are defined everywhere (i.e. in defallsites)
     // need to be defined at every defsite, too
-    for (FragIndex defallsite : m_defallsites) {
-        for (auto &[exp, defsites] : m_defsites) {
-            Q_UNUSED(exp);
-            defsites.insert(defallsite);
+    if (m_defallsites.any()) {
+        for (BitSet &defsites : m_defsites) {
+            if (defsites.any()) {
+                defsites.makeUnion(m_defallsites);
+            }
         }
     }
 
-    // For each variable a defined anywhere
-    for (auto &[a, defsites] : m_defsites) {
-        std::set<FragIndex> W = defsites;
+    bool change = false;
+    std::vector<FragIndex> W;
+    BitSet inW(numFrags);
+
+    // For each variable a defined anywhere. Visit the locations in sorted order
+    // so that phi functions are always created in the same order.
+    for (const auto &[a, loc] : m_locations) {
+        if (m_defsites[loc].none()) {
+            continue; // not defined (anymore)
+        }
+
+        BitSet &phiSites = m_A_phi[loc];
+
+        m_defsites[loc].forEach([&W, &inW](std::size_t n) {
+            W.push_back(n);
+            inW.set(n);
+        });
 
         while (!W.empty()) {
-            // Pop first node from W
-            const FragIndex n = *W.begin();
-            W.erase(W.begin());
+            const FragIndex n = W.back();
+            W.pop_back();
+            inW.reset(n);
 
-            for (FragIndex y : m_DF[n]) {
+            for (FragIndex y : getDF(n)) {
                 // phi function already created for y?
-                if (m_A_phi[a].find(y) != m_A_phi[a].end()) {
+                if (phiSites.test(y)) {
                     continue;
                 }
 
@@ -378,12 +458,13 @@ bool DataFlow::placePhiFunctions()
                 m_frags[y]->addPhi(a->clone());
 
                 // A_phi[a] <- A_phi[a] U {y}
-                m_A_phi[a].insert(y);
+                phiSites.set(y);
 
                 // if a !elementof A_orig[y]
-                if (!m_definedAt[y].contains(a)) {
+                if (!m_definedAt[y].test(loc) && !inW.test(y)) {
                     // W <- W U {y}
-                    W.insert(y);
+                    W.push_back(y);
+                    inW.set(y);
                 }
             }
         }
@@ -393,42 +474,60 @@ bool DataFlow::placePhiFunctions()
 }
 
 
+std::set<FragIndex> DataFlow::getA_phi(SharedExp e) const
+{
+    std::set<FragIndex> result;
+
+    const std::size_t loc = m_locations.find(e);
+    if (loc != LocationNumbering::INVALID && loc < m_A_phi.size()) {
+        m_A_phi[loc].forEach([&result](std::size_t n) { result.insert(n); });
+    }
+
+    return result;
+}
+
+
 void DataFlow::convertImplicits()
 {
     ProcCFG *cfg = m_proc->getCFG();
 
-    // Convert statements in A_phi from m[...]{-} to m[...]{0}
-    std::map<SharedExp, std::set<FragIndex>, lessExpStar> A_phi_copy = m_A_phi; // Object copy
+    // Convert locations from m[...]{-} to m[...]{0}. Several locations might be converted
+    // to the same location; in this case, the data of the last location (in sorted order) wins.
     ImplicitConverter ic(cfg);
-    m_A_phi.clear();
+    LocationNumbering newLocations;
+    std::vector<std::size_t> newIndex(m_locations.size(), LocationNumbering::INVALID);
 
-    for (auto &[exp, set] : A_phi_copy) {
-        SharedExp e = exp->clone()->acceptModifier(&ic);
-        m_A_phi[e]  = set; // Copy the set (doesn't have to be deep)
+    for (const auto &[exp, loc] : m_locations) {
+        newIndex[loc] = newLocations.insert(exp->clone()->acceptModifier(&ic));
     }
 
-    std::map<SharedExp, std::set<FragIndex>, lessExpStar> defsites_copy = m_defsites; // Object copy
-    m_defsites.clear();
-
-    for (auto &[exp, set] : defsites_copy) {
-        SharedExp e   = exp->clone()->acceptModifier(&ic);
-        m_defsites[e] = set; // Copy the set (doesn't have to be deep)
-    }
+    std::vector<BitSet> A_phi(newLocations.size());
+    std::vector<BitSet> defsites(newLocations.size());
 
-    std::vector<ExSet> definedAtCopy = m_definedAt;
-    m_definedAt.clear();
+    for (const auto &[exp, loc] : m_locations) {
+        Q_UNUSED(exp);
 
-    for (ExSet &se : definedAtCopy) {
-        ExSet se_new;
+        if (loc < m_A_phi.size()) {
+            A_phi[newIndex[loc]] = m_A_phi[loc];
+        }
 
-        for (const SharedExp &ee : se) {
-            SharedExp e = ee->clone()->acceptModifier(&ic);
-            se_new.insert(e);
+        if (loc < m_defsites.size()) {
+            defsites[newIndex[loc]] = m_defsites[loc];
         }
+    }
 
-        // Copy the set (doesn't have to be a deep copy)
-        m_definedAt.insert(m_definedAt.end(), se_new);
+    for (BitSet &definedAt : m_definedAt) {
+        BitSet converted;
+        definedAt.forEach([&converted, &newIndex](std::size_t loc) {
+            converted.set(newIndex[loc]);
+        });
+
+        definedAt = std::move(converted);
     }
+
+    m_locations = std::move(newLocations);
+    m_A_phi     = std::move(A_phi);
+    m_defsites  = std::move(defsites);
 }
 
 
@@ -438,7 +537,6 @@ void DataFlow::allocateData()
     const std::size_t numFrags = cfg->getNumFragments();
 
     m_frags.assign(numFrags, nullptr);
-    m_indices.clear();
 
     m_dfnum.assign(numFrags, -1);
     m_semi.assign(numFrags, INDEX_INVALID);
@@ -448,10 +546,15 @@ void DataFlow::allocateData()
     m_vertex.assign(numFrags, INDEX_INVALID);
     m_parent.assign(numFrags, INDEX_INVALID);
     m_best.assign(numFrags, INDEX_INVALID);
-    m_bucket.assign(numFrags, {});
-    m_DF.assign(numFrags, {});
+    m_bucketHead.assign(numFrags, INDEX_INVALID);
+    m_bucketNext.assign(numFrags, INDEX_INVALID);
+    m_DFStart.assign(numFrags + 1, 0);
+    m_DF.clear();
+    m_domChildrenStart.assign(numFrags + 1, 0);
+    m_domChildren.clear();
     m_definedAt.assign(numFrags, {});
 
+    m_locations.clear();
     m_A_phi.clear();
     m_defsites.clear();
     m_defallsites.clear();
@@ -462,12 +565,9 @@ void DataFlow::allocateData()
     // (so relying on in-edges doesn't work)
     std::size_t i = 0;
     for (IRFragment *frag : *cfg) {
+        frag->setIndex(i);
         m_frags[i++] = frag;
     }
-
-    for (std::size_t j = 0; j < numFrags; j++) {
-        m_indices[m_frags[j]] = j;
-    }
 }
 
 
@@ -479,7 +579,38 @@ void DataFlow::recalcSpanningTree()
     assert(entryIndex != INDEX_INVALID);
 
     N = 0;
-    dfs(entryIndex, INDEX_INVALID);
+
+    // Iterative depth first search; each stack entry is a fragment and its next successor.
+    std::vector<std::pair<FragIndex, std::size_t>> stack;
+
+    auto visit = [this, &stack](FragIndex idx, FragIndex parentIdx) {
+        if (idx == INDEX_INVALID || m_dfnum[idx] >= 0) {
+            return; // not part of this procedure or already visited
+        }
+
+        m_dfnum[idx]  = N;
+        m_vertex[N]   = idx;
+        m_parent[idx] = parentIdx;
+        N++;
+
+        stack.push_back({ idx, 0 });
+    };
+
+    visit(entryIndex, INDEX_INVALID);
+
+    while (!stack.empty()) {
+        const FragIndex idx                    = stack.back().first;
+        const std::size_t nextSucc             = stack.back().second;
+        const std::vector<IRFragment *> &succs = m_frags[idx]->getSuccessors();
+
+        if (nextSucc < succs.size()) {
+            stack.back().second++;
+            visit(fragToIdx(succs[nextSucc]), idx);
+        }
+        else {
+            stack.pop_back();
+        }
+    }
 }
 
 
@@ -11,10 +11,12 @@
 
 
 #include "boomerang/ssl/statements/Statement.h"
+#include "boomerang/util/BitSet.h"
+#include "boomerang/util/LocationNumbering.h"
 #include "boomerang/util/LocationSet.h"
 
 #include <map>
-#include <unordered_map>
+#include <vector>
 
 
 class IRFragment;
@@ -24,14 +26,34 @@ typedef std::size_t FragIndex;
 static constexpr const FragIndex INDEX_INVALID = FragIndex(-1);
 
 
+/// A contiguous, read-only range of fragment indices
+class FragIndexRange
+{
+public:
+    FragIndexRange(const FragIndex *begin, const FragIndex *end)
+        : m_begin(begin)
+        , m_end(end)
+    {
+    }
+
+    const FragIndex *begin() const { return m_begin; }
+    const FragIndex *end() const { return m_end; }
+
+    std::size_t size() const { return m_end - m_begin; }
+    bool empty() const { return m_begin == m_end; }
+
+private:
+    const FragIndex *m_begin;
+    const FragIndex *m_end;
+};
+
+
 /**
  * Dominator frontier code largely as per Appel 2002
  * ("Modern Compiler Implementation in Java")
  */
 class BOOMERANG_API DataFlow
 {
-    using ExSet = ExpSet<Exp>;
-
 public:
     DataFlow(UserProc *proc);
     DataFlow(const DataFlow &other) = delete;
@@ -46,7 +68,8 @@ public:
     /**
      * Calculate dominators for every node n using Lengauer-Tarjan with path compression.
      * Essentially Algorithm 19.9 of Appel's
-     * "Modern compiler implementation in Java" 2nd ed 2002
+     * "Modern compiler implementation in Java" 2nd ed 2002.
+     * Nothing is computed recursively, so arbitrarily large procedures are supported.
      */
     bool calculateDominators();
 
@@ -79,7 +102,7 @@ public:
     std::set<const IRFragment *> getDominanceFrontier(const IRFragment *frag) const
     {
         std::set<const IRFragment *> ret;
-        for (FragIndex idx : m_DF.at(fragToIdx(frag))) {
+        for (FragIndex idx : getDF(fragToIdx(frag))) {
             ret.insert(idxToFrag(idx));
         }
 
@@ -90,38 +113,52 @@ public:
     const IRFragment *idxToFrag(FragIndex node) const { return m_frags.at(node); }
     IRFragment *idxToFrag(FragIndex node) { return m_frags.at(node); }
 
-    FragIndex fragToIdx(const IRFragment *frag) const
+    /// \returns the index of \p frag, or INDEX_INVALID if \p frag was not part of the CFG
+    /// during the last call to \ref calculateDominators().
+    FragIndex fragToIdx(const IRFragment *frag) const;
+
+    /// \returns the dominance frontier of fragment \p node, sorted by fragment index
+    FragIndexRange getDF(FragIndex node) const
     {
-        return m_indices.at(const_cast<IRFragment *>(frag));
+        return FragIndexRange(m_DF.data() + m_DFStart[node], m_DF.data() + m_DFStart[node + 1]);
+    }
+
+    /// \returns the children of \p node in the dominator tree, sorted by fragment index
+    FragIndexRange getDomChildren(FragIndex node) const
+    {
+        return FragIndexRange(m_domChildren.data() + m_domChildrenStart[node],
+                              m_domChildren.data() + m_domChildrenStart[node + 1]);
     }
 
-    std::set<FragIndex> &getDF(FragIndex node) { return m_DF[node]; }
     FragIndex getIdom(FragIndex node) const { return m_idom[node]; }
     FragIndex getSemi(FragIndex node) const { return m_semi[node]; }
-    std::set<FragIndex> &getA_phi(SharedExp e) { return m_A_phi[e]; }
+
+    /// \returns the indices of all fragments that have a phi function for \p e
+    std::set<FragIndex> getA_phi(SharedExp e) const;
 
 private:
+    /// Number all fragments reachable from the entry fragment in depth first order.
     void recalcSpanningTree();
 
-    /// depth first search
-    /// \param myIdx index of the current fragment
-    /// \param parentIdx index of the parent of the current fragment
-    void dfs(FragIndex myIdx, FragIndex parentIdx);
-
     /// Basically algorithm 19.10b of Appel 2002 (uses path compression for O(log N) amortised time
     /// per operation (overall O(N log N))
     FragIndex getAncestorWithLowestSemi(FragIndex v);
 
     void link(FragIndex p, FragIndex n);
 
-    void computeDF(FragIndex n);
+    /// Build the dominator tree from the immediate dominators
+    /// and number its nodes in depth first order.
+    void buildDominatorTree(FragIndex entryIdx);
 
-    /// \return true if \p n dominates \p w.
-    bool doesDominate(FragIndex n, FragIndex w);
+    /// Compute the dominance frontiers of all fragments in the dominator tree,
+    /// bottom up (Appel 2002, Algorithm 19.2).
+    void computeDF();
 
-    bool canRenameLocalsParams() const { return renameLocalsAndParams; }
+    /// \return true if \p n strictly dominates \p w.
+    /// \note can only be called after \ref buildDominatorTree()
+    bool doesDominate(FragIndex n, FragIndex w) const;
 
-    void clearA_phi() { m_A_phi.clear(); }
+    bool canRenameLocalsParams() const { return renameLocalsAndParams; }
 
 private:
     void allocateData();
@@ -133,9 +170,9 @@ private:
 
     /* Dominance Frontier Data */
 
-    // These first two are not from Appel; they map fragments to indices and back
-    std::vector<IRFragment *> m_frags;                     ///< Maps index -> IRFragment
-    std::unordered_map<IRFragment *, FragIndex> m_indices; ///< Maps IRFragment -> index
+    // This is not from Appel; it maps indices to fragments.
+    // The index of each fragment is stored in the fragment itself.
+    std::vector<IRFragment *> m_frags; ///< Maps index -> IRFragment
 
     /// Calculating the dominance frontier
 
@@ -149,28 +186,55 @@ private:
     std::vector<FragIndex> m_semi; ///< Semi-dominator of n
     std::vector<FragIndex> m_idom; ///< Immediate dominator
 
-    std::vector<FragIndex> m_samedom;          ///< ? To do with deferring
-    std::vector<FragIndex> m_vertex;           ///< ?
-    std::vector<FragIndex> m_parent;           ///< Parent in the dominator tree?
-    std::vector<FragIndex> m_best;             ///< Improves ancestorWithLowestSemi
-    std::vector<std::set<FragIndex>> m_bucket; ///< Deferred calculation?
-    std::vector<std::set<FragIndex>> m_DF;     ///< Dominance frontier for every node n
-    std::size_t N = 0;                         ///< Current node number in algorithm
+    std::vector<FragIndex> m_samedom; ///< ? To do with deferring
+    std::vector<FragIndex> m_vertex;  ///< ?
+    std::vector<FragIndex> m_parent;  ///< Parent in the dominator tree?
+    std::vector<FragIndex> m_best;    ///< Improves ancestorWithLowestSemi
+
+    /// Deferred calculation. Each bucket is a singly linked list of fragments,
+    /// starting at m_bucketHead[n] and continued by m_bucketNext.
+    std::vector<FragIndex> m_bucketHead;
+    std::vector<FragIndex> m_bucketNext;
+
+    std::vector<FragIndex> m_evalPath; ///< Scratch space for getAncestorWithLowestSemi
+
+    /// Children of every node in the dominator tree, in CSR format:
+    /// The children of n are m_domChildren[m_domChildrenStart[n] .. m_domChildrenStart[n+1])
+    std::vector<std::size_t> m_domChildrenStart;
+    std::vector<FragIndex> m_domChildren;
+
+    /// Order number of each fragment in a depth first search of the dominator tree,
+    /// and the largest order number in its subtree. Used for O(1) dominance checks.
+    std::vector<FragIndex> m_domPre;
+    std::vector<FragIndex> m_domLast;
+    std::vector<FragIndex> m_domPostOrder; ///< Nodes of the dominator tree in post order
+
+    /// Dominance frontier for every node n, in CSR format (see \ref getDF)
+    std::vector<std::size_t> m_DFStart;
+    std::vector<FragIndex> m_DF;
+
+    std::size_t N = 0; ///< Current node number in algorithm
 
     /*
      * Inserting phi-functions
+     *
+     * All locations that can be renamed are numbered densely (see \ref m_locations),
+     * so that sets of locations and sets of fragments can be represented as bit sets.
      */
-    /// Array of sets of locations defined in fragment n
-    std::vector<ExSet> m_definedAt; // was: m_A_orig
+    /// Numbers all locations that were defined in the procedure.
+    LocationNumbering m_locations;
+
+    /// For fragment n, the set of (indices of) locations defined in n
+    std::vector<BitSet> m_definedAt; // was: m_A_orig
 
-    /// For a given expression e, stores the fragments needing a phi for e
-    std::map<SharedExp, std::set<FragIndex>, lessExpStar> m_A_phi;
+    /// For a given location index, stores the fragments needing a phi for the location
+    std::vector<BitSet> m_A_phi;
 
-    /// For a given expression e, stores the fragments where e is defined
-    std::map<SharedExp, std::set<FragIndex>, lessExpStar> m_defsites;
+    /// For a given location index, stores the fragments where the location is defined
+    std::vector<BitSet> m_defsites;
 
-    /// Set of block numbers defining all variables
-    std::set<FragIndex> m_defallsites;
+    /// Set of fragments defining all variables
+    BitSet m_defallsites;
 
     /// A Boomerang requirement: Statements defining particular subscripted locations
     std::map<SharedExp, SharedStmt, lessExpStar> m_defStmts;
@@ -0,0 +1,108 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "DefUseChains.h"
+
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/statements/Statement.h"
+#include "boomerang/visitor/expvisitor/ExpDestCounter.h"
+#include "boomerang/visitor/stmtexpvisitor/StmtDestCounter.h"
+
+
+DefUseChains::DefUseChains(const std::vector<SharedStmt> &stmts)
+    : m_stmts(stmts)
+    , m_usesOf(stmts.size())
+    , m_users(stmts.size())
+{
+    m_stmtIndex.reserve(m_stmts.size());
+
+    for (std::size_t i = 0; i < m_stmts.size(); ++i) {
+        m_stmtIndex[m_stmts[i].get()] = i;
+    }
+
+    for (std::size_t i = 0; i < m_stmts.size(); ++i) {
+        addUses(i);
+    }
+}
+
+
+DefUseChains::~DefUseChains()
+{
+}
+
+
+void DefUseChains::getUsedDefs(std::size_t idx, std::set<std::size_t> &defs) const
+{
+    for (const auto &use : m_usesOf[idx]) {
+        const std::size_t defIdx = findDefIndex(use.first);
+        if (defIdx != m_stmts.size()) {
+            defs.insert(defIdx);
+        }
+    }
+}
+
+
+void DefUseChains::updateUses(std::size_t idx)
+{
+    removeUses(idx);
+    addUses(idx);
+}
+
+
+void DefUseChains::addUses(std::size_t idx)
+{
+    ExpCountMap &uses = m_usesOf[idx];
+    assert(uses.empty());
+
+    ExpDestCounter edc(uses);
+    StmtDestCounter sdc(&edc);
+    m_stmts[idx]->accept(&sdc);
+
+    for (const auto &[ref, count] : uses) {
+        m_destCounts[ref] += count;
+
+        const std::size_t defIdx = findDefIndex(ref);
+        if (defIdx != m_stmts.size()) {
+            m_users[defIdx].insert(idx);
+        }
+    }
+}
+
+
+void DefUseChains::removeUses(std::size_t idx)
+{
+    ExpCountMap &uses = m_usesOf[idx];
+
+    for (const auto &[ref, count] : uses) {
+        auto it = m_destCounts.find(ref);
+        assert(it != m_destCounts.end() && it->second >= count);
+
+        it->second -= count;
+        if (it->second == 0) {
+            m_destCounts.erase(it);
+        }
+
+        const std::size_t defIdx = findDefIndex(ref);
+        if (defIdx != m_stmts.size()) {
+            m_users[defIdx].erase(idx);
+        }
+    }
+
+    uses.clear();
+}
+
+
+std::size_t DefUseChains::findDefIndex(const SharedExp &ref) const
+{
+    assert(ref->isSubscript());
+
+    const SharedStmt &def = ref->access<RefExp>()->getDef();
+    auto it               = m_stmtIndex.find(def.get());
+    return it != m_stmtIndex.end() ? it->second : m_stmts.size();
+}
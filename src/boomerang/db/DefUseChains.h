@@ -0,0 +1,83 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/ssl/statements/Statement.h"
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <vector>
+
+
+
+/**
+ * SSA def-use chains of a fixed set of statements, restricted to the uses that can be
+ * propagated (see Statement::canPropagateToExp).
+ *
+ * Statements are identified by their index in the statement vector passed to the constructor.
+ * When a statement is rewritten, call \ref updateUses to keep the chains and the
+ * use counts up to date; only the uses of this statement are recomputed.
+ */
+class BOOMERANG_API DefUseChains
+{
+public:
+    typedef std::map<SharedExp, int, lessExpStar> ExpCountMap;
+
+public:
+    explicit DefUseChains(const std::vector<SharedStmt> &stmts);
+    DefUseChains(const DefUseChains &other) = delete;
+    DefUseChains(DefUseChains &&other)      = default;
+
+    ~DefUseChains();
+
+    DefUseChains &operator=(const DefUseChains &other) = delete;
+    DefUseChains &operator=(DefUseChains &&other) = default;
+
+public:
+    std::size_t size() const { return m_stmts.size(); }
+
+    const SharedStmt &getStatement(std::size_t idx) const { return m_stmts[idx]; }
+
+    /// \returns the indices of all statements using the definition at index \p defIdx,
+    /// in ascending order.
+    const std::set<std::size_t> &getUsers(std::size_t defIdx) const { return m_users[defIdx]; }
+
+    /// \returns the number of times each propagatable use occurs in all statements.
+    /// This is the same as running ExpDestCounter over all statements.
+    const ExpCountMap &getDestCounts() const { return m_destCounts; }
+
+    /// Adds the indices of all definitions in the chains that are used by the statement
+    /// at index \p idx to \p defs.
+    void getUsedDefs(std::size_t idx, std::set<std::size_t> &defs) const;
+
+    /// Recompute the uses of the statement at index \p idx after it has been changed.
+    void updateUses(std::size_t idx);
+
+private:
+    /// Add the uses of the statement at index \p idx to the chains and use counts.
+    void addUses(std::size_t idx);
+
+    /// Remove the uses previously added by \ref addUses.
+    void removeUses(std::size_t idx);
+
+    /// \returns the index of the definition of \p ref, or size() if it is not in the chains.
+    std::size_t findDefIndex(const SharedExp &ref) const;
+
+private:
+    std::vector<SharedStmt> m_stmts;
+    std::unordered_map<const Statement *, std::size_t> m_stmtIndex;
+
+    std::vector<ExpCountMap> m_usesOf;          ///< Propagatable uses of each statement
+    std::vector<std::set<std::size_t>> m_users; ///< Users of each definition
+    ExpCountMap m_destCounts;                   ///< Sum of all m_usesOf
+};
@@ -219,20 +219,49 @@ SharedExp Global::readInitialValue(Address uaddr, SharedType type) const
 }
 
 
+void Global::setType(SharedType ty)
+{
+    m_type = ty;
+
+    if (m_prog) {
+        m_prog->updateGlobalExtent(this);
+    }
+}
+
+
 void Global::meetType(SharedType ty)
 {
     bool ch = false;
 
     m_type = m_type->meetWith(ty, ch);
+
+    if (m_prog) {
+        m_prog->updateGlobalExtent(this);
+    }
 }
 
 
 bool GlobalComparator::operator()(const std::shared_ptr<const Global> &g1,
                                   const std::shared_ptr<const Global> &g2) const
 {
-    Address addr1 = g1->getAddress();
-    Address addr2 = g2->getAddress();
+    return lessAddr(g1->getAddress(), g2->getAddress());
+}
+
 
+bool GlobalComparator::operator()(const std::shared_ptr<const Global> &g, Address addr) const
+{
+    return lessAddr(g->getAddress(), addr);
+}
+
+
+bool GlobalComparator::operator()(Address addr, const std::shared_ptr<const Global> &g) const
+{
+    return lessAddr(addr, g->getAddress());
+}
+
+
+bool GlobalComparator::lessAddr(Address addr1, Address addr2)
+{
     if (addr1 == addr2) {
         return false;
     }
@@ -35,7 +35,7 @@ public:
 
 public:
     SharedType getType() const { return m_type; }
-    void setType(SharedType ty) { m_type = ty; }
+    void setType(SharedType ty);
     void meetType(SharedType ty);
 
     Address getAddress() const { return m_addr; }
@@ -58,9 +58,19 @@ private:
 };
 
 
+/// Orders globals by address. Globals can also be compared directly with addresses.
 class GlobalComparator
 {
+public:
+    typedef void is_transparent;
+
 public:
     bool operator()(const std::shared_ptr<const Global> &g1,
                     const std::shared_ptr<const Global> &g2) const;
+
+    bool operator()(const std::shared_ptr<const Global> &g, Address addr) const;
+    bool operator()(Address addr, const std::shared_ptr<const Global> &g) const;
+
+private:
+    static bool lessAddr(Address addr1, Address addr2);
 };
@@ -65,6 +65,11 @@ public:
     bool operator<(const IRFragment &rhs) const;
 
 public:
+    /// \returns the index of this fragment in the dataflow analysis of its procedure.
+    /// \sa DataFlow::fragToIdx
+    std::size_t getIndex() const { return m_index; }
+    void setIndex(std::size_t index) { m_index = index; }
+
     BasicBlock *getBB() { return m_bb; }
     const BasicBlock *getBB() const { return m_bb; }
 
@@ -177,6 +182,7 @@ public:
 
 public:
     FragID m_id         = (FragID)-1;
+    std::size_t m_index = (std::size_t)-1; ///< Index for dataflow analysis
     FragType m_fragType = FragType::Invalid;
     BasicBlock *m_bb;
     std::unique_ptr<RTLList> m_listOfRTLs = nullptr; ///< Ptr to list of RTLs
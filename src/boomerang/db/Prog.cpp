@@ -48,6 +48,7 @@
 #include <QSaveFile>
 
 #include <cctype>
+#include <vector>
 
 
 Prog::Prog(const QString &name, Project *project)
@@ -72,6 +73,8 @@ void Prog::setFrontEnd(IFrontEnd *frontEnd)
     m_fe = frontEnd;
 
     m_moduleList.clear();
+    m_functionsByAddr.clear();
+    m_functionsByName.clear();
     m_rootModule = getOrInsertModule(m_name);
 }
 
@@ -231,31 +234,22 @@ LibProc *Prog::getOrCreateLibraryProc(const QString &name)
 
 Function *Prog::getFunctionByAddr(Address entryAddr) const
 {
-    for (const auto &m : m_moduleList) {
-        Function *proc = m->getFunction(entryAddr);
-
-        if (proc != nullptr) {
-            assert(proc != reinterpret_cast<Function *>(-1));
-            return proc;
-        }
-    }
+    auto it = m_functionsByAddr.lower_bound(entryAddr);
 
-    return nullptr;
+    return (it != m_functionsByAddr.end() && it->first == entryAddr) ? it->second : nullptr;
 }
 
 
 Function *Prog::getFunctionByName(const QString &name) const
 {
-    for (const auto &module : m_moduleList) {
-        Function *f = module->getFunction(name);
-
-        if (f) {
-            assert(f != reinterpret_cast<Function *>(-1));
-            return f;
-        }
+    // If there are multiple functions with the same name, return the one indexed first.
+    Function *func = nullptr;
+    for (auto it = m_functionsByName.find(name); it != m_functionsByName.end() && it.key() == name;
+         ++it) {
+        func = it.value();
     }
 
-    return nullptr;
+    return func;
 }
 
 
@@ -274,6 +268,47 @@ bool Prog::removeFunction(const QString &name)
 }
 
 
+void Prog::indexFunction(Function *func)
+{
+    if (func->getEntryAddress() != Address::INVALID) {
+        m_functionsByAddr.insert({ func->getEntryAddress(), func });
+    }
+
+    m_functionsByName.insert(func->getName(), func);
+}
+
+
+void Prog::unindexFunction(Function *func)
+{
+    removeFromFunctionIndex(func, func->getName(), func->getEntryAddress());
+}
+
+
+void Prog::reindexFunction(Function *func, const QString &oldName, Address oldEntryAddr)
+{
+    if (removeFromFunctionIndex(func, oldName, oldEntryAddr)) {
+        indexFunction(func);
+    }
+}
+
+
+bool Prog::removeFromFunctionIndex(Function *func, const QString &name, Address entryAddr)
+{
+    bool wasIndexed = m_functionsByName.remove(name, func) > 0;
+
+    auto range = m_functionsByAddr.equal_range(entryAddr);
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == func) {
+            m_functionsByAddr.erase(it);
+            wasIndexed = true;
+            break;
+        }
+    }
+
+    return wasIndexed;
+}
+
+
 int Prog::getNumFunctions(bool userOnly) const
 {
     int n = 0;
@@ -677,20 +712,120 @@ Global *Prog::createGlobal(Address addr, SharedType ty, QString name)
         ty = guessGlobalType(name, addr);
     }
 
-    auto pair = m_globals.insert(std::make_shared<Global>(ty, addr, name, this));
-    return (pair.second) ? pair.first->get() : nullptr;
+    return insertGlobal(std::make_shared<Global>(ty, addr, name, this));
 }
 
 
-QString Prog::getGlobalNameByAddr(Address uaddr) const
+void Prog::setGlobals(const GlobalSet &globals)
+{
+    m_globals = globals;
+    m_globalsByName.clear();
+    m_globalExtents.clear();
+
+    Address visibleFrom = Address::ZERO;
+
+    for (const std::shared_ptr<Global> &global : m_globals) {
+        m_globalsByName.insert(global->getName(), global.get());
+
+        const Address end = getGlobalEnd(global.get());
+        if (end > visibleFrom) {
+            m_globalExtents.emplace_hint(m_globalExtents.end(),
+                                         std::max(global->getAddress(), visibleFrom),
+                                         global.get());
+            visibleFrom = end;
+        }
+    }
+}
+
+
+void Prog::updateGlobalExtent(const Global *global)
 {
-    // FIXME: inefficient
-    for (auto &glob : m_globals) {
-        if (glob->containsAddress(uaddr)) {
-            return glob->getName();
+    // Start at a global that is visible from its own address.
+    // The extents of all globals before it are not affected.
+    Address from = global->getAddress();
+
+    for (auto it = m_globalExtents.upper_bound(from); it != m_globalExtents.begin();) {
+        --it;
+
+        if (it->first == it->second->getAddress()) {
+            from = it->first;
+            break;
         }
     }
 
+    std::vector<std::pair<Address, Global *>> extents;
+    Address visibleFrom = from;
+    auto extentsEnd     = m_globalExtents.end();
+
+    for (auto it = m_globals.lower_bound(from); it != m_globals.end(); ++it) {
+        Global *glob        = it->get();
+        const Address start = glob->getAddress();
+
+        if (start > global->getAddress() && start >= visibleFrom) {
+            // If this global was visible from its own address before,
+            // the extents of all globals after it are still the same.
+            auto extentIt = m_globalExtents.find(start);
+            if (extentIt != m_globalExtents.end() && extentIt->second == glob) {
+                extentsEnd = extentIt;
+                break;
+            }
+        }
+
+        const Address end = getGlobalEnd(glob);
+        if (end > visibleFrom) {
+            extents.emplace_back(std::max(start, visibleFrom), glob);
+            visibleFrom = end;
+        }
+    }
+
+    m_globalExtents.erase(m_globalExtents.lower_bound(from), extentsEnd);
+    m_globalExtents.insert(extents.begin(), extents.end());
+}
+
+
+Global *Prog::insertGlobal(const std::shared_ptr<Global> &global)
+{
+    if (!m_globals.insert(global).second) {
+        return nullptr;
+    }
+
+    m_globalsByName.insert(global->getName(), global.get());
+    updateGlobalExtent(global.get());
+    return global.get();
+}
+
+
+Global *Prog::findGlobalContaining(Address addr) const
+{
+    if (addr == Address::INVALID) {
+        return nullptr;
+    }
+
+    auto it = m_globalExtents.upper_bound(addr);
+    if (it == m_globalExtents.begin()) {
+        return nullptr;
+    }
+
+    --it;
+    return addr < getGlobalEnd(it->second) ? it->second : nullptr;
+}
+
+
+Address Prog::getGlobalEnd(const Global *global)
+{
+    // Globals without a size still contain their own address (cf. Global::containsAddress)
+    const Type::Size size = global->getType() ? global->getType()->getSizeInBytes() : 0;
+    return global->getAddress() + std::max<Type::Size>(size, 1);
+}
+
+
+QString Prog::getGlobalNameByAddr(Address uaddr) const
+{
+    const Global *glob = findGlobalContaining(uaddr);
+    if (glob) {
+        return glob->getName();
+    }
+
     return getSymbolNameByAddr(uaddr);
 }
 
@@ -709,24 +844,28 @@ Address Prog::getGlobalAddrByName(const QString &name) const
 
 Global *Prog::getGlobalByName(const QString &name) const
 {
-    auto iter = std::find_if(
-        m_globals.begin(), m_globals.end(),
-        [&name](const std::shared_ptr<Global> &g) -> bool { return g->getName() == name; });
+    // If there are multiple globals with the same name, return the one with the lowest address.
+    Global *glob = nullptr;
+    for (auto it = m_globalsByName.find(name); it != m_globalsByName.end() && it.key() == name;
+         ++it) {
+        if (!glob || it.value()->getAddress() < glob->getAddress()) {
+            glob = it.value();
+        }
+    }
 
-    return iter != m_globals.end() ? iter->get() : nullptr;
+    return glob;
 }
 
 
 bool Prog::markGlobalUsed(Address uaddr, SharedType knownType)
 {
-    for (auto &glob : m_globals) {
-        if (glob->containsAddress(uaddr)) {
-            if (knownType) {
-                glob->meetType(knownType);
-            }
-
-            return true;
+    Global *glob = findGlobalContaining(uaddr);
+    if (glob) {
+        if (knownType) {
+            glob->meetType(knownType);
         }
+
+        return true;
     }
 
     if (!m_binaryFile || m_binaryFile->getImage()->getSectionByAddr(uaddr) == nullptr) {
@@ -764,7 +903,7 @@ bool Prog::markGlobalUsed(Address uaddr, SharedType knownType)
         ty = guessGlobalType(name, uaddr);
     }
 
-    m_globals.insert(std::make_shared<Global>(ty, uaddr, name, this));
+    insertGlobal(std::make_shared<Global>(ty, uaddr, name, this));
 
     LOG_VERBOSE("globalUsed: name %1, address %2, %3 type %4", name, uaddr,
                 knownType ? "known" : "guessed", ty->getCtype());
@@ -849,23 +988,15 @@ QString Prog::newGlobalName(Address uaddr)
 
 SharedType Prog::getGlobalType(const QString &name) const
 {
-    for (auto &global : m_globals) {
-        if (global->getName() == name) {
-            return global->getType();
-        }
-    }
-
-    return nullptr;
+    const Global *global = getGlobalByName(name);
+    return global ? global->getType() : nullptr;
 }
 
 
 void Prog::setGlobalType(const QString &name, SharedType ty)
 {
-    // FIXME: inefficient
-    for (auto &gl : m_globals) {
-        if (gl->getName() == name) {
-            gl->setType(ty);
-            return;
-        }
+    Global *global = getGlobalByName(name);
+    if (global) {
+        global->setType(ty);
     }
 }
@@ -14,11 +14,13 @@
 #include "boomerang/db/Global.h"
 #include "boomerang/db/binary/BinaryFile.h"
 #include "boomerang/db/module/ModuleFactory.h"
+#include "boomerang/db/proc/ProofCache.h"
 #include "boomerang/frontend/SigEnum.h"
 #include "boomerang/ssl/Register.h"
 #include "boomerang/type/DataIntervalMap.h"
 #include "boomerang/util/Address.h"
 
+#include <QMultiHash>
 #include <QString>
 
 #include <list>
@@ -140,6 +142,18 @@ public:
     /// \returns true if function was found and removed.
     bool removeFunction(const QString &name);
 
+    /**
+     * Maintain the function index of this program, which is used by \ref getFunctionByAddr
+     * and \ref getFunctionByName. These are called by Module and Function whenever
+     * a function is added to or removed from a module of this program, or is renamed or moved.
+     */
+    void indexFunction(Function *func);
+    void unindexFunction(Function *func);
+
+    /// Update the index of \p func after its name or its entry address changed.
+    /// Does nothing if \p func was not indexed under \p oldName or \p oldEntryAddr.
+    void reindexFunction(Function *func, const QString &oldName, Address oldEntryAddr);
+
     /// \param userOnly If true, only count user functions, not library functions.
     /// \returns the number of functions in this program.
     int getNumFunctions(bool userOnly = true) const;
@@ -199,6 +213,10 @@ public:
 
     const std::list<UserProc *> &getEntryProcs() const { return m_entryProcs; }
 
+    /// \returns the results of all preservation proofs of all procedures
+    ProofCache &getProofCache() { return m_proofCache; }
+    const ProofCache &getProofCache() const { return m_proofCache; }
+
     // globals
 
     /**
@@ -210,9 +228,15 @@ public:
      */
     Global *createGlobal(Address addr, SharedType ty = nullptr, QString name = "");
 
-    GlobalSet &getGlobals() { return m_globals; }
     const GlobalSet &getGlobals() const { return m_globals; }
 
+    /// Replace all global variables of this program by \p globals.
+    void setGlobals(const GlobalSet &globals);
+
+    /// Update the extents of the globals after the type (and therefore the size)
+    /// of \p global changed. Called by Global.
+    void updateGlobalExtent(const Global *global);
+
     /// Get a global variable if possible, looking up the loader's symbol table if necessary
     QString getGlobalNameByAddr(Address addr) const;
 
@@ -248,20 +272,51 @@ public:
     /// Set the type of a global variable
     void setGlobalType(const QString &name, SharedType ty);
 
+private:
+    /// Remove \p func from the function index, where it is indexed as \p name and \p entryAddr.
+    /// \returns true if \p func was indexed.
+    bool removeFromFunctionIndex(Function *func, const QString &name, Address entryAddr);
+
+    /// \returns the global with the lowest address that contains \p addr, or nullptr if none.
+    Global *findGlobalContaining(Address addr) const;
+
+    /// \returns the address after the last byte of \p global.
+    static Address getGlobalEnd(const Global *global);
+
+    /// Insert \p global into the set of globals and the global index.
+    /// \returns the inserted global, or nullptr if a global at the same address already exists.
+    Global *insertGlobal(const std::shared_ptr<Global> &global);
+
 private:
     QString m_name; ///< name of the program
     Project *m_project       = nullptr;
     BinaryFile *m_binaryFile = nullptr;
     IFrontEnd *m_fe          = nullptr; ///< Pointer to the FrontEnd object for the project
     Module *m_rootModule     = nullptr; ///< Root of the module tree
-    ModuleList m_moduleList;            ///< The Modules that make up this program
+
+    /// Must outlive the modules, since procedures remove their results when destroyed.
+    ProofCache m_proofCache;
+
+    ModuleList m_moduleList; ///< The Modules that make up this program
+
+    /// Index of the functions of all modules. Functions without a valid
+    /// entry address (e.g. most library functions) are only indexed by name.
+    std::multimap<Address, Function *> m_functionsByAddr;
+    QMultiHash<QString, Function *> m_functionsByName;
 
     std::unique_ptr<LowLevelCFG> m_cfg;
 
     /// list of UserProcs for entry point(s)
     std::list<UserProc *> m_entryProcs;
 
-    // FIXME: is a set of Globals the most appropriate data structure? Surely not.
-    GlobalSet m_globals;         ///< globals to print at code generation time
+    GlobalSet m_globals;         ///< globals to print at code generation time, sorted by address
     DataIntervalMap m_globalMap; ///< Map from address to DataInterval (has size, name, type)
+
+    QMultiHash<QString, Global *> m_globalsByName; ///< Index of \ref m_globals by name
+
+    /// Visible extents of \ref m_globals, keyed by the first visible address.
+    /// Where globals overlap, the global with the lowest address is visible, so each global
+    /// is visible from its address or the end of the globals before it, whichever is later,
+    /// up to its own end. Globals hidden completely by other globals are not contained.
+    std::map<Address, Global *> m_globalExtents;
 };
@@ -20,6 +20,7 @@ class BinarySymbolTable;
 class IFileLoader;
 
 class QByteArray;
+class QFile;
 
 
 /// This enum allows a sort of run time type identification, without using
@@ -53,6 +54,10 @@ class BOOMERANG_API BinaryFile
 {
 public:
     BinaryFile(const QByteArray &rawData, IFileLoader *loader);
+
+    /// Create a binary file from the memory mapped contents of \p file.
+    /// \sa BinaryImage::BinaryImage(std::unique_ptr<QFile>)
+    BinaryFile(std::unique_ptr<QFile> file, IFileLoader *loader);
     BinaryFile(const BinaryFile &) = delete;
     BinaryFile(BinaryFile &&)      = delete;
 
@@ -14,7 +14,10 @@
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QFile>
+
 #include <algorithm>
+#include <cassert>
 
 
 BinaryImage::BinaryImage(const QByteArray &rawData)
@@ -23,6 +26,45 @@ BinaryImage::BinaryImage(const QByteArray &rawData)
 }
 
 
+BinaryImage::BinaryImage(std::unique_ptr<QFile> file)
+{
+    assert(file && file->isOpen());
+
+    if (file->size() > 0) {
+        m_mappedData = file->map(0, file->size(), QFileDevice::MapPrivateOption);
+    }
+
+    if (m_mappedData != nullptr) {
+        const char *data = reinterpret_cast<const char *>(m_mappedData);
+        m_rawData        = QByteArray::fromRawData(data, file->size());
+        m_mappedFile     = std::move(file);
+    }
+    else {
+        m_rawData = file->readAll();
+    }
+}
+
+
+Byte *BinaryImage::getRawBytes()
+{
+    return isMapped() ? m_mappedData : reinterpret_cast<Byte *>(m_rawData.data());
+}
+
+
+const Byte *BinaryImage::getRawBytes() const
+{
+    return reinterpret_cast<const Byte *>(m_rawData.constData());
+}
+
+
+bool BinaryImage::isMapped() const
+{
+    // The raw data is detached from the mapping on non-const access
+    return m_mappedData != nullptr &&
+           m_rawData.constData() == reinterpret_cast<const char *>(m_mappedData);
+}
+
+
 BinaryImage::~BinaryImage()
 {
     reset();
@@ -31,6 +73,8 @@ BinaryImage::~BinaryImage()
 
 void BinaryImage::reset()
 {
+    m_sectionIndex.clear();
+    m_lastHit = -1;
     m_sectionMap.clear();
     m_sections.clear();
 }
@@ -187,6 +231,75 @@ bool BinaryImage::readNativeFloat8(Address addr, double &value) const
 }
 
 
+const Byte *BinaryImage::getHostBytes(Address addr, size_t size,
+                                      const BinarySection **section) const
+{
+    const BinarySection *si = getSectionByAddr(addr);
+
+    if (si == nullptr || !si->isRangeDefined(addr, addr + size)) {
+        return nullptr;
+    }
+
+    if (section) {
+        *section = si;
+    }
+
+    HostAddress host = si->getHostAddr() - si->getSourceAddr() + addr;
+    return reinterpret_cast<const Byte *>(host.value());
+}
+
+
+/// Read \p count values of type \p T from \p image at once,
+/// converting each value with \p readValue.
+template<typename T, typename ReadFunc>
+static bool readArray(const BinaryImage *image, Address addr, T *values, size_t count,
+                      ReadFunc readValue)
+{
+    if (count == 0) {
+        return true;
+    }
+
+    const BinarySection *section = nullptr;
+    const Byte *src              = image->getHostBytes(addr, count * sizeof(T), &section);
+
+    if (src == nullptr) {
+        return false;
+    }
+
+    const Endian endian = section->getEndian();
+    for (size_t i = 0; i < count; ++i) {
+        values[i] = readValue(src + i * sizeof(T), endian);
+    }
+
+    return true;
+}
+
+
+bool BinaryImage::readNativeArray1(Address addr, Byte *values, size_t count) const
+{
+    return readArray(this, addr, values, count,
+                     [](const Byte *src, Endian) { return Util::readByte(src); });
+}
+
+
+bool BinaryImage::readNativeArray2(Address addr, SWord *values, size_t count) const
+{
+    return readArray(this, addr, values, count, Util::readWord);
+}
+
+
+bool BinaryImage::readNativeArray4(Address addr, DWord *values, size_t count) const
+{
+    return readArray(this, addr, values, count, Util::readDWord);
+}
+
+
+bool BinaryImage::readNativeArray8(Address addr, QWord *values, size_t count) const
+{
+    return readArray(this, addr, values, count, Util::readQWord);
+}
+
+
 bool BinaryImage::writeNative4(Address addr, uint32_t value)
 {
     BinarySection *si = getSectionByAddr(addr);
@@ -260,7 +373,8 @@ bool BinaryImage::isReadOnly(Address addr) const
         return true;
     }
 
-    return section->addressHasAttribute("ReadOnly", addr);
+    static const QString readOnlyAttr("ReadOnly");
+    return section->addressHasAttribute(readOnlyAttr, addr);
 }
 
 
@@ -330,6 +444,7 @@ BinarySection *BinaryImage::createSection(const QString &name, Address from, Add
     }
     else {
         m_sections.push_back(sect);
+        rebuildSectionIndex();
         return sect;
     }
 }
@@ -379,13 +494,57 @@ const BinarySection *BinaryImage::getSectionByName(const QString &sectionName) c
 
 BinarySection *BinaryImage::getSectionByAddr(Address addr)
 {
-    auto iter = m_sectionMap.find(addr);
-    return (iter != m_sectionMap.end()) ? iter->second.get() : nullptr;
+    const int idx = findSectionRange(addr);
+    return idx != -1 ? m_sectionIndex[idx].section : nullptr;
 }
 
 
 const BinarySection *BinaryImage::getSectionByAddr(Address addr) const
 {
-    auto iter = m_sectionMap.find(addr);
-    return (iter != m_sectionMap.end()) ? iter->second.get() : nullptr;
+    const int idx = findSectionRange(addr);
+    return idx != -1 ? m_sectionIndex[idx].section : nullptr;
+}
+
+
+int BinaryImage::findSectionRange(Address addr) const
+{
+    // Consecutive reads usually hit the same section (e.g. when scanning tables)
+    const int lastHit = m_lastHit.load(std::memory_order_relaxed);
+    if (lastHit != -1 && Util::inRange(addr, m_sectionIndex[lastHit].from,
+                                       m_sectionIndex[lastHit].to)) {
+        return lastHit;
+    }
+
+    auto it = std::upper_bound(
+        m_sectionIndex.begin(), m_sectionIndex.end(), addr,
+        [](Address a, const SectionRange &range) { return a < range.from; });
+
+    if (it == m_sectionIndex.begin() || addr >= std::prev(it)->to) {
+        return -1;
+    }
+
+    const int idx = static_cast<int>(std::distance(m_sectionIndex.begin(), std::prev(it)));
+    m_lastHit.store(idx, std::memory_order_relaxed);
+    return idx;
+}
+
+
+void BinaryImage::rebuildSectionIndex()
+{
+    m_sectionIndex.clear();
+    m_lastHit = -1;
+
+    // m_sectionMap is sorted by start address. Sections may overlap (e.g. .tbss);
+    // in this case, the overlapping part belongs to the section starting first.
+    Address coveredUpTo = Address::ZERO;
+
+    for (const auto &[extent, section] : m_sectionMap) {
+        const Address from = std::max(extent.lower(), coveredUpTo);
+        const Address to   = extent.upper();
+
+        if (from < to) {
+            m_sectionIndex.push_back({ from, to, section.get() });
+            coveredUpTo = to;
+        }
+    }
 }
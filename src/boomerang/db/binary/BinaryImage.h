@@ -15,12 +15,15 @@
 
 #include <QByteArray>
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
 
 class BinarySection;
 
+class QFile;
+
 
 /**
  * This class provides file-format independent access to sections and code/data
@@ -39,6 +42,14 @@ class BOOMERANG_API BinaryImage
 
 public:
     BinaryImage(const QByteArray &rawData);
+
+    /**
+     * Create an image from the contents of \p file, which must be open for reading.
+     * The file is mapped into memory privately, so only the pages that are actually accessed
+     * are read from disk, and modifying the raw data (e.g. when applying relocations) only
+     * copies the modified pages. If the file cannot be mapped, it is read into memory instead.
+     */
+    BinaryImage(std::unique_ptr<QFile> file);
     BinaryImage(const BinaryImage &other) = delete;
     BinaryImage(BinaryImage &&other)      = delete;
 
@@ -60,9 +71,22 @@ public:
     const_reverse_iterator rend() const { return m_sections.rend(); }
 
 public:
+    /// \note If the image is memory mapped, any non-const access to the returned
+    /// byte array (e.g. via QByteArray::data()) copies the whole file into memory.
+    /// Use \ref getRawBytes to access the raw data without copying.
     QByteArray &getRawData() { return m_rawData; }
     const QByteArray &getRawData() const { return m_rawData; }
 
+    /// \returns a writable pointer to the raw data of the image, without copying mapped data.
+    Byte *getRawBytes();
+    const Byte *getRawBytes() const;
+
+    /// \returns the size of the raw data in bytes
+    size_t getRawSize() const { return m_rawData.size(); }
+
+    /// \returns true if the raw data is backed by a memory mapped file
+    bool isMapped() const;
+
     /// \returns the number of sections in this image
     int getNumSections() const { return m_sections.size(); }
 
@@ -115,12 +139,52 @@ public:
     bool readNativeFloat4(Address addr, float &value) const;
     bool readNativeFloat8(Address addr, double &value) const;
 
+    /**
+     * Read \p count consecutive values starting at \p addr.
+     * In contrast to reading the values one by one, the section lookup and
+     * all range checks are only done once for the whole array.
+     * No warning is emitted on failure.
+     *
+     * \returns false if [addr, addr + count * sizeof(value)) is not completely contained
+     * in the initialized part of a single section. In this case, \p values is not modified.
+     */
+    bool readNativeArray1(Address addr, Byte *values, size_t count) const;
+    bool readNativeArray2(Address addr, SWord *values, size_t count) const;
+    bool readNativeArray4(Address addr, DWord *values, size_t count) const;
+    bool readNativeArray8(Address addr, QWord *values, size_t count) const;
+
+    /**
+     * \returns a pointer to the host memory of [addr, addr + size) if the range is completely
+     * contained in the initialized part of a single section, nullptr otherwise.
+     * \param section if not null, set to the section containing the range.
+     */
+    const Byte *getHostBytes(Address addr, size_t size,
+                             const BinarySection **section = nullptr) const;
+
     bool writeNative4(Address addr, DWord value);
 
     /// \returns true if \p addr is in a read-only section
     bool isReadOnly(Address addr) const;
 
 private:
+    /// A range of addresses mapped to a section. See \ref m_sectionIndex.
+    struct SectionRange
+    {
+        Address from;
+        Address to;
+        BinarySection *section;
+    };
+
+    /// Recompute \ref m_sectionIndex after sections have been added or removed.
+    void rebuildSectionIndex();
+
+    /// \returns the index of the entry in \ref m_sectionIndex containing \p addr, or -1
+    int findSectionRange(Address addr) const;
+
+private:
+    std::unique_ptr<QFile> m_mappedFile; ///< Keeps the mapping alive
+    Byte *m_mappedData = nullptr;
+
     QByteArray m_rawData;
     Address m_limitTextLow  = Address::INVALID;
     Address m_limitTextHigh = Address::INVALID;
@@ -128,4 +192,10 @@ private:
 
     SectionList m_sections; ///< The section info
     IntervalMap<Address, std::unique_ptr<BinarySection>> m_sectionMap;
+
+    /// Sorted, non-overlapping address ranges for fast lookup of the section containing
+    /// an address. Where sections overlap, the range is assigned to the section
+    /// with the lowest start address (like \ref IntervalMap::find).
+    std::vector<SectionRange> m_sectionIndex;
+    mutable std::atomic<int> m_lastHit{ -1 }; ///< Index of the last range found
 };
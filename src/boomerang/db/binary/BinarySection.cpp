@@ -14,18 +14,37 @@
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
+#include <vector>
+
 
 class BinarySectionImpl
 {
 public:
-    void addDefinedArea(Address from, Address to) { m_hasDefinedValue.insert(from, to); }
+    void addDefinedArea(Address from, Address to)
+    {
+        m_hasDefinedValue.insert(from, to);
+
+        // Keep a flat copy of the (merged) defined ranges for fast binary search.
+        m_definedRanges.assign(m_hasDefinedValue.begin(), m_hasDefinedValue.end());
+    }
+
+    bool isAddressBss(Address a) const { return !isRangeDefined(a, a + 1); }
 
-    bool isAddressBss(Address a) const
+    /// \returns true if all addresses in [from, to) have a defined value.
+    bool isRangeDefined(Address from, Address to) const
     {
-        if (m_hasDefinedValue.isEmpty()) {
-            return true;
+        // find the last defined range starting at or before \p from
+        auto it = std::upper_bound(
+            m_definedRanges.begin(), m_definedRanges.end(), from,
+            [](Address addr, const Interval<Address> &range) { return addr < range.lower(); });
+
+        if (it == m_definedRanges.begin()) {
+            return false;
         }
-        return !m_hasDefinedValue.isContained(a);
+
+        --it;
+        return it->contains(from) && to <= it->upper();
     }
 
     void setAttributeForRange(const QString &name, Address from, Address to)
@@ -46,6 +65,7 @@ public:
 
 public:
     IntervalSet<Address> m_hasDefinedValue;
+    std::vector<Interval<Address>> m_definedRanges; ///< Sorted, non-overlapping
     std::map<QString, IntervalSet<Address>> m_attributeMap;
 };
 
@@ -87,6 +107,22 @@ bool BinarySection::isAddressBss(Address a) const
 }
 
 
+bool BinarySection::isRangeDefined(Address from, Address to) const
+{
+    if (from >= to || from < m_nativeAddr || to > m_nativeAddr + m_size) {
+        return false;
+    }
+    else if (m_hostAddr == HostAddress::INVALID || m_bss) {
+        return false;
+    }
+    else if (m_readOnly) {
+        return true;
+    }
+
+    return m_impl->isRangeDefined(from, to);
+}
+
+
 bool BinarySection::anyDefinedValues() const
 {
     return !m_impl->m_hasDefinedValue.isEmpty();
@@ -57,6 +57,10 @@ public:
     /// the behaviour of (at least) the question "Is this address in BSS".
     bool isAddressBss(Address addr) const;
 
+    /// \returns true if all addresses in [from, to) are inside this section,
+    /// mapped to host memory and not in BSS.
+    bool isRangeDefined(Address from, Address to) const;
+
     bool anyDefinedValues() const;
     void addDefinedArea(Address from, Address to);
 
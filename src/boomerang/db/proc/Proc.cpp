@@ -44,7 +44,12 @@ QString Function::getName() const
 void Function::setName(const QString &name)
 {
     assert(m_signature);
+    const QString oldName = m_signature->getName();
     m_signature->setName(name);
+
+    if (m_module && m_module->getProg()) {
+        m_module->getProg()->reindexFunction(this, oldName, m_entryAddress);
+    }
 }
 
 
@@ -56,12 +61,18 @@ Address Function::getEntryAddress() const
 
 void Function::setEntryAddress(Address entryAddr)
 {
+    const Address oldEntryAddr = m_entryAddress;
+
     if (m_module) {
         m_module->setLocationMap(m_entryAddress, nullptr);
         m_module->setLocationMap(entryAddr, this);
     }
 
     m_entryAddress = entryAddr;
+
+    if (m_module && m_module->getProg()) {
+        m_module->getProg()->reindexFunction(this, getName(), oldEntryAddr);
+    }
 }
 
 
@@ -91,6 +102,10 @@ void Function::setModule(Module *module)
     if (module) {
         module->getFunctionList().push_back(this);
         module->setLocationMap(m_entryAddress, this);
+
+        if (module->getProg()) {
+            module->getProg()->indexFunction(this);
+        }
     }
 }
 
@@ -100,13 +115,23 @@ void Function::removeFromModule()
     assert(m_module);
     m_module->getFunctionList().remove(this);
     m_module->setLocationMap(m_entryAddress, nullptr);
+
+    if (m_module->getProg()) {
+        m_module->getProg()->unindexFunction(this);
+    }
 }
 
 
 void Function::setSignature(std::shared_ptr<Signature> sig)
 {
+    const QString oldName = m_signature ? m_signature->getName() : QString();
+
     m_signature = sig;
     assert(m_signature != nullptr);
+
+    if (m_module && m_module->getProg() && m_signature->getName() != oldName) {
+        m_module->getProg()->reindexFunction(this, oldName, m_entryAddress);
+    }
 }
 
 
@@ -0,0 +1,97 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProcStatementRange.h"
+
+#include "boomerang/db/IRFragment.h"
+
+
+/// Used for fragments without RTLs
+static const RTLList g_emptyRTLs;
+
+
+ProcStatementIterator::ProcStatementIterator(ProcCFG::const_iterator begin,
+                                             ProcCFG::const_iterator end)
+    : m_fragIt(begin)
+    , m_fragEnd(end)
+{
+    if (m_fragIt != m_fragEnd) {
+        enterFragment();
+        skipToStatement();
+    }
+}
+
+
+bool ProcStatementIterator::operator==(const ProcStatementIterator &other) const
+{
+    if (m_fragIt != other.m_fragIt) {
+        return false;
+    }
+    else if (m_fragIt == m_fragEnd) {
+        return true; // both at the end
+    }
+
+    return m_rtlIt == other.m_rtlIt && m_stmtIt == other.m_stmtIt;
+}
+
+
+ProcStatementIterator &ProcStatementIterator::operator++()
+{
+    assert(m_fragIt != m_fragEnd);
+
+    ++m_stmtIt;
+    skipToStatement();
+    return *this;
+}
+
+
+ProcStatementIterator ProcStatementIterator::operator++(int)
+{
+    ProcStatementIterator old = *this;
+    ++(*this);
+    return old;
+}
+
+
+void ProcStatementIterator::enterFragment()
+{
+    const RTLList *rtls = (*m_fragIt)->getRTLs();
+    if (!rtls) {
+        rtls = &g_emptyRTLs;
+    }
+
+    m_rtlIt  = rtls->begin();
+    m_rtlEnd = rtls->end();
+
+    if (m_rtlIt != m_rtlEnd) {
+        m_stmtIt = (*m_rtlIt)->begin();
+    }
+}
+
+
+void ProcStatementIterator::skipToStatement()
+{
+    while (m_fragIt != m_fragEnd) {
+        while (m_rtlIt != m_rtlEnd) {
+            if (m_stmtIt != (*m_rtlIt)->end()) {
+                return; // found a statement
+            }
+
+            ++m_rtlIt;
+            if (m_rtlIt != m_rtlEnd) {
+                m_stmtIt = (*m_rtlIt)->begin();
+            }
+        }
+
+        ++m_fragIt;
+        if (m_fragIt != m_fragEnd) {
+            enterFragment();
+        }
+    }
+}
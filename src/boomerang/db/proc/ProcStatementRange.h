@@ -0,0 +1,87 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/ssl/RTL.h"
+
+#include <iterator>
+
+
+/**
+ * Iterates over all statements of a procedure in fragment order, without copying them.
+ * \sa ProcStatementRange
+ */
+class BOOMERANG_API ProcStatementIterator
+{
+public:
+    typedef std::forward_iterator_tag iterator_category;
+    typedef std::ptrdiff_t difference_type;
+    typedef SharedStmt value_type;
+    typedef const SharedStmt &reference;
+    typedef const SharedStmt *pointer;
+
+public:
+    /// Create an iterator pointing to the first statement in the fragments [\p begin, \p end)
+    ProcStatementIterator(ProcCFG::const_iterator begin, ProcCFG::const_iterator end);
+
+    bool operator==(const ProcStatementIterator &other) const;
+    bool operator!=(const ProcStatementIterator &other) const { return !(*this == other); }
+
+    reference operator*() const { return *m_stmtIt; }
+    pointer operator->() const { return &*m_stmtIt; }
+
+    ProcStatementIterator &operator++();
+    ProcStatementIterator operator++(int);
+
+private:
+    /// Set the RTL iterators to the RTLs of the current fragment
+    void enterFragment();
+
+    /// Skip empty RTLs and fragments until a statement is found or the end is reached.
+    void skipToStatement();
+
+private:
+    ProcCFG::const_iterator m_fragIt;
+    ProcCFG::const_iterator m_fragEnd;
+    RTLList::const_iterator m_rtlIt;
+    RTLList::const_iterator m_rtlEnd;
+    RTL::const_iterator m_stmtIt;
+};
+
+
+/**
+ * A view of all statements of a procedure, in fragment order.
+ * Iterating over the statements does not copy them or change their reference counts.
+ * Statements may be modified while iterating, but no fragments, RTLs or statements
+ * may be added or removed.
+ */
+class BOOMERANG_API ProcStatementRange
+{
+public:
+    explicit ProcStatementRange(const ProcCFG *cfg)
+        : m_cfg(cfg)
+    {
+    }
+
+public:
+    ProcStatementIterator begin() const
+    {
+        return ProcStatementIterator(m_cfg->begin(), m_cfg->end());
+    }
+
+    ProcStatementIterator end() const { return ProcStatementIterator(m_cfg->end(), m_cfg->end()); }
+
+    bool empty() const { return begin() == end(); }
+
+private:
+    const ProcCFG *m_cfg;
+};
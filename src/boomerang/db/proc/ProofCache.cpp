@@ -0,0 +1,83 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProofCache.h"
+
+#include "boomerang/ssl/exp/Binary.h"
+
+
+ProofCache::ProofCache()
+{
+}
+
+
+ProofCache::~ProofCache()
+{
+}
+
+
+bool ProofCache::lookup(const UserProc *proc, const SharedExp &lhs, const SharedExp &rhs,
+                        bool &result)
+{
+    const SharedExp query = Binary::get(opEquals, lhs, rhs);
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto procIt = m_results.find(proc);
+
+    if (procIt != m_results.end()) {
+        auto it = procIt->second.find(query);
+
+        if (it != procIt->second.end()) {
+            result = it->second;
+            m_numHits++;
+            return true;
+        }
+    }
+
+    m_numMisses++;
+    return false;
+}
+
+
+void ProofCache::insert(const UserProc *proc, const SharedExp &lhs, const SharedExp &rhs,
+                        bool result)
+{
+    SharedExp query = Binary::get(opEquals, lhs->clone(), rhs->clone());
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_results[proc][query] = result;
+}
+
+
+void ProofCache::invalidate(const UserProc *proc)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_results.erase(proc);
+}
+
+
+void ProofCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_results.clear();
+}
+
+
+uint64 ProofCache::getNumHits() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numHits;
+}
+
+
+uint64 ProofCache::getNumMisses() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_numMisses;
+}
@@ -0,0 +1,71 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/util/Types.h"
+
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+
+class UserProc;
+
+
+/**
+ * Remembers the results of proving lhs = rhs in a procedure (see UserProc::proveEqual),
+ * so the same query is not proven again as long as nothing it depends on has changed.
+ *
+ * The results of a procedure must be invalidated whenever its statements change,
+ * and all results must be invalidated whenever something is proven or unproven
+ * in any procedure, since proofs use the proven equations of callees.
+ * All member functions are thread safe.
+ */
+class BOOMERANG_API ProofCache
+{
+public:
+    ProofCache();
+    ProofCache(const ProofCache &other) = delete;
+    ProofCache(ProofCache &&other)      = delete;
+
+    ~ProofCache();
+
+    ProofCache &operator=(const ProofCache &other) = delete;
+    ProofCache &operator=(ProofCache &&other) = delete;
+
+public:
+    /// Look up the result of proving \p lhs = \p rhs in \p proc.
+    /// \returns true if the result is known, in which case it is stored in \p result.
+    bool lookup(const UserProc *proc, const SharedExp &lhs, const SharedExp &rhs, bool &result);
+
+    /// Remember the result of proving \p lhs = \p rhs in \p proc.
+    void insert(const UserProc *proc, const SharedExp &lhs, const SharedExp &rhs, bool result);
+
+    /// Forget all results of \p proc.
+    void invalidate(const UserProc *proc);
+
+    /// Forget all results of all procedures.
+    void clear();
+
+    uint64 getNumHits() const;
+    uint64 getNumMisses() const;
+
+private:
+    /// Map from query (lhs = rhs) to the result of the proof
+    typedef std::map<SharedExp, bool, lessExpStar> ResultMap;
+
+    mutable std::mutex m_mutex;
+    std::unordered_map<const UserProc *, ResultMap> m_results;
+
+    uint64 m_numHits   = 0;
+    uint64 m_numMisses = 0;
+};
@@ -55,6 +55,9 @@ UserProc::UserProc(Address address, const QString &name, Module *module)
 
 UserProc::~UserProc()
 {
+    if (m_prog) {
+        m_prog->getProofCache().invalidate(this);
+    }
 }
 
 
@@ -160,6 +163,26 @@ void UserProc::getStatements(StatementList &stmts) const
 }
 
 
+void UserProc::getStatementSnapshot(std::vector<SharedStmt> &stmts) const
+{
+    stmts.clear();
+
+    for (const SharedStmt &s : getStatementRange()) {
+        stmts.push_back(s);
+    }
+}
+
+
+void UserProc::adoptStatements()
+{
+    for (const SharedStmt &s : getStatementRange()) {
+        if (s->getProc() == nullptr) {
+            s->setProc(this);
+        }
+    }
+}
+
+
 bool UserProc::removeStatement(const SharedStmt &stmt)
 {
     if (!stmt) {
@@ -167,6 +190,8 @@ bool UserProc::removeStatement(const SharedStmt &stmt)
     }
 
     // remove anything proven about this statement
+    bool provenChanged = false;
+
     for (auto provenIt = m_provenTrue.begin(); provenIt != m_provenTrue.end();) {
         LocationSet refs;
         provenIt->second->addUsedLocs(refs);
@@ -181,13 +206,24 @@ bool UserProc::removeStatement(const SharedStmt &stmt)
             LOG_VERBOSE("Removing proven true exp %1 = %2 that uses statement being removed.",
                         provenIt->first, provenIt->second);
 
-            provenIt = m_provenTrue.erase(provenIt);
+            provenIt      = m_provenTrue.erase(provenIt);
+            provenChanged = true;
             continue;
         }
 
         ++provenIt;
     }
 
+    if (m_prog) {
+        // Proofs of callers may have used the removed equations
+        if (provenChanged) {
+            m_prog->getProofCache().clear();
+        }
+        else {
+            m_prog->getProofCache().invalidate(this);
+        }
+    }
+
     // remove from fragment/RTL
     IRFragment *frag = stmt->getFragment(); // Get our enclosing fragment
     if (!frag) {
@@ -301,11 +337,8 @@ std::shared_ptr<Assign> UserProc::replacePhiByAssign(const std::shared_ptr<const
                     }
                     rtl->insert(ss, asgn);
 
-                    StatementList stmts;
-                    getStatements(stmts);
-
                     // replace all refs orig -> asgn
-                    for (const SharedStmt &stmt : stmts) {
+                    for (const SharedStmt &stmt : getStatementRange()) {
                         StmtSubscriptReplacer stmtMod(orig, asgn);
 
                         stmt->accept(&stmtMod);
@@ -910,10 +943,8 @@ QString UserProc::findFirstSymbol(const SharedConstExp &exp) const
 bool UserProc::searchAndReplace(const Exp &search, SharedExp replace)
 {
     bool ch = false;
-    StatementList stmts;
-    getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : getStatementRange()) {
         ch |= s->searchAndReplace(search, replace);
     }
 
@@ -929,10 +960,7 @@ void UserProc::markAsInitialParam(const SharedExp &loc)
 
 bool UserProc::allPhisHaveDefs() const
 {
-    StatementList stmts;
-    getStatements(stmts);
-
-    for (SharedStmt stmt : stmts) {
+    for (const SharedStmt &stmt : getStatementRange()) {
         if (!stmt->isPhi()) {
             continue; // Might be able to optimise this a bit
         }
@@ -1184,6 +1212,21 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
         return true;
     }
 
+    // Only failed proofs are cached; successful ones are in m_provenTrue.
+    // Results depending on premises of the recursion group or conditional results are not cached.
+    ProofCache &proofCache = m_prog->getProofCache();
+    const bool useCache    = !conditional && !m_recursionGroup;
+    bool cachedResult      = false;
+
+    if (useCache && proofCache.lookup(this, queryLeft, queryRight, cachedResult)) {
+        if (m_prog->getProject()->getSettings()->debugProof) {
+            LOG_MSG("found %1 in proof cache for %2 in %3", (cachedResult ? "true" : "false"),
+                    Binary::get(opEquals, queryLeft, queryRight), getName());
+        }
+
+        return cachedResult;
+    }
+
     const SharedExp origLeft  = queryLeft;
     const SharedExp origRight = queryRight;
 
@@ -1225,6 +1268,7 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
                 }
 
                 m_provenTrue[origLeft->clone()] = right;
+                proofCache.clear();
                 return true;
             }
 
@@ -1233,6 +1277,10 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
                 LOG_MSG("Prove returns false");
             }
 
+            if (useCache) {
+                proofCache.insert(this, origLeft, origRight, false);
+            }
+
             return false;
         }
     }
@@ -1257,6 +1305,12 @@ bool UserProc::proveEqual(const SharedExp &queryLeft, const SharedExp &queryRigh
 
     if (result && !conditional) {
         m_provenTrue[origLeft] = origRight; // Save the now proven equation
+
+        // Proofs in callers and failed proofs in this proc may now succeed
+        proofCache.clear();
+    }
+    else if (!result && useCache) {
+        proofCache.insert(this, origLeft, origRight, false);
     }
 
     return result;
@@ -1540,10 +1594,7 @@ bool UserProc::prover(SharedExp query, std::set<std::shared_ptr<PhiAssign>> &las
             // find a memory def for the right if there is a memof on the left
             // FIXME: this seems pretty much like a bad hack!
             if (!change && query->getSubExp1()->isMemOf()) {
-                StatementList stmts;
-                getStatements(stmts);
-
-                for (SharedStmt s : stmts) {
+                for (const SharedStmt &s : getStatementRange()) {
                     std::shared_ptr<Assign> as = std::dynamic_pointer_cast<Assign>(s);
 
                     if (as && (*as->getRight() == *query->getSubExp2()) &&
@@ -14,6 +14,7 @@
 #include "boomerang/db/UseCollector.h"
 #include "boomerang/db/proc/Proc.h"
 #include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/ProcStatementRange.h"
 #include "boomerang/util/StatementList.h"
 
 
@@ -151,6 +152,20 @@ public:
     /// \returns all statements in this UserProc
     void getStatements(StatementList &stmts) const;
 
+    /// \returns a view of all statements in this UserProc that does not copy the statements.
+    /// No fragments or statements must be added or removed while iterating the view.
+    ProcStatementRange getStatementRange() const { return ProcStatementRange(m_cfg.get()); }
+
+    /// Replaces the contents of \p stmts by all statements in this UserProc.
+    /// Use this instead of \ref getStatementRange only if statements are added or removed
+    /// while iterating. The snapshot holds shared pointers rather than raw pointers,
+    /// so removed statements stay alive until the snapshot is destroyed.
+    /// Unlike \ref getStatements, this does not set the proc of the statements.
+    void getStatementSnapshot(std::vector<SharedStmt> &stmts) const;
+
+    /// Sets this proc as the owning proc of all statements that do not have one yet.
+    void adoptStatements();
+
     /// Remove (but not delete) \p stmt from this UserProc
     /// \returns true iff successfully removed
     bool removeStatement(const SharedStmt &stmt);
@@ -321,6 +321,16 @@ bool IndirectJumpAnalyzer::processSwitch(IRFragment *frag, UserProc *proc)
     // be a goto to the code for case 3, but a smarter back end could group them
     std::list<std::pair<IRFragment *, Address>> dests;
 
+    // Read tables of 32 bit entries at once; fall back to reading entries one by one
+    // if the table is (partially) outside of initialized data.
+    std::vector<DWord> table;
+    if (numCases > 0 && si->switchType != SwitchType::H && si->switchType != SwitchType::F) {
+        table.resize(numCases);
+        if (!image->readNativeArray4(si->tableAddr, table.data(), numCases)) {
+            table.clear();
+        }
+    }
+
     for (int i = 0; i < numCases; i++) {
         // Get the destination address from the switch table.
         if (si->switchType == SwitchType::H) {
@@ -336,6 +346,9 @@ bool IndirectJumpAnalyzer::processSwitch(IRFragment *frag, UserProc *proc)
             const int *entry  = reinterpret_cast<int *>(si->tableAddr.value());
             switchDestination = Address(entry[i]);
         }
+        else if (!table.empty()) {
+            switchDestination = Address(table[i]);
+        }
         else if (!image->readNativeAddr4(si->tableAddr + 4 * i, switchDestination)) {
             continue;
         }
@@ -454,14 +467,28 @@ bool IndirectJumpAnalyzer::analyzeCompJump(IRFragment *frag, UserProc *proc)
             // findNumCases() thinks is the number of cases, when finding the first array
             // element not pointing to code.
             if (switchType == SwitchType::A) {
-                const Prog *prog = proc->getProg();
+                const Prog *prog         = proc->getProg();
+                const BinaryImage *image = prog->getBinaryFile()->getImage();
+
+                // findNumCases() might overestimate the size of the table,
+                // so the table might not be readable at once.
+                std::vector<DWord> table(std::max(swi->numTableEntries, 0));
+                const bool haveTable = !table.empty() &&
+                                       image->readNativeArray4(swi->tableAddr, table.data(),
+                                                               table.size());
 
                 for (int entryIdx = 0; entryIdx < swi->numTableEntries; ++entryIdx) {
-                    const BinaryImage *image = prog->getBinaryFile()->getImage();
-                    Address switchEntryAddr  = Address::INVALID;
+                    Address switchEntryAddr = Address::INVALID;
+
+                    if (haveTable) {
+                        switchEntryAddr = Address(table[entryIdx]);
+                    }
+                    else if (!image->readNativeAddr4(swi->tableAddr + entryIdx * 4,
+                                                     switchEntryAddr)) {
+                        switchEntryAddr = Address::INVALID;
+                    }
 
-                    if (!image->readNativeAddr4(swi->tableAddr + entryIdx * 4, switchEntryAddr) ||
-                        !Util::inRange(switchEntryAddr, prog->getLimitTextLow(),
+                    if (!Util::inRange(switchEntryAddr, prog->getLimitTextLow(),
                                        prog->getLimitTextHigh())) {
                         if (proc->getProg()->getProject()->getSettings()->debugSwitch) {
                             LOG_WARN("Truncating type A indirect jump array to %1 entries "
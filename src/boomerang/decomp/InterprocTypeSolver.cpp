@@ -0,0 +1,186 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "InterprocTypeSolver.h"
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/decomp/ProcScheduler.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
+#include "boomerang/util/log/Log.h"
+
+#include <vector>
+
+
+InterprocTypeSolver::InterprocTypeSolver(Prog *prog)
+    : m_prog(prog)
+{
+}
+
+
+void InterprocTypeSolver::solve(const ProcSet &procs)
+{
+    const bool propagate = m_prog->getProject()->getSettings()->useTypeAnalysis &&
+                           m_prog->getProject()->getTypeRecoveryEngine() != nullptr;
+
+    ProcSet dirty;
+    for (UserProc *proc : procs) {
+        if (proc->isDecoded()) {
+            dirty.insert(proc);
+        }
+    }
+
+    for (int round = 1; !dirty.empty(); ++round) {
+        if (round > MAX_ROUNDS) {
+            LOG_WARN("Types of %1 procedures did not converge after %2 rounds", dirty.size(),
+                     MAX_ROUNDS);
+            break;
+        }
+
+        ProcScheduler scheduler(m_prog);
+        scheduler.computeWaves(std::vector<UserProc *>(dirty.begin(), dirty.end()));
+
+        for (const ProcScheduler::Wave &wave : scheduler.getWaves()) {
+            for (const ProcScheduler::Component &component : wave) {
+                for (UserProc *proc : component) {
+                    // The local analysis takes all changes up to now into account
+                    dirty.erase(proc);
+
+                    LOG_VERBOSE("Global type analysis for '%1'", proc->getName());
+                    PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
+                    m_numLocalAnalyses++;
+
+                    if (propagate) {
+                        propagateCallTypes(proc, dirty);
+                    }
+                }
+            }
+        }
+    }
+}
+
+
+void InterprocTypeSolver::propagateCallTypes(UserProc *proc, ProcSet &dirty)
+{
+    for (IRFragment *frag : *proc->getCFG()) {
+        const SharedStmt last = frag->getLastStmt();
+
+        if (last && last->isCall()) {
+            meetCallTypes(last->as<CallStatement>(), dirty);
+        }
+    }
+
+    for (const std::shared_ptr<CallStatement> &call : proc->getCallers()) {
+        if (call->getProc() != proc) { // already done above
+            meetCallTypes(call, dirty);
+        }
+    }
+}
+
+
+void InterprocTypeSolver::meetCallTypes(const std::shared_ptr<CallStatement> &call,
+                                        ProcSet &dirty)
+{
+    UserProc *caller = call->getProc();
+    Function *dest   = call->getDestProc();
+
+    // Library signatures are already applied to the arguments by CallStatement::updateArguments
+    if (!caller || !caller->isDecoded() || !dest || dest->isLib()) {
+        return;
+    }
+
+    UserProc *callee = static_cast<UserProc *>(dest);
+    if (!callee->isDecoded()) {
+        return;
+    }
+
+    // Forced signatures are authoritative; only update the caller side
+    const bool updateCallee               = !callee->getSignature()->isForced();
+    const std::shared_ptr<Signature> &sig = callee->getSignature();
+
+    for (const SharedStmt &stmt : call->getArguments()) {
+        std::shared_ptr<Assignment> arg = stmt->as<Assignment>();
+        const int paramIdx              = sig->findParam(arg->getLeft());
+
+        if (paramIdx == -1 || !arg->getType() || !sig->getParamType(paramIdx)) {
+            continue; // e.g. ellipsis arguments
+        }
+
+        bool argChanged      = false;
+        bool paramChanged    = false;
+        const SharedType met = meetTypes(arg->getType(), sig->getParamType(paramIdx), argChanged,
+                                         paramChanged);
+
+        if (argChanged) {
+            arg->setType(met);
+            markChanged(caller, dirty);
+        }
+
+        if (paramChanged && updateCallee) {
+            callee->setParamType(paramIdx, met);
+            markChanged(callee, dirty);
+        }
+    }
+
+    if (!callee->getRetStmt()) {
+        return;
+    }
+
+    for (const SharedStmt &stmt : call->getDefines()) {
+        std::shared_ptr<Assignment> result = stmt->as<Assignment>();
+
+        for (const SharedStmt &retStmt : callee->getRetStmt()->getReturns()) {
+            std::shared_ptr<Assignment> ret = retStmt->as<Assignment>();
+
+            if (*ret->getLeft() != *result->getLeft()) {
+                continue;
+            }
+            else if (!ret->getType() || !result->getType()) {
+                break;
+            }
+
+            bool resultChanged   = false;
+            bool retChanged      = false;
+            const SharedType met = meetTypes(result->getType(), ret->getType(), resultChanged,
+                                             retChanged);
+
+            if (resultChanged) {
+                result->setType(met);
+                markChanged(caller, dirty);
+            }
+
+            if (retChanged && updateCallee) {
+                ret->setType(met);
+                markChanged(callee, dirty);
+            }
+
+            break;
+        }
+    }
+}
+
+
+SharedType InterprocTypeSolver::meetTypes(const SharedType &callerType,
+                                          const SharedType &calleeType, bool &callerChanged,
+                                          bool &calleeChanged)
+{
+    const SharedType met = callerType->meetWith(calleeType, callerChanged);
+    return calleeType->meetWith(met, calleeChanged);
+}
+
+
+void InterprocTypeSolver::markChanged(UserProc *proc, ProcSet &dirty)
+{
+    dirty.insert(proc);
+    m_numChangedTypes++;
+}
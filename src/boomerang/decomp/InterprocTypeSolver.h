@@ -0,0 +1,85 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/type/Type.h"
+
+#include <memory>
+
+
+class CallStatement;
+class Prog;
+
+
+/**
+ * Propagates types across calls between user procedures.
+ *
+ * Local type analysis only sees the types of the parameters and returns of the procedure
+ * it is analysing. This solver connects the types at each call of a user procedure:
+ *  - the type of each argument of the call and the type of the corresponding parameter
+ *    of the callee, and
+ *  - the type of each result defined by the call and the type of the corresponding return
+ *    of the callee.
+ * The two types of each pair are met with each other. If this changes a type,
+ * the procedure owning it has to be analysed locally again, which may in turn change
+ * the types at the calls of that procedure.
+ *
+ * Dirty procedures are analysed bottom-up along the call graph (cf. \ref ProcScheduler),
+ * so the parameter types of a callee are usually known before its callers are analysed.
+ * Procedures whose types do not change are never analysed again.
+ */
+class BOOMERANG_API InterprocTypeSolver
+{
+public:
+    /// The maximum number of times all dirty procedures are analysed
+    static constexpr const int MAX_ROUNDS = 10;
+
+public:
+    explicit InterprocTypeSolver(Prog *prog);
+
+public:
+    /**
+     * Analyse the types of \p procs and propagate the types across all calls
+     * to and from these procedures until no more types change.
+     */
+    void solve(const ProcSet &procs);
+
+    /// \returns the number of local type analyses performed by \ref solve
+    int getNumLocalAnalyses() const { return m_numLocalAnalyses; }
+
+    /// \returns the number of types changed by meeting types across calls
+    int getNumChangedTypes() const { return m_numChangedTypes; }
+
+private:
+    /// Meet the types at all calls from and to \p proc.
+    /// Procedures with changed types are added to \p dirty.
+    void propagateCallTypes(UserProc *proc, ProcSet &dirty);
+
+    /// Meet the types of the arguments and results of \p call with the types
+    /// of the parameters and returns of the callee.
+    /// Procedures with changed types are added to \p dirty.
+    void meetCallTypes(const std::shared_ptr<CallStatement> &call, ProcSet &dirty);
+
+    /// Meet the type of a location in the caller with the type of the same location
+    /// in the callee. \returns the met type.
+    static SharedType meetTypes(const SharedType &callerType, const SharedType &calleeType,
+                                bool &callerChanged, bool &calleeChanged);
+
+    /// Schedule \p proc for local type analysis after one of its types changed.
+    void markChanged(UserProc *proc, ProcSet &dirty);
+
+private:
+    Prog *m_prog;
+    int m_numLocalAnalyses = 0;
+    int m_numChangedTypes  = 0;
+};
@@ -20,16 +20,12 @@
 #include "boomerang/util/ConnectionGraph.h"
 #include "boomerang/util/log/Log.h"
 
+#include <algorithm>
 #include <deque>
 
 
-/**
- * Check for overlap of liveness between the currently live locations (liveLocs) and the set of
- * locations in \p ls.
- * Also check for type conflicts when using DFA type analysis
- * This is a helper function.
- */
-void checkForOverlap(LocationSet &liveLocs, LocationSet &ls, ConnectionGraph &ig, UserProc *proc)
+void LivenessAnalyzer::checkForOverlap(BitSet &liveLocs, const LocationSet &ls,
+                                       ConnectionGraph &ig, UserProc *proc)
 {
     // For each location to be considered
     for (SharedExp exp : ls) {
@@ -38,12 +34,15 @@ void checkForOverlap(LocationSet &liveLocs, LocationSet &ls, ConnectionGraph &ig
         }
 
         assert(std::dynamic_pointer_cast<RefExp>(exp) != nullptr);
-        auto refexp = exp->access<RefExp>();
+        auto refexp           = exp->access<RefExp>();
+        const std::size_t loc = numberLocation(refexp);
 
         // Interference if we can find a live variable which differs only in the reference
-        SharedExp dr;
+        const std::size_t differentLoc = findDifferentRef(liveLocs, loc);
+
+        if (differentLoc != LocationNumbering::INVALID) {
+            SharedExp dr = m_locations.getLocation(differentLoc);
 
-        if (liveLocs.findDifferentRef(refexp, dr)) {
             assert(dr->access<RefExp>()->getDef() != nullptr);
             assert(exp->access<RefExp>()->getDef() != nullptr);
             // We have an interference between r and dr. Record it
@@ -56,7 +55,7 @@ void checkForOverlap(LocationSet &liveLocs, LocationSet &ls, ConnectionGraph &ig
 
         // Add the uses one at a time. Note: don't use makeUnion, because then we don't discover
         // interferences from the same statement, e.g.  blah := r24{2} + r24{3}
-        liveLocs.insert(exp);
+        liveLocs.set(loc);
     }
 }
 
@@ -64,7 +63,8 @@ void checkForOverlap(LocationSet &liveLocs, LocationSet &ls, ConnectionGraph &ig
 bool LivenessAnalyzer::calcLiveness(IRFragment *frag, ConnectionGraph &ig, UserProc *myProc)
 {
     // Start with the liveness at the bottom of the fragment
-    LocationSet liveLocs, phiLocs;
+    BitSet liveLocs;
+    LocationSet phiLocs;
     getLiveOut(frag, liveLocs, phiLocs);
 
     // Do the livenesses that result from phi statements at successors first.
@@ -86,8 +86,14 @@ bool LivenessAnalyzer::calcLiveness(IRFragment *frag, ConnectionGraph &ig, UserP
             // The definitions don't have refs yet
             defs.addSubscript(s);
 
-            // Definitions kill uses. Now we are moving to the "top" of statement s
-            liveLocs.makeDiff(defs);
+            // Definitions kill uses. Now we are moving to the "top" of statement s.
+            // Locations that were not numbered yet cannot be live.
+            for (const SharedExp &def : defs) {
+                const std::size_t loc = m_locations.find(def);
+                if (loc != LocationNumbering::INVALID) {
+                    liveLocs.reset(loc);
+                }
+            }
 
             // Phi functions are a special case. The operands of phi functions are uses,
             // but they don't interfere with each other (since they come via different fragments).
@@ -105,14 +111,15 @@ bool LivenessAnalyzer::calcLiveness(IRFragment *frag, ConnectionGraph &ig, UserP
             checkForOverlap(liveLocs, uses, ig, myProc);
 
             if (debugLiveness) {
-                LOG_MSG(" ## liveness: at top of %1, liveLocs is %2", s, liveLocs.toString());
+                LOG_MSG(" ## liveness: at top of %1, liveLocs is %2", s, toString(liveLocs));
             }
         }
     }
 
     // liveIn is what we calculated last time
-    if (!(liveLocs == m_liveIn[frag])) {
-        m_liveIn[frag] = liveLocs;
+    BitSet &liveIn = m_liveIn[frag];
+    if (liveLocs != liveIn) {
+        liveIn = std::move(liveLocs);
         return true; // A change
     }
 
@@ -121,7 +128,7 @@ bool LivenessAnalyzer::calcLiveness(IRFragment *frag, ConnectionGraph &ig, UserP
 }
 
 
-void LivenessAnalyzer::getLiveOut(IRFragment *frag, LocationSet &liveout, LocationSet &phiLocs)
+void LivenessAnalyzer::getLiveOut(IRFragment *frag, BitSet &liveout, LocationSet &phiLocs)
 {
     ProcCFG *cfg         = frag->getProc()->getCFG();
     const bool debugLive = cfg->getProc()->getProg()->getProject()->getSettings()->debugLiveness;
@@ -204,8 +211,8 @@ void LivenessAnalyzer::getLiveOut(IRFragment *frag, LocationSet &liveout, Locati
             }
 
             assert(def);
-            SharedExp ref = RefExp::get(pa->getLeft()->clone(), def);
-            liveout.insert(ref);
+            std::shared_ptr<RefExp> ref = RefExp::get(pa->getLeft()->clone(), def);
+            liveout.set(numberLocation(ref));
             phiLocs.insert(ref);
 
             if (debugLive) {
@@ -215,3 +222,51 @@ void LivenessAnalyzer::getLiveOut(IRFragment *frag, LocationSet &liveout, Locati
         }
     }
 }
+
+
+std::size_t LivenessAnalyzer::numberLocation(const std::shared_ptr<RefExp> &ref)
+{
+    std::size_t loc = m_locations.find(ref);
+    if (loc != LocationNumbering::INVALID) {
+        return loc;
+    }
+
+    loc                    = m_locations.insert(ref->clone());
+    const std::size_t base = m_bases.insert(m_locations.getLocation(loc)->getSubExp1());
+
+    m_baseOf.push_back(base);
+    if (base >= m_refsOfBase.size()) {
+        m_refsOfBase.resize(base + 1);
+    }
+
+    // keep the locations sorted so that findDifferentRef finds the smallest location
+    std::vector<std::size_t> &refs = m_refsOfBase[base];
+    auto pos = std::upper_bound(refs.begin(), refs.end(), loc,
+                                [this](std::size_t a, std::size_t b) {
+                                    return lessExpStar()(m_locations.getLocation(a),
+                                                         m_locations.getLocation(b));
+                                });
+
+    refs.insert(pos, loc);
+    return loc;
+}
+
+
+std::size_t LivenessAnalyzer::findDifferentRef(const BitSet &liveLocs, std::size_t ref) const
+{
+    for (std::size_t loc : m_refsOfBase[m_baseOf[ref]]) {
+        if (loc != ref && liveLocs.test(loc)) {
+            return loc;
+        }
+    }
+
+    return LocationNumbering::INVALID;
+}
+
+
+QString LivenessAnalyzer::toString(const BitSet &liveLocs) const
+{
+    LocationSet locs;
+    liveLocs.forEach([this, &locs](std::size_t loc) { locs.insert(m_locations.getLocation(loc)); });
+    return locs.toString();
+}
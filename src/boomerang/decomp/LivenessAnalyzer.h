@@ -10,6 +10,8 @@
 #pragma once
 
 
+#include "boomerang/util/BitSet.h"
+#include "boomerang/util/LocationNumbering.h"
 #include "boomerang/util/LocationSet.h"
 
 #include <unordered_map>
@@ -17,9 +19,17 @@
 
 class IRFragment;
 class ConnectionGraph;
+class RefExp;
 class UserProc;
 
 
+/**
+ * Calculates the liveness of subscripted locations and records interferences
+ * between different versions of the same location.
+ *
+ * All subscripted locations are numbered densely, so that the sets of live locations
+ * can be represented as bit sets.
+ */
 class LivenessAnalyzer
 {
 public:
@@ -31,9 +41,41 @@ public:
     /// Locations that are live at the end of this BB are the union of the locations that are live
     /// at the start of its successors. \p live gets all the livenesses,
     /// and phiLocs gets a subset of these, which are due to phi statements at the top of successors
-    void getLiveOut(IRFragment *frag, LocationSet &live, LocationSet &phiLocs);
+    void getLiveOut(IRFragment *frag, BitSet &live, LocationSet &phiLocs);
+
+private:
+    /**
+     * Check for overlap of liveness between the currently live locations (\p liveLocs)
+     * and the set of locations in \p ls, and add the locations in \p ls to \p liveLocs.
+     */
+    void checkForOverlap(BitSet &liveLocs, const LocationSet &ls, ConnectionGraph &ig,
+                         UserProc *proc);
+
+    /// Number the subscripted location \p ref.
+    /// \returns the index of \p ref.
+    std::size_t numberLocation(const std::shared_ptr<RefExp> &ref);
+
+    /**
+     * Find a live location that only differs from \p ref in the reference.
+     * If there are multiple such locations, the smallest one (according to lessExpStar)
+     * is returned.
+     * \returns the index of the location, or LocationNumbering::INVALID if not found.
+     */
+    std::size_t findDifferentRef(const BitSet &liveLocs, std::size_t ref) const;
+
+    /// \returns the live locations in \p liveLocs, for debugging
+    QString toString(const BitSet &liveLocs) const;
 
 private:
+    LocationNumbering m_locations; ///< Numbers all subscripted locations
+    LocationNumbering m_bases;     ///< Numbers the locations without subscripts
+
+    std::vector<std::size_t> m_baseOf; ///< For each location index, the index of its base
+
+    /// For each base index, the indices of all locations with this base,
+    /// sorted by lessExpStar
+    std::vector<std::vector<std::size_t>> m_refsOfBase;
+
     ///< Set of locations live at fragment start
-    std::unordered_map<IRFragment *, LocationSet> m_liveIn;
+    std::unordered_map<IRFragment *, BitSet> m_liveIn;
 };
@@ -626,8 +626,8 @@ bool ProcDecompiler::tryConvertCallsToDirect(UserProc *proc)
 bool ProcDecompiler::tryConvertFunctionPointerAssignments(UserProc *proc)
 {
     bool changed = false;
-    StatementList statements;
-    proc->getStatements(statements);
+    std::vector<SharedStmt> statements;
+    proc->getStatementSnapshot(statements);
 
     for (SharedStmt stmt : statements) {
         if (stmt->isAssign()) {
@@ -0,0 +1,220 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProcScheduler.h"
+
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+
+
+ProcScheduler::ProcScheduler(Prog *prog)
+    : m_prog(prog)
+{
+}
+
+
+void ProcScheduler::computeWaves()
+{
+    std::vector<UserProc *> procs;
+    for (const auto &module : m_prog->getModuleList()) {
+        for (Function *func : *module) {
+            if (!func->isLib() && !static_cast<UserProc *>(func)->isDecompiled()) {
+                procs.push_back(static_cast<UserProc *>(func));
+            }
+        }
+    }
+
+    computeWaves(std::move(procs));
+}
+
+
+void ProcScheduler::computeWaves(std::vector<UserProc *> procs)
+{
+    m_waves.clear();
+
+    std::sort(procs.begin(), procs.end(), lessUserProc());
+
+    std::unordered_map<UserProc *, int> procIndex;
+    for (int i = 0; i < static_cast<int>(procs.size()); ++i) {
+        procIndex[procs[i]] = i;
+    }
+
+    std::vector<std::vector<int>> callees(procs.size());
+    for (int i = 0; i < static_cast<int>(procs.size()); ++i) {
+        for (Function *callee : procs[i]->getCallees()) {
+            if (callee->isLib()) {
+                continue;
+            }
+
+            auto it = procIndex.find(static_cast<UserProc *>(callee));
+            if (it != procIndex.end()) {
+                callees[i].push_back(it->second);
+            }
+        }
+    }
+
+    // Iterative version of Tarjan's algorithm, to not overflow the stack on deep call chains.
+    // Components are found in reverse topological order, i.e. callees before callers.
+    const int numProcs = static_cast<int>(procs.size());
+    int nextIndex      = 0;
+    std::vector<int> index(numProcs, -1);
+    std::vector<int> lowLink(numProcs, 0);
+    std::vector<int> component(numProcs, -1);
+    std::vector<bool> onStack(numProcs, false);
+    std::vector<int> sccStack;
+    std::vector<std::pair<int, size_t>> dfsStack; // (proc, next callee to visit)
+
+    std::vector<Component> components;
+    std::vector<int> componentWave;
+
+    for (int start = 0; start < numProcs; ++start) {
+        if (index[start] != -1) {
+            continue;
+        }
+
+        index[start] = lowLink[start] = nextIndex++;
+        sccStack.push_back(start);
+        onStack[start] = true;
+        dfsStack.push_back({ start, 0 });
+
+        while (!dfsStack.empty()) {
+            const int v = dfsStack.back().first;
+
+            if (dfsStack.back().second < callees[v].size()) {
+                const int w = callees[v][dfsStack.back().second++];
+
+                if (index[w] == -1) {
+                    index[w] = lowLink[w] = nextIndex++;
+                    sccStack.push_back(w);
+                    onStack[w] = true;
+                    dfsStack.push_back({ w, 0 });
+                }
+                else if (onStack[w]) {
+                    lowLink[v] = std::min(lowLink[v], index[w]);
+                }
+
+                continue;
+            }
+
+            dfsStack.pop_back();
+            if (!dfsStack.empty()) {
+                const int u = dfsStack.back().first;
+                lowLink[u]  = std::min(lowLink[u], lowLink[v]);
+            }
+
+            if (lowLink[v] != index[v]) {
+                continue;
+            }
+
+            // v is the root of a new component
+            const int compIdx = static_cast<int>(components.size());
+            components.emplace_back();
+
+            int w = -1;
+            do {
+                w = sccStack.back();
+                sccStack.pop_back();
+                onStack[w]   = false;
+                component[w] = compIdx;
+                components.back().push_back(procs[w]);
+            } while (w != v);
+
+            // All callees outside of this component have already been assigned a wave
+            int wave = 0;
+            for (UserProc *proc : components.back()) {
+                for (int callee : callees[procIndex[proc]]) {
+                    if (component[callee] != compIdx) {
+                        wave = std::max(wave, componentWave[component[callee]] + 1);
+                    }
+                }
+            }
+
+            componentWave.push_back(wave);
+            std::sort(components.back().begin(), components.back().end(), lessUserProc());
+        }
+    }
+
+    for (int i = 0; i < static_cast<int>(components.size()); ++i) {
+        const int wave = componentWave[i];
+        if (wave >= static_cast<int>(m_waves.size())) {
+            m_waves.resize(wave + 1);
+        }
+
+        m_waves[wave].push_back(std::move(components[i]));
+    }
+
+    for (Wave &wave : m_waves) {
+        std::sort(wave.begin(), wave.end(), [](const Component &lhs, const Component &rhs) {
+            return lessUserProc()(lhs.front(), rhs.front());
+        });
+    }
+}
+
+
+int ProcScheduler::getNumProcs() const
+{
+    int numProcs = 0;
+
+    for (const Wave &wave : m_waves) {
+        for (const Component &comp : wave) {
+            numProcs += static_cast<int>(comp.size());
+        }
+    }
+
+    return numProcs;
+}
+
+
+void ProcScheduler::forEachProc(const std::vector<UserProc *> &procs, int numThreads,
+                                const std::function<void(UserProc *)> &func)
+{
+    forEachIndex(procs.size(), numThreads, [&procs, &func](std::size_t i) { func(procs[i]); });
+}
+
+
+void ProcScheduler::forEachIndex(std::size_t count, int numThreads,
+                                 const std::function<void(std::size_t)> &func)
+{
+    numThreads = static_cast<int>(std::min<std::size_t>(std::max(numThreads, 0), count));
+
+    if (numThreads <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+
+        return;
+    }
+
+    std::atomic<std::size_t> nextIndex(0);
+    auto worker = [count, &func, &nextIndex]() {
+        for (std::size_t i = nextIndex++; i < count; i = nextIndex++) {
+            func(i);
+        }
+    };
+
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+
+    for (int i = 1; i < numThreads; ++i) {
+        threads.emplace_back(worker);
+    }
+
+    worker();
+
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+}
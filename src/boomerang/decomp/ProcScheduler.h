@@ -0,0 +1,75 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <functional>
+#include <vector>
+
+
+class Prog;
+class UserProc;
+
+
+/**
+ * Orders the UserProcs of a program bottom-up along the call graph.
+ *
+ * The call graph is split into strongly connected components (i.e. recursion groups).
+ * The components are then arranged in waves: A component of wave n only calls
+ * procedures of waves 0..n-1 (or of the same component), so processing the waves in order
+ * processes all callees before their callers. Wave 0 contains all leaf procedures.
+ *
+ * The order of waves, components and procedures only depends on the entry addresses
+ * of the procedures.
+ */
+class BOOMERANG_API ProcScheduler
+{
+public:
+    /// A strongly connected component of the call graph, sorted by entry address
+    typedef std::vector<UserProc *> Component;
+
+    /// Independent components, sorted by the entry address of their first procedure
+    typedef std::vector<Component> Wave;
+
+public:
+    ProcScheduler(Prog *prog);
+
+public:
+    /// Compute the components and waves of all user procedures that are not decompiled yet.
+    void computeWaves();
+
+    /// Compute the components and waves of \p procs.
+    /// Calls to procedures not in \p procs are ignored.
+    void computeWaves(std::vector<UserProc *> procs);
+
+    const std::vector<Wave> &getWaves() const { return m_waves; }
+
+    /// \returns the total number of procedures in all waves
+    int getNumProcs() const;
+
+    /**
+     * Call \p func for every procedure in \p procs, using up to \p numThreads threads.
+     * \p func must only access data that is local to the procedure it is called with.
+     * For \p numThreads <= 1, all procedures are processed on the calling thread in order.
+     */
+    static void forEachProc(const std::vector<UserProc *> &procs, int numThreads,
+                            const std::function<void(UserProc *)> &func);
+
+    /// Call \p func for every index in [0, \p count), using up to \p numThreads threads.
+    /// \sa forEachProc
+    static void forEachIndex(std::size_t count, int numThreads,
+                             const std::function<void(std::size_t)> &func);
+
+private:
+    Prog *m_prog;
+    std::vector<Wave> m_waves;
+};
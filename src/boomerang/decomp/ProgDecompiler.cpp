@@ -16,6 +16,8 @@
 #include "boomerang/db/module/Module.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/decomp/CFGCompressor.h"
+#include "boomerang/decomp/InterprocTypeSolver.h"
+#include "boomerang/decomp/ProcScheduler.h"
 #include "boomerang/decomp/UnusedReturnRemover.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/exp/Const.h"
@@ -67,45 +69,52 @@ void ProgDecompiler::decompile()
         }
     }
 
-    globalTypeAnalysis();
+    LOG_VERBOSE("Proof cache: %1 hits, %2 misses", m_prog->getProofCache().getNumHits(),
+                m_prog->getProofCache().getNumMisses());
 
-    if (m_prog->getProject()->getSettings()->removeReturns) {
-        // Repeat until no change. Not 100% sure if needed.
-        while (removeUnusedParamsAndReturns()) {
-            for (auto &module : m_prog->getModuleList()) {
-                for (Function *proc : *module) {
-                    if (proc->isLib()) {
-                        continue;
-                    }
+    // Each procedure has only been analysed locally while it was decompiled,
+    // so the types still have to be propagated across calls.
+    const std::vector<UserProc *> userProcs = getUserProcs();
+    globalTypeAnalysis(ProcSet(userProcs.begin(), userProcs.end()));
 
-                    PassManager::get()->executePass(PassID::BranchAnalysis,
-                                                    static_cast<UserProc *>(proc));
-                }
-            }
+    if (m_prog->getProject()->getSettings()->removeReturns) {
+        // Only procedures changed by removing returns need their types updated
+        ProcSet changedProcs;
+        if (removeUnusedParamsAndReturns(changedProcs)) {
+            globalTypeAnalysis(changedProcs);
         }
     }
 
-    globalTypeAnalysis();
-
     // Now it is OK to transform out of SSA form
     fromSSAForm();
     removeUnusedGlobals();
 
     LOG_MSG("Compressing CFG...");
 
+    ProcScheduler::forEachProc(getUserProcs(), m_prog->getProject()->getSettings()->numThreads,
+                               [](UserProc *proc) { CFGCompressor().compressCFG(proc->getCFG()); });
+
+    LOG_MSG("Decompilation finished.");
+}
+
+
+std::vector<UserProc *> ProgDecompiler::getUserProcs() const
+{
+    std::vector<UserProc *> procs;
+
     for (const auto &module : m_prog->getModuleList()) {
         for (Function *func : *module) {
             if (!func->isLib()) {
-                CFGCompressor().compressCFG(static_cast<UserProc *>(func)->getCFG());
+                procs.push_back(static_cast<UserProc *>(func));
             }
         }
     }
 
-    LOG_MSG("Decompilation finished.");
+    return procs;
 }
 
 
-void ProgDecompiler::globalTypeAnalysis()
+void ProgDecompiler::globalTypeAnalysis(const ProcSet &procs)
 {
     LOG_MSG("Performing global type analysis...");
 
@@ -113,20 +122,12 @@ void ProgDecompiler::globalTypeAnalysis()
         LOG_VERBOSE("### Start global data-flow-based type analysis ###");
     }
 
-    for (const auto &module : m_prog->getModuleList()) {
-        for (Function *pp : *module) {
-            UserProc *proc = dynamic_cast<UserProc *>(pp);
+    InterprocTypeSolver solver(m_prog);
+    solver.solve(procs);
 
-            if (!proc || !proc->isDecoded()) {
-                continue;
-            }
-
-            // FIXME: this just does local TA again. Need to meet types for all parameter/arguments,
-            // and return/results! This will require a repeat until no change loop
-            LOG_VERBOSE("Global type analysis for '%1'", proc->getName());
-            PassManager::get()->executePass(PassID::LocalTypeAnalysis, proc);
-        }
-    }
+    LOG_VERBOSE("Global type analysis: %1 local analyses for %2 procedures, "
+                "%3 types changed at calls",
+                solver.getNumLocalAnalyses(), procs.size(), solver.getNumChangedTypes());
 
     if (m_prog->getProject()->getSettings()->debugTA) {
         LOG_VERBOSE("### End type analysis ###");
@@ -151,11 +152,7 @@ void ProgDecompiler::removeUnusedGlobals()
             Location search(opGlobal, Terminal::get(opWild), proc);
             // Search each statement in u, excepting implicit assignments (their uses don't count,
             // since they don't really exist in the program representation)
-            StatementList stmts;
-            StatementList::iterator ss;
-            proc->getStatements(stmts);
-
-            for (SharedStmt s : stmts) {
+            for (const SharedStmt &s : proc->getStatementRange()) {
                 if (s->isImplicit()) {
                     continue; // Ignore the uses in ImplicitAssigns
                 }
@@ -177,8 +174,7 @@ void ProgDecompiler::removeUnusedGlobals()
     }
 
     // Rebuild the globals vector. Delete the unused globals only after re-inserting them
-    Prog::GlobalSet oldGlobals = m_prog->getGlobals();
-    m_prog->getGlobals().clear();
+    Prog::GlobalSet newGlobals;
 
     for (const SharedExp &e : usedGlobals) {
         if (m_prog->getProject()->getSettings()->debugUnused) {
@@ -189,19 +185,21 @@ void ProgDecompiler::removeUnusedGlobals()
         auto &usedGlobal = namedGlobals[name];
 
         if (usedGlobal) {
-            m_prog->getGlobals().insert(usedGlobal);
+            newGlobals.insert(usedGlobal);
         }
         else {
             LOG_WARN("An expression refers to a nonexistent global");
         }
     }
+
+    m_prog->setGlobals(newGlobals);
 }
 
 
-bool ProgDecompiler::removeUnusedParamsAndReturns()
+bool ProgDecompiler::removeUnusedParamsAndReturns(ProcSet &changedProcs)
 {
     LOG_MSG("Removing unused returns...");
-    return UnusedReturnRemover(m_prog).removeUnusedReturns();
+    return UnusedReturnRemover(m_prog).removeAllUnusedReturns(changedProcs);
 }
 
 
@@ -209,15 +207,9 @@ void ProgDecompiler::fromSSAForm()
 {
     LOG_MSG("Transforming from SSA form...");
 
-    for (const auto &module : m_prog->getModuleList()) {
-        for (Function *pp : *module) {
-            if (pp->isLib()) {
-                continue;
-            }
-
-            UserProc *proc = static_cast<UserProc *>(pp);
-            proc->numberStatements();
-            PassManager::get()->executePass(PassID::FromSSAForm, proc);
-        }
+    // Not parallel: the passes notify the project watchers, which are not thread safe.
+    for (UserProc *proc : getUserProcs()) {
+        proc->numberStatements();
+        PassManager::get()->executePass(PassID::FromSSAForm, proc);
     }
 }
@@ -11,6 +11,9 @@
 
 
 #include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/db/proc/UserProc.h"
+
+#include <vector>
 
 
 class Prog;
@@ -26,16 +29,20 @@ public:
     void decompile();
 
 private:
-    /// Do global type analysis.
-    /// \note For now, it just does local type analysis for every procedure of the program.
-    void globalTypeAnalysis();
+    /// \returns all user procedures of all modules, in module order.
+    std::vector<UserProc *> getUserProcs() const;
+
+    /// Do global type analysis for \p procs and propagate types across calls.
+    /// \sa InterprocTypeSolver
+    void globalTypeAnalysis(const ProcSet &procs);
 
     /// As the name suggests, removes globals unused in the decompiled code.
     void removeUnusedGlobals();
 
     /// Remove unused or redundant parameters and return values from the program.
+    /// All procedures changed in the process are added to \p changedProcs.
     /// \returns true if any change
-    bool removeUnusedParamsAndReturns();
+    bool removeUnusedParamsAndReturns(ProcSet &changedProcs);
 
     /// Have to transform out of SSA form after the above final pass
     /// Convert from SSA form
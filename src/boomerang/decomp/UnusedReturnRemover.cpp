@@ -23,45 +23,62 @@
 #include "boomerang/visitor/expmodifier/ImplicitConverter.h"
 
 
-bool compareUserProc(const UserProc *lhs, const UserProc *rhs)
+UnusedReturnRemover::UnusedReturnRemover(Prog *prog)
+    : m_prog(prog)
 {
-    if (lhs && rhs) {
-        return lhs->getEntryAddress() < rhs->getEntryAddress();
-    }
-    else {
-        return lhs < rhs;
-    }
 }
 
 
-UnusedReturnRemover::UnusedReturnRemover(Prog *prog)
-    : m_prog(prog)
+bool UnusedReturnRemover::removeAllUnusedReturns(ProcSet &changedProcs)
 {
+    bool change = false;
+
+    // Repeat until no change. Only procedures changed by removing returns need their branches
+    // analysed again. If that removes fragments, the uses and definitions of the procedure change,
+    // so the procedure and its callers and callees have to be processed again.
+    while (removeUnusedReturns()) {
+        change = true;
+        changedProcs.insert(m_changedProcs.begin(), m_changedProcs.end());
+
+        for (UserProc *proc : m_changedProcs) {
+            if (PassManager::get()->executePass(PassID::BranchAnalysis, proc)) {
+                scheduleNeighbours(proc);
+            }
+        }
+    }
+
+    return change;
 }
 
 
 bool UnusedReturnRemover::removeUnusedReturns()
 {
-    for (const auto &module : m_prog->getModuleList()) {
-        for (Function *proc : *module) {
-            if (proc && !proc->isLib() && static_cast<UserProc *>(proc)->isDecoded()) {
-                m_removeRetSet.insert(static_cast<UserProc *>(proc));
+    if (!m_allScheduled) {
+        for (const auto &module : m_prog->getModuleList()) {
+            for (Function *proc : *module) {
+                schedule(proc);
             }
-            // else e.g. use -sf file to just prototype the proc
         }
+
+        m_allScheduled = true;
     }
 
+    m_changedProcs.clear();
+
     bool change = false;
-    // The workset is processed in order of entry address. This is to provide a consistent
-    // deterministic order of processing. Note that sometimes changes propagate down the call tree
-    // (no caller uses potential returns for child), and sometimes up the call tree
-    // (removal of returns and/or dead code removes parameters, which affects all callers).
+    // The workset is processed in order of entry address (ProcSet is ordered by entry address).
+    // This is to provide a consistent deterministic order of processing. Note that sometimes
+    // changes propagate down the call tree (no caller uses potential returns for child),
+    // and sometimes up the call tree (removal of returns and/or dead code removes parameters,
+    // which affects all callers).
     while (!m_removeRetSet.empty()) {
-        auto it = std::min_element(m_removeRetSet.begin(), m_removeRetSet.end(), compareUserProc);
+        auto it = m_removeRetSet.begin();
         assert(*it != nullptr);
         const bool removedReturns = removeUnusedParamsAndReturns(*it);
 
         if (removedReturns) {
+            m_changedProcs.insert(*it);
+
             // Removing returns changes the uses of the callee.
             // So we have to do type analyis to update the use information.
             PassManager::get()->executePass(PassID::LocalTypeAnalysis, *it);
@@ -80,6 +97,29 @@ bool UnusedReturnRemover::removeUnusedReturns()
 }
 
 
+void UnusedReturnRemover::scheduleNeighbours(UserProc *proc)
+{
+    schedule(proc);
+
+    for (const std::shared_ptr<CallStatement> &call : proc->getCallers()) {
+        schedule(call->getProc());
+    }
+
+    for (Function *callee : proc->getCallees()) {
+        schedule(callee);
+    }
+}
+
+
+void UnusedReturnRemover::schedule(Function *proc)
+{
+    if (proc && !proc->isLib() && static_cast<UserProc *>(proc)->isDecoded()) {
+        m_removeRetSet.insert(static_cast<UserProc *>(proc));
+    }
+    // else e.g. use -sf file to just prototype the proc
+}
+
+
 bool UnusedReturnRemover::removeUnusedParamsAndReturns(UserProc *proc)
 {
     assert(m_removeRetSet.find(proc) != m_removeRetSet.end());
@@ -204,6 +244,8 @@ void UnusedReturnRemover::updateForUseChange(UserProc *proc)
         LOG_MSG("%%% updating dataflow:");
     }
 
+    m_changedProcs.insert(proc);
+
     // Save the old parameters and call liveness
     const size_t oldNumParameters = proc->getParameters().size();
     std::map<std::shared_ptr<CallStatement>, UseCollector> callLiveness;
@@ -10,6 +10,7 @@
 #pragma once
 
 
+#include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ssl/exp/ExpHelp.h"
 
@@ -19,12 +20,22 @@
 class Prog;
 
 
-class UnusedReturnRemover
+class BOOMERANG_API UnusedReturnRemover
 {
 public:
     explicit UnusedReturnRemover(Prog *prog);
 
 public:
+    /**
+     * Remove unused returns and parameters from all decoded procedures until nothing changes.
+     * The branches of every procedure changed in the process are analysed again.
+     * If that changes a procedure, its returns and those of its callers and callees
+     * are checked again.
+     * All procedures changed in the process are added to \p changedProcs.
+     * \returns true if any change
+     */
+    bool removeAllUnusedReturns(ProcSet &changedProcs);
+
     /**
      * Remove unused return locations.
      * This is the global removing of unused and redundant returns. The initial idea
@@ -36,10 +47,18 @@ public:
      * 2) if the return is implicitly defined, then the parameters may be reduced, which affects all
      * callers 3) if the return is defined at a call, the location may no longer be live at the
      * call. If not, you need to check the child, and do the union again (hence needing a list of
-     * callers) to find out if this change also affects that child. \returns true if any change
+     * callers) to find out if this change also affects that child.
+     *
+     * The first call processes all decoded procedures. Subsequent calls only process
+     * procedures that were scheduled since (cf. \ref scheduleNeighbours).
+     * \returns true if any change
      */
     bool removeUnusedReturns();
 
+    /// \returns the procedures whose returns, parameters or dataflow were changed
+    /// by the last call to \ref removeUnusedReturns.
+    const ProcSet &getChangedProcs() const { return m_changedProcs; }
+
 private:
     /**
      * Remove any returns that are not used by any callers
@@ -84,7 +103,17 @@ private:
     /// \returns true if any change
     bool removeReturnsToMatchSignature(UserProc *proc);
 
+private:
+    /// Schedule \p proc as well as all its callers and callees
+    /// for the next call to \ref removeUnusedReturns.
+    void scheduleNeighbours(UserProc *proc);
+
+    /// Schedule \p proc for analysis if it has been decoded
+    void schedule(Function *proc);
+
 private:
     Prog *m_prog;
-    ProcSet m_removeRetSet; ///< UserProcs that need their returns updated
+    ProcSet m_removeRetSet;      ///< UserProcs that need their returns updated
+    ProcSet m_changedProcs;      ///< UserProcs changed by the last call to removeUnusedReturns
+    bool m_allScheduled = false; ///< true if all procs have been scheduled once
 };
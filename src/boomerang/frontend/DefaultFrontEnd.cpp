@@ -22,6 +22,8 @@
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/db/signature/Signature.h"
 #include "boomerang/decomp/IndirectJumpAnalyzer.h"
+#include "boomerang/decomp/ProcScheduler.h"
+#include "boomerang/frontend/LibraryPatternMatcher.h"
 #include "boomerang/frontend/LiftedInstruction.h"
 #include "boomerang/ifc/IDecoder.h"
 #include "boomerang/ssl/RTL.h"
@@ -35,10 +37,19 @@
 #include "boomerang/ssl/type/NamedType.h"
 #include "boomerang/util/log/Log.h"
 
+#include <QFile>
+
+#include <algorithm>
+#include <mutex>
+#include <set>
 #include <stack>
 #include <stdexcept>
 
 
+/// Maximum number of instructions disassembled ahead of time for a single procedure
+static constexpr const std::size_t MAX_PREDISASSEMBLED_INSNS = 65536;
+
+
 DefaultFrontEnd::DefaultFrontEnd(Project *project)
     : IFrontEnd(project)
     , m_binaryFile(project->getLoadedBinaryFile())
@@ -74,6 +85,8 @@ bool DefaultFrontEnd::disassembleEntryPoints()
 
     m_program->getProject()->alertStartDecode(lowAddr, numBytes);
 
+    recognizeLibraryProcs();
+
     bool gotMain;
     const Address mainAddr = findMainEntryPoint(gotMain);
 
@@ -126,9 +139,10 @@ bool DefaultFrontEnd::disassembleEntryPoints()
             LOG_WARN("Unable to find signature for known entrypoint %1", name);
         }
         else {
-            proc->setSignature(fty->getSignature()->clone());
-            proc->getSignature()->setName(name);
-            proc->getSignature()->setForced(true); // Don't add or remove parameters
+            std::shared_ptr<Signature> sig = fty->getSignature()->clone();
+            sig->setName(name);
+            sig->setForced(true); // Don't add or remove parameters
+            proc->setSignature(sig);
         }
 
         break;
@@ -143,9 +157,26 @@ bool DefaultFrontEnd::disassembleAll()
     bool change = true;
     LOG_MSG("Looking for functions to disassemble...");
 
+    m_numPredisassembledHits   = 0;
+    m_numPredisassembledMisses = 0;
+
     while (change) {
         change = false;
 
+        if (m_program->getProject()->getSettings()->decodeChildren) {
+            std::vector<UserProc *> undecodedProcs;
+
+            for (const auto &m : m_program->getModuleList()) {
+                for (Function *function : *m) {
+                    if (!function->isLib() && !static_cast<UserProc *>(function)->isDecoded()) {
+                        undecodedProcs.push_back(static_cast<UserProc *>(function));
+                    }
+                }
+            }
+
+            predisassembleProcs(undecodedProcs);
+        }
+
         for (const auto &m : m_program->getModuleList()) {
             for (Function *function : *m) {
                 if (function->isLib()) {
@@ -159,6 +190,7 @@ bool DefaultFrontEnd::disassembleAll()
 
                 // Not yet disassembled - do it now
                 if (!disassembleProc(userProc, userProc->getEntryAddress())) {
+                    m_predisassembled.clear();
                     return false;
                 }
 
@@ -172,6 +204,10 @@ bool DefaultFrontEnd::disassembleAll()
             }
         }
 
+        // Discard the instructions of this round, including the ones that were not reached
+        // (e.g. after non-returning calls)
+        m_predisassembled.clear();
+
         if (!m_program->getProject()->getSettings()->decodeChildren) {
             break;
         }
@@ -734,8 +770,70 @@ void DefaultFrontEnd::extraProcessCall(IRFragment *)
 }
 
 
+void DefaultFrontEnd::recognizeLibraryProcs()
+{
+    QString patternFileName;
+    switch (m_program->getMachine()) {
+    case Machine::X86: patternFileName = "signatures/patterns/x86.pat"; break;
+    case Machine::PPC: patternFileName = "signatures/patterns/ppc.pat"; break;
+    case Machine::ST20: patternFileName = "signatures/patterns/st20.pat"; break;
+    default: return;
+    }
+
+    const QDir dataDir            = m_program->getProject()->getSettings()->getDataDirectory();
+    const QString patternFilePath = dataDir.absoluteFilePath(patternFileName);
+
+    if (!QFile::exists(patternFilePath)) {
+        return;
+    }
+
+    LibraryPatternMatcher matcher;
+    if (!matcher.readPatternFile(patternFilePath)) {
+        LOG_WARN("Some library patterns could not be read; ignoring them");
+    }
+
+    BinarySymbolTable *symbols = m_program->getBinaryFile()->getSymbols();
+    int numRecognized          = 0;
+
+    for (const auto &[addr, name] : matcher.findAll(m_program->getBinaryFile()->getImage())) {
+        if (m_program->getFunctionByAddr(addr)) {
+            continue; // already known, e.g. from a symbol file
+        }
+
+        BinarySymbol *sym = symbols->findSymbolByAddress(addr);
+
+        if (!sym) {
+            // Do not redirect an imported function with the same name to this address
+            const bool nameExists = symbols->findSymbolByName(name) != nullptr;
+            sym                   = symbols->createSymbol(addr, name, nameExists);
+        }
+
+        LOG_VERBOSE("Recognized statically linked library function '%1' at address %2",
+                    sym->getName(), addr);
+
+        sym->setAttribute("Function", true);
+        sym->setAttribute("StaticFunction", true);
+        numRecognized++;
+    }
+
+    if (numRecognized > 0) {
+        LOG_MSG("Recognized %1 statically linked library functions", numRecognized);
+    }
+}
+
+
 bool DefaultFrontEnd::disassembleInstruction(Address pc, MachineInstruction &insn)
 {
+    auto it = m_predisassembled.find(pc.value());
+    if (it != m_predisassembled.end()) {
+        // Keep the instruction, it might be disassembled again when splitting a BB
+        insn = it->second;
+        m_numPredisassembledHits++;
+        return true;
+    }
+
+    m_numPredisassembledMisses++;
+
     BinaryImage *image = m_program->getBinaryFile()->getImage();
     if (!image || (image->getSectionByAddr(pc) == nullptr)) {
         LOG_ERROR("Attempted to disassemble outside any known section at address %1", pc);
@@ -761,6 +859,129 @@ bool DefaultFrontEnd::disassembleInstruction(Address pc, MachineInstruction &ins
 }
 
 
+void DefaultFrontEnd::predisassembleProcs(const std::vector<UserProc *> &procs)
+{
+    const int numThreads = m_program->getProject()->getSettings()->numThreads;
+    if (numThreads <= 1 || procs.empty() || !m_decoder->supportsConcurrentDisassembly()) {
+        return;
+    }
+
+    const LowLevelCFG *cfg  = m_program->getCFG();
+    const Address textLimit = m_program->getBinaryFile()->getImage()->getLimitTextHigh();
+    std::mutex mutex;
+
+    std::set<Address> visited;
+    std::vector<Address> frontier;
+    for (UserProc *proc : procs) {
+        if (visited.insert(proc->getEntryAddress()).second) {
+            frontier.push_back(proc->getEntryAddress());
+        }
+    }
+
+    int numEntries = 0;
+
+    // Most procedures are only found while decoding their callers, so the destinations of
+    // static calls are disassembled in the next round until no new destinations are found.
+    while (!frontier.empty()) {
+        std::vector<Address> callDests;
+        numEntries += static_cast<int>(frontier.size());
+
+        // Follow fallthrough and static jump edges from each entry point.
+        // Since jumps are not lifted, conditional and unconditional jumps cannot be
+        // distinguished, so this might disassemble a few instructions that are never used.
+        ProcScheduler::forEachIndex(frontier.size(), numThreads, [&](std::size_t entryIdx) {
+            std::unordered_map<Address::value_type, MachineInstruction> insns;
+            std::vector<Address> targets = { frontier[entryIdx] };
+            std::vector<Address> dests;
+
+            while (!targets.empty() && insns.size() < MAX_PREDISASSEMBLED_INSNS) {
+                Address addr = targets.back();
+                targets.pop_back();
+
+                while (insns.size() < MAX_PREDISASSEMBLED_INSNS &&
+                       insns.find(addr.value()) == insns.end()) {
+                    const BasicBlock *existingBB = cfg->getBBStartingAt(addr);
+                    if (existingBB && existingBB->isComplete()) {
+                        break; // already disassembled by a previously decoded procedure
+                    }
+
+                    MachineInstruction insn;
+                    if (!predisassembleInstruction(addr, insn) || insn.m_size == 0) {
+                        break;
+                    }
+
+                    if ((insn.isInGroup(MIGroup::Jump) || insn.isInGroup(MIGroup::Call)) &&
+                        insn.getNumOperands() > 0 && insn.m_operands[0]->isIntConst()) {
+                        const Address dest = insn.m_operands[0]->access<Const>()->getAddr();
+                        if (dest < textLimit) {
+                            if (insn.isInGroup(MIGroup::Call)) {
+                                dests.push_back(dest);
+                            }
+                            else {
+                                targets.push_back(dest);
+                            }
+                        }
+                    }
+
+                    const bool isRet   = insn.isInGroup(MIGroup::Ret);
+                    const Address next = addr + insn.m_size;
+                    insns.emplace(addr.value(), std::move(insn));
+
+                    if (isRet) {
+                        break;
+                    }
+
+                    addr = next;
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(mutex);
+            m_predisassembled.merge(insns);
+            callDests.insert(callDests.end(), dests.begin(), dests.end());
+        });
+
+        // Sort the destinations so the next round does not depend on thread timing
+        std::sort(callDests.begin(), callDests.end());
+        frontier.clear();
+
+        for (Address dest : callDests) {
+            if (!visited.insert(dest).second) {
+                continue;
+            }
+
+            const Function *function = m_program->getFunctionByAddr(dest);
+            if (function && (function->isLib() ||
+                             static_cast<const UserProc *>(function)->isDecoded())) {
+                continue;
+            }
+
+            frontier.push_back(dest);
+        }
+    }
+
+    LOG_VERBOSE("Disassembled %1 instructions of %2 procedures ahead of time",
+                m_predisassembled.size(), numEntries);
+}
+
+
+bool DefaultFrontEnd::predisassembleInstruction(Address pc, MachineInstruction &insn) const
+{
+    const BinarySection *section = m_program->getBinaryFile()->getImage()->getSectionByAddr(pc);
+    if (!section || section->getHostAddr() == HostAddress::INVALID) {
+        return false;
+    }
+
+    const ptrdiff_t hostNativeDiff = (section->getHostAddr() - section->getSourceAddr()).value();
+
+    try {
+        return m_decoder->disassembleInstruction(pc, hostNativeDiff, insn);
+    }
+    catch (std::runtime_error &) {
+        return false;
+    }
+}
+
+
 bool DefaultFrontEnd::liftInstruction(const MachineInstruction &insn, LiftedInstruction &lifted)
 {
     const bool ok = m_decoder->liftInstruction(insn, lifted);
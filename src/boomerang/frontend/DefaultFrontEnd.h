@@ -10,11 +10,13 @@
 #pragma once
 
 
+#include "boomerang/frontend/MachineInstruction.h"
 #include "boomerang/frontend/TargetQueue.h"
 #include "boomerang/ifc/IFrontEnd.h"
 #include "boomerang/ssl/RTL.h"
 
 #include <map>
+#include <unordered_map>
 
 
 class Function;
@@ -91,6 +93,14 @@ public:
     /// \copydoc IFrontEnd::addRefHint
     void addRefHint(Address addr, const QString &name) override;
 
+    /// \returns the number of instructions the last call to \ref disassembleAll
+    /// took from the instructions disassembled ahead of time.
+    int getNumPredisassembledHits() const { return m_numPredisassembledHits; }
+
+    /// \returns the number of instructions the last call to \ref disassembleAll
+    /// had to disassemble because they were not disassembled ahead of time.
+    int getNumPredisassembledMisses() const { return m_numPredisassembledMisses; }
+
 protected:
     /// Do extra processing of call instructions.
     /// Does nothing by default.
@@ -117,10 +127,31 @@ protected:
     virtual bool isHelperFunc(Address dest, Address addr, RTLList &lrtl);
 
 protected:
+    /**
+     * Match the library function patterns for the current machine
+     * (cf. data/signatures/patterns/) against the code sections of the binary file
+     * and mark all matches as statically linked library functions,
+     * so they become LibProcs and are never disassembled.
+     */
+    void recognizeLibraryProcs();
+
     /// Disassemble a single instruction at address \p pc
     /// \returns true on success
     bool disassembleInstruction(Address pc, MachineInstruction &insn);
 
+    /**
+     * Disassemble the instructions reachable from the entry points of \p procs
+     * on multiple threads, without building the CFG. This includes the procedures
+     * called by \p procs (transitively). The instructions are stored and used by
+     * \ref disassembleInstruction instead of disassembling them again.
+     * Does nothing if the decoder does not support concurrent disassembly.
+     */
+    void predisassembleProcs(const std::vector<UserProc *> &procs);
+
+    /// Disassemble a single instruction at address \p pc without logging errors.
+    /// May be called concurrently if the decoder supports concurrent disassembly.
+    bool predisassembleInstruction(Address pc, MachineInstruction &insn) const;
+
     /// Lifts a single instruction \p insn to an RTL.
     /// \returns true on success
     bool liftInstruction(const MachineInstruction &insn, LiftedInstruction &lifted);
@@ -174,6 +205,11 @@ protected:
 
     TargetQueue m_targetQueue; ///< Holds the addresses that still need to be processed
 
+    /// Instructions disassembled by \ref predisassembleProcs in the current round
+    std::unordered_map<Address::value_type, MachineInstruction> m_predisassembled;
+    int m_numPredisassembledHits   = 0;
+    int m_numPredisassembledMisses = 0;
+
     /// Map from address to meaningful name
     std::map<Address, QString> m_refHints;
 
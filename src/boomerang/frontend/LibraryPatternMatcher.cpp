@@ -0,0 +1,242 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LibraryPatternMatcher.h"
+
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QFile>
+#include <QRegularExpression>
+#include <QTextStream>
+
+#include <algorithm>
+
+
+/// Marks wildcard bytes in \ref LibraryPatternMatcher::getOrCreateChild
+static constexpr const int WILDCARD = -1;
+
+
+LibraryPatternMatcher::LibraryPatternMatcher()
+    : m_nodes(1)
+{
+}
+
+
+bool LibraryPatternMatcher::readPatternFile(const QString &filePath)
+{
+    QFile file(filePath);
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        LOG_ERROR("Cannot open library pattern file '%1'", filePath);
+        return false;
+    }
+
+    static const QRegularExpression whitespace("\\s+");
+
+    QTextStream ist(&file);
+    bool ok    = true;
+    int lineNo = 0;
+
+    while (!ist.atEnd()) {
+        lineNo++;
+        const QString line = ist.readLine().section('#', 0, 0).trimmed();
+
+        if (line.isEmpty()) {
+            continue;
+        }
+
+        // The last word of the line is the name, everything before it is the pattern
+        const int nameStart = line.lastIndexOf(whitespace);
+        if (nameStart == -1 ||
+            !addPattern(line.left(nameStart), line.mid(nameStart).trimmed())) {
+            LOG_ERROR("%1:%2: Invalid library pattern", filePath, lineNo);
+            ok = false;
+        }
+    }
+
+    return ok;
+}
+
+
+bool LibraryPatternMatcher::addPattern(const QString &pattern, const QString &name)
+{
+    static const QRegularExpression validPattern("^([0-9A-Fa-f]{2}|\\.\\.)+$");
+
+    QString hex = pattern;
+    hex.remove(QRegularExpression("\\s"));
+
+    if (name.isEmpty() || !validPattern.match(hex).hasMatch()) {
+        return false;
+    }
+
+    std::vector<int> bytes;
+    int numFixedBytes = 0;
+
+    for (int i = 0; i < hex.size(); i += 2) {
+        const QStringRef byteStr = hex.midRef(i, 2);
+
+        if (byteStr == "..") {
+            bytes.push_back(WILDCARD);
+        }
+        else {
+            bytes.push_back(byteStr.toInt(nullptr, 16));
+            numFixedBytes++;
+        }
+    }
+
+    if (numFixedBytes < MIN_FIXED_BYTES) {
+        return false;
+    }
+
+    int nodeIdx = 0;
+    for (int byte : bytes) {
+        nodeIdx = getOrCreateChild(nodeIdx, byte);
+    }
+
+    TrieNode &node = m_nodes[nodeIdx];
+
+    if (node.nameIdx == -1) {
+        node.nameIdx = static_cast<int>(m_names.size());
+        m_names.push_back(name);
+    }
+    else if (node.nameIdx != AMBIGUOUS && m_names[node.nameIdx] != name) {
+        LOG_VERBOSE("Library pattern for '%1' is ambiguous with '%2'", name,
+                    m_names[node.nameIdx]);
+        node.nameIdx = AMBIGUOUS;
+    }
+
+    m_numPatterns++;
+    return true;
+}
+
+
+QString LibraryPatternMatcher::match(const Byte *data, std::size_t size) const
+{
+    std::vector<std::pair<int, std::size_t>> stack;
+    const int nameIdx = matchImpl(data, size, stack);
+
+    return nameIdx >= 0 ? m_names[nameIdx] : QString();
+}
+
+
+std::map<Address, QString> LibraryPatternMatcher::findAll(const BinaryImage *image) const
+{
+    std::map<Address, QString> result;
+    if (m_numPatterns == 0) {
+        return result;
+    }
+
+    std::vector<std::pair<int, std::size_t>> stack;
+
+    for (const BinarySection *section : *image) {
+        if (!section->isCode() || section->getHostAddr().isZero()) {
+            continue;
+        }
+
+        const Byte *data       = static_cast<const Byte *>(section->getHostAddr());
+        const std::size_t size = static_cast<std::size_t>(section->getSize());
+
+        for (std::size_t offset = 0; offset < size; ++offset) {
+            const int nameIdx = matchImpl(data + offset, size - offset, stack);
+
+            if (nameIdx >= 0) {
+                result[section->getSourceAddr() + offset] = m_names[nameIdx];
+            }
+        }
+    }
+
+    return result;
+}
+
+
+int LibraryPatternMatcher::findChild(const TrieNode &node, Byte byte) const
+{
+    auto it = std::lower_bound(
+        node.children.begin(), node.children.end(), byte,
+        [](const std::pair<Byte, int> &child, Byte b) { return child.first < b; });
+
+    return (it != node.children.end() && it->first == byte) ? it->second : -1;
+}
+
+
+int LibraryPatternMatcher::getOrCreateChild(int nodeIdx, int byte)
+{
+    if (byte == WILDCARD) {
+        if (m_nodes[nodeIdx].wildcardChild == -1) {
+            m_nodes[nodeIdx].wildcardChild = static_cast<int>(m_nodes.size());
+            m_nodes.emplace_back();
+        }
+
+        return m_nodes[nodeIdx].wildcardChild;
+    }
+
+    const int existing = findChild(m_nodes[nodeIdx], static_cast<Byte>(byte));
+    if (existing != -1) {
+        return existing;
+    }
+
+    const int newIdx = static_cast<int>(m_nodes.size());
+    m_nodes.emplace_back(); // invalidates references to m_nodes
+
+    std::vector<std::pair<Byte, int>> &children = m_nodes[nodeIdx].children;
+    auto it = std::lower_bound(children.begin(), children.end(), std::make_pair(Byte(byte), -1));
+    children.insert(it, { static_cast<Byte>(byte), newIdx });
+
+    return newIdx;
+}
+
+
+int LibraryPatternMatcher::matchImpl(const Byte *data, std::size_t size,
+                                     std::vector<std::pair<int, std::size_t>> &stack) const
+{
+    int bestName           = -1;
+    std::size_t bestLength = 0;
+    bool bestIsAmbiguous   = false;
+
+    stack.clear();
+    stack.push_back({ 0, 0 });
+
+    while (!stack.empty()) {
+        const auto [nodeIdx, depth] = stack.back();
+        stack.pop_back();
+
+        const TrieNode &node = m_nodes[nodeIdx];
+
+        if (node.nameIdx != -1 && depth >= bestLength) {
+            // Prefer the longest (i.e. most specific) pattern. Patterns of the same length
+            // for different functions are ambiguous.
+            if (depth > bestLength || bestName == -1) {
+                bestName        = node.nameIdx;
+                bestIsAmbiguous = node.nameIdx == AMBIGUOUS;
+            }
+            else if (bestIsAmbiguous || node.nameIdx == AMBIGUOUS ||
+                     m_names[node.nameIdx] != m_names[bestName]) {
+                bestIsAmbiguous = true;
+            }
+
+            bestLength = depth;
+        }
+
+        if (depth >= size) {
+            continue;
+        }
+
+        if (node.wildcardChild != -1) {
+            stack.push_back({ node.wildcardChild, depth + 1 });
+        }
+
+        const int child = findChild(node, data[depth]);
+        if (child != -1) {
+            stack.push_back({ child, depth + 1 });
+        }
+    }
+
+    return bestIsAmbiguous ? -1 : bestName;
+}
@@ -0,0 +1,98 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Address.h"
+#include "boomerang/util/Types.h"
+
+#include <QString>
+
+#include <map>
+#include <utility>
+#include <vector>
+
+
+class BinaryImage;
+
+
+/**
+ * Recognizes statically linked library functions by the bytes at their entry points.
+ *
+ * Patterns are read from pattern files (cf. data/signatures/patterns/).
+ * Each line of a pattern file contains a pattern followed by the name of the function;
+ * '#' starts a comment. A pattern consists of hexadecimal byte values; ".." matches any byte
+ * (e.g. relocated addresses or call displacements). Whitespace inside a pattern is ignored:
+ *
+ *     5589E5 83EC18 897DFC .......... 8575F8    __mingw_frame_init
+ *
+ * All patterns are stored in a single trie with separate edges for wildcard bytes,
+ * so all patterns are matched against an address in a single pass.
+ * If the same pattern is given for different functions, it is ambiguous and never matches.
+ */
+class BOOMERANG_API LibraryPatternMatcher
+{
+public:
+    /// Patterns with fewer non-wildcard bytes are rejected, since they would match too often.
+    static constexpr const int MIN_FIXED_BYTES = 16;
+
+public:
+    LibraryPatternMatcher();
+
+public:
+    /// Read all patterns from the file \p filePath.
+    /// \returns false if the file cannot be read or contains invalid patterns.
+    bool readPatternFile(const QString &filePath);
+
+    /// Add the pattern \p pattern for the function \p name (cf. the class description).
+    /// \returns false if the pattern is invalid.
+    bool addPattern(const QString &pattern, const QString &name);
+
+    int getNumPatterns() const { return m_numPatterns; }
+
+    /**
+     * Match all patterns against the \p size bytes at \p data.
+     * \returns the name of the function with the longest matching pattern,
+     * or an empty string if no pattern matches.
+     */
+    QString match(const Byte *data, std::size_t size) const;
+
+    /// Match all patterns against all addresses in the code sections of \p image.
+    /// \returns the names of the functions found, by address.
+    std::map<Address, QString> findAll(const BinaryImage *image) const;
+
+private:
+    struct TrieNode
+    {
+        std::vector<std::pair<Byte, int>> children; ///< child node by byte, sorted by byte
+        int wildcardChild = -1;
+        int nameIdx       = -1; ///< name of the pattern ending here (or AMBIGUOUS)
+    };
+
+    /// Marks a node where patterns of different functions end
+    static constexpr const int AMBIGUOUS = -2;
+
+    /// \returns the child of \p node for \p byte, or -1 if there is none.
+    int findChild(const TrieNode &node, Byte byte) const;
+
+    /// \returns the index of the child of \p nodeIdx for \p byte (-1 for a wildcard),
+    /// creating it if necessary
+    int getOrCreateChild(int nodeIdx, int byte);
+
+    /// Same as \ref match, but uses \p stack for the trie traversal to avoid allocations
+    int matchImpl(const Byte *data, std::size_t size,
+                  std::vector<std::pair<int, std::size_t>> &stack) const;
+
+private:
+    std::vector<TrieNode> m_nodes; ///< m_nodes[0] is the root
+    std::vector<QString> m_names;
+    int m_numPatterns = 0;
+};
@@ -48,6 +48,7 @@ public:
 
     std::vector<SharedExp> m_operands;
     QString m_templateName; ///< Name of SSL IR template (e.g. REPSTOSB.rm8 or MOVSX.r32.rm8)
+    int m_templateID = -1;  ///< ID of the SSL IR template in the decoder's RTLInstDict, or -1
 
 public:
     /// Enables or disables the membership in a certain group. Does not affect other groups.
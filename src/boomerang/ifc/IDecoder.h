@@ -49,6 +49,12 @@ public:
     [[nodiscard]] virtual bool disassembleInstruction(Address pc, ptrdiff_t delta,
                                                       MachineInstruction &result) = 0;
 
+    /**
+     * \returns true if \ref disassembleInstruction may be called by multiple threads
+     * at the same time. All other methods are never called concurrently.
+     */
+    virtual bool supportsConcurrentDisassembly() const { return false; }
+
     /// Lift a disassembled instruction to an RTL
     /// \returns true if lifting the instruction was succesful.
     [[nodiscard]] virtual bool liftInstruction(const MachineInstruction &insn,
@@ -46,6 +46,9 @@
 
 static PassManager g_passManager;
 
+/// Time spent in passes executed by the pass that is currently profiled on this thread
+static thread_local PassProfiler::Clock::duration g_nestedPassTime(0);
+
 
 PassManager::PassManager()
 {
@@ -108,8 +111,44 @@ bool PassManager::executePass(IPass *pass, UserProc *proc)
     assert(pass != nullptr);
     LOG_VERBOSE("Executing pass '%1' for '%2'", pass->getName(), proc->getName());
 
+    // Statements created since the last pass might not know their proc yet.
+    proc->adoptStatements();
+
+    // Do not measure the time needed for debug output
+    const bool profile = m_profiler.isEnabled();
+    PassProfiler::Event event;
+    uint64 allocsBefore = 0;
+    PassProfiler::Clock::duration outerNestedTime(0);
+
+    if (profile) {
+        event.passID         = pass->getType();
+        event.procName       = proc->getName();
+        event.numStmtsBefore = PassProfiler::getNumStatements(proc);
+        allocsBefore         = PassProfiler::getNumAllocations();
+        outerNestedTime      = g_nestedPassTime;
+        g_nestedPassTime     = PassProfiler::Clock::duration::zero();
+        event.start          = PassProfiler::Clock::now();
+    }
+
     const bool change = pass->execute(proc);
 
+    // The preservation passes only prove equations; all other passes may change statements
+    // that earlier proofs depended on.
+    if (proc->getProg() && pass->getType() != PassID::SPPreservation &&
+        pass->getType() != PassID::PreservationAnalysis) {
+        proc->getProg()->getProofCache().invalidate(proc);
+    }
+
+    if (profile) {
+        event.duration      = PassProfiler::Clock::now() - event.start;
+        event.selfDuration  = event.duration - g_nestedPassTime;
+        g_nestedPassTime    = outerNestedTime + event.duration;
+        event.numAllocs     = PassProfiler::getNumAllocations() - allocsBefore;
+        event.changed       = change;
+        event.numStmtsAfter = PassProfiler::getNumStatements(proc);
+        m_profiler.addEvent(std::move(event));
+    }
+
     if (Log::getOrCreateLog().getLogLevel() >= LogLevel::Verbose1) {
         const QString msg = QString("after executing pass '%1'").arg(pass->getName());
         proc->debugPrintAll(msg);
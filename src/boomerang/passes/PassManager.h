@@ -12,6 +12,7 @@
 
 #include "boomerang/core/BoomerangAPI.h"
 #include "boomerang/passes/Pass.h"
+#include "boomerang/passes/PassProfiler.h"
 
 #include <QMap>
 
@@ -44,9 +45,14 @@ public:
     bool executePass(IPass *pass, UserProc *proc);
     bool executePass(PassID passID, UserProc *proc);
 
+    /// \returns the profiler recording all pass executions (if enabled)
+    PassProfiler *getProfiler() { return &m_profiler; }
+    const PassProfiler *getProfiler() const { return &m_profiler; }
+
 private:
     void registerPass(PassID passType, std::unique_ptr<IPass> pass);
 
 private:
     std::vector<std::unique_ptr<IPass>> m_passes;
+    PassProfiler m_profiler;
 };
@@ -0,0 +1,305 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "PassProfiler.h"
+
+#include "boomerang/db/IRFragment.h"
+#include "boomerang/db/proc/ProcCFG.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QSaveFile>
+
+#include <algorithm>
+#include <cstdlib>
+#include <new>
+
+
+static thread_local uint64 g_numAllocations = 0;
+static std::atomic<uint64> g_totalNumAllocations(0);
+
+
+#if BOOMERANG_ALLOC_PROFILING
+
+void *operator new(std::size_t size)
+{
+    ++g_numAllocations;
+    g_totalNumAllocations.fetch_add(1, std::memory_order_relaxed);
+
+    void *ptr = std::malloc(size != 0 ? size : 1);
+    if (!ptr) {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+
+void *operator new[](std::size_t size)
+{
+    return operator new(size);
+}
+
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete[](void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+
+void operator delete[](void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+#endif
+
+
+void PassProfiler::Stats::add(const Event &event)
+{
+    numExecutions++;
+    numChanged += event.changed ? 1 : 0;
+    numStmtsBefore += event.numStmtsBefore;
+    numStmtsAfter += event.numStmtsAfter;
+    numAllocs += event.numAllocs;
+    totalTime += event.duration;
+    selfTime += event.selfDuration;
+}
+
+
+PassProfiler::PassProfiler()
+    : m_enabled(false)
+    , m_startTime(Clock::now())
+{
+}
+
+
+void PassProfiler::setEnabled(bool enabled)
+{
+    m_enabled = enabled;
+}
+
+
+void PassProfiler::clear()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    m_events.clear();
+    m_threadIndex.clear();
+    m_startTime = Clock::now();
+}
+
+
+void PassProfiler::addEvent(Event event)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    auto it = m_threadIndex.find(std::this_thread::get_id());
+    if (it == m_threadIndex.end()) {
+        const int idx = static_cast<int>(m_threadIndex.size());
+        it            = m_threadIndex.insert({ std::this_thread::get_id(), idx }).first;
+    }
+
+    event.threadIdx = it->second;
+    m_events.push_back(std::move(event));
+}
+
+
+std::vector<PassProfiler::Event> PassProfiler::getEvents() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_events;
+}
+
+
+PassProfiler::Stats PassProfiler::getPassStats(PassID passID) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    Stats stats;
+    for (const Event &event : m_events) {
+        if (event.passID == passID) {
+            stats.add(event);
+        }
+    }
+
+    return stats;
+}
+
+
+static QJsonObject statsToJson(const PassProfiler::Stats &stats)
+{
+    QJsonObject obj;
+    obj["executions"]   = stats.numExecutions;
+    obj["changed"]      = stats.numChanged;
+    obj["changedRatio"] = stats.numExecutions > 0
+                              ? static_cast<double>(stats.numChanged) / stats.numExecutions
+                              : 0.0;
+    obj["stmtsBefore"]  = static_cast<double>(stats.numStmtsBefore);
+    obj["stmtsAfter"]   = static_cast<double>(stats.numStmtsAfter);
+    obj["allocations"]  = static_cast<double>(stats.numAllocs);
+    obj["timeMs"]       = std::chrono::duration<double, std::milli>(stats.totalTime).count();
+    obj["selfTimeMs"]   = std::chrono::duration<double, std::milli>(stats.selfTime).count();
+    return obj;
+}
+
+
+static bool writeJsonFile(const QString &filePath, const QJsonObject &obj)
+{
+    QSaveFile file(filePath);
+    if (!file.open(QFile::WriteOnly)) {
+        LOG_ERROR("Cannot write pass profile: Opening '%1' failed", filePath);
+        return false;
+    }
+
+    file.write(QJsonDocument(obj).toJson(QJsonDocument::Indented));
+    return file.commit();
+}
+
+
+bool PassProfiler::writeSummary(const QString &filePath) const
+{
+    const std::vector<Event> events = getEvents();
+
+    std::map<PassID, Stats> passStats;
+    std::map<PassID, std::map<QString, Stats>> procStats;
+    Clock::duration totalTime = Clock::duration::zero();
+
+    for (const Event &event : events) {
+        passStats[event.passID].add(event);
+        procStats[event.passID][event.procName].add(event);
+
+        // Nested passes are already contained in the duration of the outer pass
+        totalTime += event.selfDuration;
+    }
+
+    // sort passes by self time, most expensive first
+    std::vector<PassID> passes;
+    for (const auto &[passID, stats] : passStats) {
+        Q_UNUSED(stats);
+        passes.push_back(passID);
+    }
+
+    std::stable_sort(passes.begin(), passes.end(), [&passStats](PassID lhs, PassID rhs) {
+        return passStats[lhs].selfTime > passStats[rhs].selfTime;
+    });
+
+    QJsonArray passArray;
+    for (PassID passID : passes) {
+        IPass *pass     = PassManager::get()->getPass(passID);
+        QJsonObject obj = statsToJson(passStats[passID]);
+        obj["pass"]     = pass ? pass->getName() : QString::number(static_cast<int>(passID));
+
+        QJsonObject procs;
+        for (const auto &[procName, stats] : procStats[passID]) {
+            procs[procName] = statsToJson(stats);
+        }
+
+        obj["procs"] = procs;
+        passArray.append(obj);
+    }
+
+    QJsonObject root;
+    root["totalTimeMs"] = std::chrono::duration<double, std::milli>(totalTime).count();
+    root["passes"]      = passArray;
+
+    return writeJsonFile(filePath, root);
+}
+
+
+bool PassProfiler::writeTrace(const QString &filePath) const
+{
+    std::vector<Event> events;
+    Clock::time_point startTime;
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        events    = m_events;
+        startTime = m_startTime;
+    }
+
+    QJsonArray traceEvents;
+    for (const Event &event : events) {
+        IPass *pass = PassManager::get()->getPass(event.passID);
+
+        QJsonObject args;
+        args["proc"]        = event.procName;
+        args["changed"]     = event.changed;
+        args["stmtsBefore"] = event.numStmtsBefore;
+        args["stmtsAfter"]  = event.numStmtsAfter;
+        args["allocations"] = static_cast<double>(event.numAllocs);
+
+        // Timestamps are in microseconds.
+        QJsonObject obj;
+        obj["name"] = pass ? pass->getName() : QString::number(static_cast<int>(event.passID));
+        obj["cat"]  = "pass";
+        obj["ph"]   = "X";
+        obj["ts"]   = std::chrono::duration<double, std::micro>(event.start - startTime).count();
+        obj["dur"]  = std::chrono::duration<double, std::micro>(event.duration).count();
+        obj["pid"]  = 1;
+        obj["tid"]  = event.threadIdx;
+        obj["args"] = args;
+
+        traceEvents.append(obj);
+    }
+
+    QJsonObject root;
+    root["traceEvents"]     = traceEvents;
+    root["displayTimeUnit"] = "ms";
+
+    return writeJsonFile(filePath, root);
+}
+
+
+uint64 PassProfiler::getNumAllocations()
+{
+    return g_numAllocations;
+}
+
+
+uint64 PassProfiler::getTotalNumAllocations()
+{
+    return g_totalNumAllocations.load(std::memory_order_relaxed);
+}
+
+
+int PassProfiler::getNumStatements(const UserProc *proc)
+{
+    int numStmts = 0;
+
+    for (const IRFragment *frag : *proc->getCFG()) {
+        if (!frag->getRTLs()) {
+            continue;
+        }
+
+        for (const auto &rtl : *frag->getRTLs()) {
+            numStmts += static_cast<int>(rtl->size());
+        }
+    }
+
+    return numStmts;
+}
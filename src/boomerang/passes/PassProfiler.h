@@ -0,0 +1,125 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/passes/Pass.h"
+#include "boomerang/util/Types.h"
+
+#include <QString>
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/**
+ * Records how much time and memory passes take for each UserProc.
+ *
+ * When enabled, the PassManager reports every pass execution to the profiler.
+ * The profile can be written as a JSON summary (aggregated per pass and per procedure)
+ * and as a trace file in the Chrome trace event format, which can be viewed
+ * with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * Heap allocations are only counted if Boomerang was built with
+ * BOOMERANG_ENABLE_ALLOC_PROFILING, since this requires replacing the global operator new.
+ * Otherwise, the number of allocations is always 0.
+ *
+ * All methods are thread safe.
+ */
+class BOOMERANG_API PassProfiler
+{
+public:
+    typedef std::chrono::steady_clock Clock;
+
+    /// A single execution of a pass
+    struct Event
+    {
+        PassID passID = PassID::INVALID;
+        QString procName;
+        Clock::time_point start;
+        Clock::duration duration     = Clock::duration::zero(); ///< including nested passes
+        Clock::duration selfDuration = Clock::duration::zero(); ///< excluding nested passes
+        bool changed                 = false;
+        int numStmtsBefore           = 0;
+        int numStmtsAfter            = 0;
+        uint64 numAllocs             = 0;  ///< including nested passes
+        int threadIdx                = -1; ///< set by addEvent
+    };
+
+    /// Accumulated statistics of all executions of a pass (for one procedure or all procedures)
+    struct Stats
+    {
+        int numExecutions         = 0;
+        int numChanged            = 0;
+        uint64 numStmtsBefore     = 0;
+        uint64 numStmtsAfter      = 0;
+        uint64 numAllocs          = 0;
+        Clock::duration totalTime = Clock::duration::zero(); ///< including nested passes
+        Clock::duration selfTime  = Clock::duration::zero(); ///< excluding nested passes
+
+        void add(const Event &event);
+    };
+
+public:
+    PassProfiler();
+
+public:
+    bool isEnabled() const { return m_enabled; }
+
+    /// Start or stop recording. Does not discard previously recorded events.
+    void setEnabled(bool enabled);
+
+    /// Discard all recorded events.
+    void clear();
+
+    /// Record an execution of a pass.
+    void addEvent(Event event);
+
+    /// \returns a copy of all recorded events, in the order they were recorded.
+    std::vector<Event> getEvents() const;
+
+    /// \returns the statistics of all executions of \p passID, summed over all procedures.
+    Stats getPassStats(PassID passID) const;
+
+    /**
+     * Write a summary of all recorded events to \p filePath in JSON format.
+     * \returns true on success.
+     */
+    bool writeSummary(const QString &filePath) const;
+
+    /**
+     * Write all recorded events to \p filePath in the Chrome trace event format.
+     * \returns true on success.
+     */
+    bool writeTrace(const QString &filePath) const;
+
+public:
+    /// \returns the number of heap allocations performed by the current thread so far.
+    static uint64 getNumAllocations();
+
+    /// \returns the number of heap allocations performed by all threads so far.
+    static uint64 getTotalNumAllocations();
+
+    /// \returns the number of statements in \p proc
+    static int getNumStatements(const UserProc *proc);
+
+private:
+    std::atomic<bool> m_enabled;
+    Clock::time_point m_startTime;
+
+    mutable std::mutex m_mutex;
+    std::vector<Event> m_events;
+    std::map<std::thread::id, int> m_threadIndex;
+};
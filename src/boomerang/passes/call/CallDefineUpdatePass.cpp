@@ -29,12 +29,9 @@ CallDefineUpdatePass::CallDefineUpdatePass()
 
 bool CallDefineUpdatePass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
-
     bool changed = false;
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : proc->getStatementRange()) {
         if (!s->isCall()) {
             continue;
         }
@@ -149,15 +149,9 @@ bool BlockVarRenamePass::renameBlockVars(UserProc *proc, std::size_t n)
         }
     }
 
-    // For each child X of n
-    // Note: linear search!
-    const std::size_t numFrags = proc->getCFG()->getNumFragments();
-
-    for (FragIndex X = 0; X < numFrags; ++X) {
-        const FragIndex idom = proc->getDataFlow()->getIdom(X);
-        if (idom == n && X != n) { // if 'n' is immediate dominator of X
-            renameBlockVars(proc, X);
-        }
+    // For each child X of n in the dominator tree
+    for (FragIndex X : proc->getDataFlow()->getDomChildren(n)) {
+        renameBlockVars(proc, X);
     }
 
     // NOTE: Because of the need to pop childless calls from the Stacks, it is important in my
@@ -11,14 +11,22 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/DefUseChains.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/passes/PassManager.h"
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/statements/PhiAssign.h"
 #include "boomerang/util/log/Log.h"
-#include "boomerang/visitor/expvisitor/ExpDestCounter.h"
-#include "boomerang/visitor/stmtexpvisitor/StmtDestCounter.h"
+
+#include <numeric>
+#include <set>
+
+
+/// Maximum number of propagation rounds in one execution of the pass.
+/// Propagation never goes through phis, so the def-use chains that are followed are acyclic
+/// and the fixpoint is normally reached after a few rounds.
+static constexpr const int MAX_ROUNDS = 100;
 
 
 StatementPropagationPass::StatementPropagationPass()
@@ -29,35 +37,70 @@ StatementPropagationPass::StatementPropagationPass()
 
 bool StatementPropagationPass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    std::vector<SharedStmt> stmts;
+    proc->getStatementSnapshot(stmts);
 
-    // count the number of times each assignment LHS would be propagated somewhere
-    std::map<SharedExp, int, lessExpStar> destCounts;
-
-    // Also maintain a set of locations which are used by phi statements
-    for (SharedStmt s : stmts) {
-        ExpDestCounter edc(destCounts);
-        StmtDestCounter sdc(&edc);
-        s->accept(&sdc);
-    }
+    // count the number of times each assignment LHS would be propagated somewhere,
+    // and remember which statements use each definition
+    DefUseChains chains(stmts);
 
-    // A fourth pass to propagate only the flags
+    // First propagate only the flags
     // (these must be propagated even if it results in extra locals)
     bool change = false;
+    std::set<std::size_t> changed;
 
-    for (SharedStmt s : stmts) {
-        if (!s->isPhi()) {
-            change |= s->propagateFlagsToThis();
+    for (std::size_t i = 0; i < stmts.size(); ++i) {
+        if (!stmts[i]->isPhi() && stmts[i]->propagateFlagsToThis()) {
+            changed.insert(i);
         }
     }
 
-    // Finally the actual propagation
+    // Then the actual propagation, in rounds. The first round visits all statements in order.
+    // Later rounds visit only the statements that another sweep over all statements could
+    // change: the users of statements changed in the previous round, and the users of
+    // definitions whose use counts have changed. The chains are updated only between rounds,
+    // so all statements of a round see the same use counts, as in a single sweep.
     const int propMaxDepth = proc->getProg()->getProject()->getSettings()->propMaxDepth;
-    for (SharedStmt s : stmts) {
-        if (!s->isPhi()) {
-            change |= s->propagateToThis(propMaxDepth, &destCounts);
+
+    std::vector<std::size_t> toVisit(stmts.size());
+    std::iota(toVisit.begin(), toVisit.end(), 0);
+
+    for (int round = 0; !toVisit.empty(); ++round) {
+        if (round == MAX_ROUNDS) {
+            LOG_WARN("Stopping statement propagation for '%1' after %2 rounds; "
+                     "%3 statements were not visited again",
+                     proc->getName(), MAX_ROUNDS, toVisit.size());
+            break;
+        }
+
+        for (const std::size_t i : toVisit) {
+            const SharedStmt &s = stmts[i];
+
+            if (!s->isPhi() && s->propagateToThis(propMaxDepth, &chains.getDestCounts())) {
+                changed.insert(i);
+            }
         }
+
+        std::set<std::size_t> next;
+
+        for (const std::size_t i : changed) {
+            // The use counts of all definitions used by i before or after the change
+            // may have changed.
+            std::set<std::size_t> defs;
+            chains.getUsedDefs(i, defs);
+            chains.updateUses(i);
+            chains.getUsedDefs(i, defs);
+
+            next.insert(chains.getUsers(i).begin(), chains.getUsers(i).end());
+
+            for (const std::size_t def : defs) {
+                next.insert(chains.getUsers(def).begin(), chains.getUsers(def).end());
+            }
+        }
+
+        change |= !changed.empty();
+        changed.clear();
+        toVisit.assign(next.begin(), next.end());
     }
 
     PassManager::get()->executePass(PassID::FragSimplify, proc);
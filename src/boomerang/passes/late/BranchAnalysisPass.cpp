@@ -157,10 +157,7 @@ bool BranchAnalysisPass::doBranchAnalysis(UserProc *proc)
 
 void BranchAnalysisPass::fixUglyBranches(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
-
-    for (auto stmt : stmts) {
+    for (const SharedStmt &stmt : proc->getStatementRange()) {
         if (!stmt->isBranch()) {
             continue;
         }
@@ -39,8 +39,8 @@ bool FromSSAFormPass::execute(UserProc *proc)
 {
     proc->getProg()->getProject()->alertDecompiling(proc);
 
-    StatementList stmts;
-    proc->getStatements(stmts);
+    std::vector<SharedStmt> stmts;
+    proc->getStatementSnapshot(stmts);
 
     for (SharedStmt s : stmts) {
         // Map registers to initial local variables
@@ -260,10 +260,7 @@ bool FromSSAFormPass::execute(UserProc *proc)
 
 void FromSSAFormPass::nameParameterPhis(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
-
-    for (SharedStmt insn : stmts) {
+    for (const SharedStmt &insn : proc->getStatementRange()) {
         if (!insn->isPhi()) {
             continue; // Might be able to optimise this a bit
         }
@@ -374,10 +371,7 @@ void FromSSAFormPass::removeSubscriptsFromParameters(UserProc *proc)
 
 void FromSSAFormPass::findPhiUnites(UserProc *proc, ConnectionGraph &pu)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
-
-    for (SharedStmt stmt : stmts) {
+    for (const SharedStmt &stmt : proc->getStatementRange()) {
         if (!stmt->isPhi()) {
             continue;
         }
@@ -419,8 +413,8 @@ void FromSSAFormPass::mapRegistersToLocals(const SharedStmt &stmt)
 
 void FromSSAFormPass::removePhis(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    std::vector<SharedStmt> stmts;
+    proc->getStatementSnapshot(stmts);
 
     for (SharedStmt s : stmts) {
         if (!s->isPhi()) {
@@ -23,8 +23,8 @@ ImplicitPlacementPass::ImplicitPlacementPass()
 
 bool ImplicitPlacementPass::execute(UserProc *proc)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
+    std::vector<SharedStmt> stmts;
+    proc->getStatementSnapshot(stmts);
     ImplicitConverter ic(proc->getCFG());
     StmtImplicitConverter sm(&ic, proc->getCFG());
 
@@ -27,10 +27,7 @@ bool LocalAndParamMapPass::execute(UserProc *proc)
 {
     LOG_VERBOSE("### Mapping expressions to local variables for %1 ###", proc->getName());
 
-    StatementList stmts;
-    proc->getStatements(stmts);
-
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : proc->getStatementRange()) {
         DfaLocalMapper dlm(proc);
         StmtModifier sm(&dlm, true); // True to ignore def collector in return statement
 
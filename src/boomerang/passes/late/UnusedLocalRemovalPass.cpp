@@ -33,8 +33,8 @@ UnusedLocalRemovalPass::UnusedLocalRemovalPass()
 bool UnusedLocalRemovalPass::execute(UserProc *proc)
 {
     QSet<QString> usedLocals;
-    StatementList stmts;
-    proc->getStatements(stmts);
+    std::vector<SharedStmt> stmts;
+    proc->getStatementSnapshot(stmts);
 
     // First count any uses of the locals
     bool all = false;
@@ -47,10 +47,7 @@ bool UnusedStatementRemovalPass::execute(UserProc *proc)
 
 void UnusedStatementRemovalPass::updateRefCounts(UserProc *proc, RefCounter &refCounts)
 {
-    StatementList stmts;
-    proc->getStatements(stmts);
-
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : proc->getStatementRange()) {
         // Don't count uses in implicit statements. There is no RHS of course,
         // but you can still have x from m[x] on the LHS and so on, but these are not real uses
         if (s->isImplicit()) {
@@ -193,8 +190,8 @@ void UnusedStatementRemovalPass::remUnusedStmtEtc(UserProc *proc, RefCounter &re
 bool UnusedStatementRemovalPass::removeNullStatements(UserProc *proc)
 {
     bool change = false;
-    StatementList stmts;
-    proc->getStatements(stmts);
+    std::vector<SharedStmt> stmts;
+    proc->getStatementSnapshot(stmts);
 
     // remove null code
     for (SharedStmt s : stmts) {
@@ -46,8 +46,8 @@ bool AssignRemovalPass::removeSpAssigns(UserProc *proc)
     SharedExp sp  = Location::regOf(Util::getStackRegisterIndex(proc->getProg()));
     bool foundone = false;
 
-    StatementList stmts;
-    proc->getStatements(stmts);
+    std::vector<SharedStmt> stmts;
+    proc->getStatementSnapshot(stmts);
 
     for (SharedStmt stmt : stmts) {
         if (stmt->isAssign() && (*stmt->as<Assign>()->getLeft() == *sp)) {
@@ -99,8 +99,8 @@ bool AssignRemovalPass::removeMatchingAssigns(UserProc *proc, SharedExp e)
 
     bool foundone = false;
 
-    StatementList stmts;
-    proc->getStatements(stmts);
+    std::vector<SharedStmt> stmts;
+    proc->getStatementSnapshot(stmts);
 
     for (auto stmt : stmts) {
         if (stmt->isAssign() && (*stmt->as<Assign>()->getLeft() == *e)) {
@@ -55,8 +55,8 @@ bool CallAndPhiFixPass::execute(UserProc *proc)
      * statement) do bypass and propagation for s
      */
     std::map<SharedExp, int, lessExpStar> destCounts;
-    StatementList stmts;
-    proc->getStatements(stmts);
+    std::vector<SharedStmt> stmts;
+    proc->getStatementSnapshot(stmts);
 
     // a[m[]] hack, aint nothing better.
     bool found = true;
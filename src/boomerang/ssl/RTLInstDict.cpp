@@ -22,6 +22,7 @@
 #include "boomerang/ssl/statements/GotoStatement.h"
 #include "boomerang/ssl/type/FloatType.h"
 #include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/util/Util.h"
 #include "boomerang/util/log/Log.h"
 
 
@@ -43,12 +44,14 @@ int RTLInstDict::insert(const QString &name, std::list<QString> &params, const R
 
     opcode.remove(".");
 
-    if (m_instructions.find({ opcode, params.size() }) == m_instructions.end()) {
+    auto it = m_instructions.find({ opcode, params.size() });
+    if (it == m_instructions.end()) {
         std::pair<QString, int> key{ opcode, params.size() };
-        m_instructions.emplace(key, TableEntry(params, rtl));
+        m_instructions.emplace(key, static_cast<int>(m_templates.size()));
+        m_templates.emplace_back(params, rtl);
     }
     else {
-        return m_instructions[{ opcode, params.size() }].appendRTL(params, rtl);
+        return m_templates[it->second].appendRTL(params, rtl);
     }
 
     return 0;
@@ -60,6 +63,7 @@ bool RTLInstDict::readSSLFile(const QString &sslFileName)
     LOG_MSG("Loading machine specifications from '%1'...", sslFileName);
     // emptying the rtl dictionary
     m_instructions.clear();
+    m_templates.clear();
 
     // Clear all state
     reset();
@@ -70,6 +74,10 @@ bool RTLInstDict::readSSLFile(const QString &sslFileName)
         return false;
     }
 
+    for (TableEntry &entry : m_templates) {
+        entry.compile();
+    }
+
     if (m_verboseOutput) {
         QString s;
         OStream os(&s);
@@ -93,7 +101,7 @@ void RTLInstDict::print(OStream &os /*= std::cout*/)
         os << (elem).first.first << "  ";
 
         // print the parameters
-        const std::list<QString> &params((elem).second.m_params);
+        const std::list<QString> &params(m_templates[elem.second].m_params);
         int i = params.size();
 
         for (auto s = params.begin(); s != params.end(); ++s, i--) {
@@ -103,7 +111,7 @@ void RTLInstDict::print(OStream &os /*= std::cout*/)
         os << "\n";
 
         // print the RTL
-        RTL &rtlist = (elem).second.m_rtl;
+        RTL &rtlist = m_templates[elem.second].m_rtl;
         rtlist.print(os);
         os << "\n";
     }
@@ -113,48 +121,54 @@ void RTLInstDict::print(OStream &os /*= std::cout*/)
 std::unique_ptr<RTL> RTLInstDict::instantiateRTL(const QString &name, Address natPC,
                                                  const std::vector<SharedExp> &args)
 {
-    // TODO try to retrieve fast instruction mappings
-    // before trying the verbose instructions
-    auto dict_entry = m_instructions.find({ name, args.size() });
-    if (dict_entry == m_instructions.end()) {
+    const int templateID = getTemplateID(name, args.size());
+    if (templateID == -1) {
         LOG_ERROR("Cannot instantiate instruction '%1' at address %2: "
                   "No instruction template takes %3 arguments",
                   name, natPC, args.size());
         return nullptr; // instruction not found
     }
 
-    TableEntry &entry(dict_entry->second);
-    return instantiateRTL(entry.m_rtl, natPC, entry.m_params, args);
+    return instantiateRTL(templateID, natPC, args);
+}
+
+
+int RTLInstDict::getTemplateID(const QString &name, int numParams) const
+{
+    auto it = m_instructions.find({ name, numParams });
+    return (it != m_instructions.end()) ? it->second : -1;
 }
 
 
-std::unique_ptr<RTL> RTLInstDict::instantiateRTL(const RTL &existingRTL, Address natPC,
-                                                 const std::list<QString> &params,
+std::unique_ptr<RTL> RTLInstDict::instantiateRTL(int templateID, Address natPC,
                                                  const std::vector<SharedExp> &args)
 {
-    assert(params.size() == args.size());
+    assert(Util::inRange(templateID, 0, static_cast<int>(m_templates.size())));
+
+    const TableEntry &entry = m_templates[templateID];
+    assert(entry.m_params.size() == args.size());
+    assert(entry.m_usedParams.size() == entry.m_rtl.size());
 
     // Get a deep copy of the template RTL
-    std::unique_ptr<RTL> newList(new RTL(existingRTL));
+    std::unique_ptr<RTL> newList(new RTL(entry.m_rtl));
     newList->setAddress(natPC);
 
-    // Iterate through each Statement of the new list of stmts
+    // Replace the formals used by each statement with the actual arguments
+    std::size_t stmtIdx = 0;
     for (SharedStmt ss : *newList) {
-        // Search for the formals and replace them with the actual arguments
-        auto arg = args.begin();
-
-        for (QString paramName : params) {
-            /* Simple parameter - just construct the formal to search for */
-            Location param(opParam, Const::get(paramName), nullptr);
-            ss->searchAndReplace(param, *arg);
-            ++arg;
+        for (int paramIdx : entry.m_usedParams[stmtIdx]) {
+            ss->searchAndReplace(*entry.m_paramPatterns[paramIdx], args[paramIdx]);
+        }
+
+        if (entry.m_hasSuccessor[stmtIdx]) {
+            fixSuccessorForStmt(ss);
         }
-        assert(arg == args.end());
-        fixSuccessorForStmt(ss);
 
         if (m_verboseOutput) {
             LOG_MSG("            %1", ss);
         }
+
+        ++stmtIdx;
     }
 
     // Perform simplifications, e.g. *1 in x86 addressing modes
@@ -215,6 +229,7 @@ void RTLInstDict::reset()
     m_definedParams.clear();
     m_flagFuncs.clear();
     m_instructions.clear();
+    m_templates.clear();
 }
 
 
@@ -71,6 +71,20 @@ public:
     std::unique_ptr<RTL> instantiateRTL(const QString &name, Address pc,
                                         const std::vector<SharedExp> &args);
 
+    /**
+     * Same as above, but the instruction template is given by its ID.
+     * \sa getTemplateID
+     */
+    std::unique_ptr<RTL> instantiateRTL(int templateID, Address pc,
+                                        const std::vector<SharedExp> &args);
+
+    /**
+     * \returns the ID of the instruction template with name \p name taking \p numParams
+     * parameters, or -1 if there is no such template.
+     * Template IDs stay valid until the next call to \ref readSSLFile.
+     */
+    int getTemplateID(const QString &name, int numParams) const;
+
     RegDB *getRegDB();
     const RegDB *getRegDB() const;
 
@@ -78,20 +92,6 @@ private:
     /// Reset the object to "undo" a readSSLFile()
     void reset();
 
-    /**
-     * Returns an instance of a register transfer list for the parameterized rtlist with the given
-     * formals replaced with the arguments given as the third parameter.
-     *
-     * \param   rtls    a register transfer list
-     * \param   pc      address at which the named instruction is located
-     * \param   params  a list of formal parameters
-     * \param   args    the actual parameter values
-     * \returns the instantiated list of Exps
-     */
-    std::unique_ptr<RTL> instantiateRTL(const RTL &rtls, Address pc,
-                                        const std::list<QString> &params,
-                                        const std::vector<SharedExp> &args);
-
     /**
      * Appends one RTL to the dictionary, or adds it to idict if an
      * entry does not already exist.
@@ -125,6 +125,9 @@ private:
     /// All names of defined flag functions
     std::set<QString> m_flagFuncs;
 
-    /// The actual instruction dictionary.
-    std::map<std::pair<QString, int>, TableEntry> m_instructions;
+    /// Maps (instruction name, number of parameters) to the ID of the instruction template.
+    std::map<std::pair<QString, int>, int> m_instructions;
+
+    /// The actual instruction templates, indexed by template ID.
+    std::vector<TableEntry> m_templates;
 };
@@ -9,6 +9,11 @@
 #pragma endregion License
 #include "TableEntry.h"
 
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/statements/Assign.h"
+
 
 TableEntry::TableEntry()
     : m_rtl(Address::INVALID)
@@ -32,3 +37,41 @@ int TableEntry::appendRTL(const std::list<QString> &params, const RTL &rtl)
     m_rtl.append(rtl.getStatements());
     return 0;
 }
+
+
+void TableEntry::compile()
+{
+    m_paramPatterns.clear();
+    m_usedParams.clear();
+    m_hasSuccessor.clear();
+
+    for (const QString &paramName : m_params) {
+        m_paramPatterns.push_back(Location::get(opParam, Const::get(paramName), nullptr));
+    }
+
+    const Unary successor(opSuccessor, Terminal::get(opWild));
+
+    for (const SharedStmt &stmt : m_rtl) {
+        // Replace in a copy of the statement, so that the parameters found here are exactly
+        // the parameters that are replaced when the RTL is instantiated.
+        SharedStmt copy = stmt->clone();
+        std::vector<int> usedParams;
+
+        for (int i = 0; i < static_cast<int>(m_paramPatterns.size()); ++i) {
+            if (copy->searchAndReplace(*m_paramPatterns[i], Terminal::get(opWild))) {
+                usedParams.push_back(i);
+            }
+        }
+
+        bool hasSuccessor = false;
+        if (stmt->isAssign()) {
+            SharedExp result;
+            std::shared_ptr<Assign> asgn = stmt->as<Assign>();
+            hasSuccessor = asgn->getLeft()->search(successor, result) ||
+                           asgn->getRight()->search(successor, result);
+        }
+
+        m_usedParams.push_back(usedParams);
+        m_hasSuccessor.push_back(hasSuccessor);
+    }
+}
@@ -12,9 +12,13 @@
 
 #include "boomerang/ssl/RTL.h"
 
+#include <vector>
+
 
 /**
  * The TableEntry class represents a single instruction - a string/RTL pair.
+ * After all statements have been added, \ref compile must be called
+ * to precompute the data needed to instantiate the RTL quickly.
  */
 class BOOMERANG_API TableEntry
 {
@@ -34,7 +38,19 @@ public:
      */
     int appendRTL(const std::list<QString> &params, const RTL &rtl);
 
+    /// Precompute the parameter search patterns and the parameters used by each statement.
+    void compile();
+
 public:
     std::list<QString> m_params;
     RTL m_rtl;
+
+    /// Search pattern (i.e. opParam) for each parameter, in the same order as m_params.
+    std::vector<SharedExp> m_paramPatterns;
+
+    /// For each statement of m_rtl, the indices of the parameters used by the statement.
+    std::vector<std::vector<int>> m_usedParams;
+
+    /// For each statement of m_rtl, whether it is an assignment that uses opSuccessor.
+    std::vector<bool> m_hasSuccessor;
 };
@@ -19,6 +19,7 @@
 #include "boomerang/ssl/type/PointerType.h"
 #include "boomerang/ssl/type/SizeType.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/NodePool.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
@@ -51,7 +52,7 @@ Binary::~Binary()
 
 std::shared_ptr<Binary> Binary::get(OPER op, SharedExp e1, SharedExp e2)
 {
-    return std::make_shared<Binary>(op, e1, e2);
+    return makeNode<Binary>(op, e1, e2);
 }
 
 
@@ -86,7 +87,7 @@ void Binary::commute()
 SharedExp Binary::clone() const
 {
     assert(m_subExp1 && m_subExp2);
-    return std::make_shared<Binary>(m_oper, m_subExp1->clone(), m_subExp2->clone());
+    return makeNode<Binary>(m_oper, m_subExp1->clone(), m_subExp2->clone());
 }
 
 
@@ -94,6 +95,10 @@ bool Binary::operator==(const Exp &o) const
 {
     assert(m_subExp1 && m_subExp2);
 
+    if (this == &o) {
+        return true; // shared subexpression
+    }
+
     if (o.getOper() == opWild) {
         return true;
     }
@@ -118,6 +123,10 @@ bool Binary::operator<(const Exp &o) const
 {
     assert(m_subExp1 && m_subExp2);
 
+    if (this == &o) {
+        return false;
+    }
+
     if (m_oper < o.getOper()) {
         return true;
     }
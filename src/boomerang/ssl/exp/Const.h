@@ -12,6 +12,7 @@
 
 #include "boomerang/ssl/exp/Exp.h"
 #include "boomerang/util/Address.h"
+#include "boomerang/util/NodePool.h"
 
 #include <variant>
 
@@ -23,6 +24,18 @@ class Function;
 /// string, or address constant.
 class BOOMERANG_API Const : public Exp
 {
+public:
+    /// The kind of value held by a constant, in the same order as the alternatives of \ref Data
+    enum class ValueKind : uint8_t
+    {
+        Int = 0, ///< int
+        Long,    ///< QWord
+        Flt,     ///< double
+        Func,    ///< Function *
+        Str,     ///< QString
+        RawStr   ///< const char *
+    };
+
 private:
     typedef std::variant<int,         ///< Integer
                          QWord,       ///< 64 bit integer / address / pointer
@@ -62,13 +75,13 @@ public:
     template<class T>
     static std::shared_ptr<Const> get(T i)
     {
-        return std::make_shared<Const>(i);
+        return makeNode<Const>(i);
     }
 
     template<class T>
     static std::shared_ptr<Const> get(T i, SharedType ty)
     {
-        std::shared_ptr<Const> c = std::make_shared<Const>(i);
+        std::shared_ptr<Const> c = makeNode<Const>(i);
         c->setType(ty);
         return c;
     }
@@ -82,6 +95,9 @@ public:
     /// \copydoc Exp::equalNoSubscript
     bool equalNoSubscript(const Exp &o) const override;
 
+    /// \returns the kind of value held by this constant
+    ValueKind getValueKind() const { return static_cast<ValueKind>(m_value.index()); }
+
     // Get the constant
     int getInt() const;
     QWord getLong() const;
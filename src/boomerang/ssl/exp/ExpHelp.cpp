@@ -17,5 +17,9 @@
 // A helper class for comparing Exp*'s sensibly
 bool lessExpStar::operator()(const SharedConstExp &left, const SharedConstExp &right) const
 {
+    if (left == right) {
+        return false; // same expression
+    }
+
     return (*left < *right); // Compare the actual Exps
 }
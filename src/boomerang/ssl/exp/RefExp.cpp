@@ -11,6 +11,7 @@
 
 #include "boomerang/ssl/statements/Statement.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/NodePool.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
@@ -26,7 +27,7 @@ RefExp::RefExp(SharedExp e, const SharedStmt &d)
 
 std::shared_ptr<RefExp> RefExp::get(SharedExp e, const SharedStmt &def)
 {
-    return std::make_shared<RefExp>(e, def);
+    return makeNode<RefExp>(e, def);
 }
 
 
@@ -38,6 +39,10 @@ SharedExp RefExp::clone() const
 
 bool RefExp::operator==(const Exp &o) const
 {
+    if (this == &o) {
+        return true; // shared subexpression
+    }
+
     if (o.getOper() == opWild) {
         return true;
     }
@@ -78,6 +83,10 @@ bool RefExp::operator==(const Exp &o) const
 
 bool RefExp::operator<(const Exp &o) const
 {
+    if (this == &o) {
+        return false;
+    }
+
     if (opSubscript < o.getOper()) {
         return true;
     }
@@ -186,7 +195,8 @@ bool RefExp::descendType(SharedType newType)
     bool thisChanged = false;
     newType          = m_def->meetWithFor(newType, m_subExp1, thisChanged);
     // In case subExp1 is a m[...]
-    return m_subExp1->descendType(newType);
+    const bool subChanged = m_subExp1->descendType(newType);
+    return thisChanged || subChanged;
 }
 
 
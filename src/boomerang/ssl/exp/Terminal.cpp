@@ -12,10 +12,13 @@
 #include "boomerang/ssl/type/BooleanType.h"
 #include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/NodePool.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
 
+#include <array>
+
 
 Terminal::Terminal(OPER _op)
     : Exp(_op)
@@ -31,13 +34,28 @@ Terminal::Terminal(const Terminal &o)
 
 SharedExp Terminal::get(OPER op)
 {
-    return std::make_shared<Terminal>(op);
+    // Terminals do not have any state apart from the operator,
+    // so all terminals with the same operator share a single node.
+    static const std::array<SharedExp, opFLF + 1> terminals = []() {
+        std::array<SharedExp, opFLF + 1> result;
+        for (int i = 0; i <= opFLF; ++i) {
+            result[i] = makeNode<Terminal>(static_cast<OPER>(i));
+        }
+
+        return result;
+    }();
+
+    if (op < 0 || op > opFLF) {
+        return makeNode<Terminal>(op);
+    }
+
+    return terminals[op];
 }
 
 
 SharedExp Terminal::clone() const
 {
-    return std::make_shared<Terminal>(*this);
+    return makeNode<Terminal>(*this);
 }
 
 
@@ -16,6 +16,8 @@
 /// Terminal holds special zero arity items
 /// such as opFlags (abstract flags register)
 /// These are always terminal expressions.
+/// Terminals are immutable; Terminal::get returns a node that is shared by all users
+/// of the same operator. Use clone() to get a separate node.
 class BOOMERANG_API Terminal : public Exp
 {
 public:
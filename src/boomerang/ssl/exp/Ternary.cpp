@@ -16,6 +16,7 @@
 #include "boomerang/ssl/type/FloatType.h"
 #include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/NodePool.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
@@ -44,7 +45,7 @@ Ternary::~Ternary()
 
 std::shared_ptr<Ternary> Ternary::get(OPER op, SharedExp e1, SharedExp e2, SharedExp e3)
 {
-    return std::make_shared<Ternary>(op, e1, e2, e3);
+    return makeNode<Ternary>(op, e1, e2, e3);
 }
 
 
@@ -85,6 +86,10 @@ SharedExp Ternary::clone() const
 
 bool Ternary::operator==(const Exp &o) const
 {
+    if (this == &o) {
+        return true; // shared subexpression
+    }
+
     if (o.getOper() == opWild) {
         return true;
     }
@@ -101,6 +106,10 @@ bool Ternary::operator==(const Exp &o) const
 
 bool Ternary::operator<(const Exp &o) const
 {
+    if (this == &o) {
+        return false;
+    }
+
     if (m_oper != o.getOper()) {
         return m_oper < o.getOper();
     }
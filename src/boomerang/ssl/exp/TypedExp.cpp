@@ -10,6 +10,7 @@
 #include "TypedExp.h"
 
 #include "boomerang/ssl/type/Type.h"
+#include "boomerang/util/NodePool.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
@@ -38,24 +39,28 @@ TypedExp::TypedExp(const TypedExp &o)
 
 std::shared_ptr<TypedExp> TypedExp::get(SharedExp exp)
 {
-    return std::make_shared<TypedExp>(exp);
+    return makeNode<TypedExp>(exp);
 }
 
 
 std::shared_ptr<TypedExp> TypedExp::get(SharedType ty, SharedExp exp)
 {
-    return std::make_shared<TypedExp>(ty, exp);
+    return makeNode<TypedExp>(ty, exp);
 }
 
 
 SharedExp TypedExp::clone() const
 {
-    return std::make_shared<TypedExp>(m_type, m_subExp1->clone());
+    return makeNode<TypedExp>(m_type, m_subExp1->clone());
 }
 
 
 bool TypedExp::operator==(const Exp &o) const
 {
+    if (this == &o) {
+        return true; // shared subexpression
+    }
+
     if (static_cast<const TypedExp &>(o).m_oper == opWild) {
         return true;
     }
@@ -75,6 +80,10 @@ bool TypedExp::operator==(const Exp &o) const
 
 bool TypedExp::operator<(const Exp &o) const // Type sensitive
 {
+    if (this == &o) {
+        return false;
+    }
+
     if (m_oper < o.getOper()) {
         return true;
     }
@@ -21,6 +21,7 @@
 #include "boomerang/ssl/type/IntegerType.h"
 #include "boomerang/ssl/type/PointerType.h"
 #include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/NodePool.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
@@ -49,7 +50,7 @@ Unary::~Unary()
 
 SharedExp Unary::get(OPER op, SharedExp e1)
 {
-    return std::make_shared<Unary>(op, e1);
+    return makeNode<Unary>(op, e1);
 }
 
 
@@ -84,12 +85,16 @@ SharedExp &Unary::refSubExp1()
 SharedExp Unary::clone() const
 {
     assert(m_subExp1);
-    return std::make_shared<Unary>(m_oper, m_subExp1->clone());
+    return makeNode<Unary>(m_oper, m_subExp1->clone());
 }
 
 
 bool Unary::operator==(const Exp &o) const
 {
+    if (this == &o) {
+        return true; // shared subexpression
+    }
+
     if (o.getOper() == opWild) {
         return true;
     }
@@ -116,6 +121,10 @@ bool Unary::operator==(const Exp &o) const
 
 bool Unary::operator<(const Exp &o) const
 {
+    if (this == &o) {
+        return false;
+    }
+
     if (m_oper != static_cast<const Unary &>(o).m_oper) {
         return m_oper < static_cast<const Unary &>(o).m_oper;
     }
@@ -18,6 +18,7 @@
 #include "boomerang/ssl/exp/Unary.h"
 #include "boomerang/ssl/type/Type.h"
 #include "boomerang/util/LocationSet.h"
+#include "boomerang/util/NodePool.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ExpModifier.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
@@ -58,7 +59,7 @@ Assign::Assign(const Assign &other)
 
 SharedStmt Assign::clone() const
 {
-    return std::make_shared<Assign>(*this);
+    return makeNode<Assign>(*this);
 }
 
 
@@ -16,6 +16,7 @@
 #include "boomerang/ssl/statements/Assign.h"
 #include "boomerang/ssl/statements/StatementHelper.h"
 #include "boomerang/util/LocationSet.h"
+#include "boomerang/util/NodePool.h"
 #include "boomerang/visitor/expvisitor/ExpVisitor.h"
 #include "boomerang/visitor/stmtexpvisitor/StmtExpVisitor.h"
 #include "boomerang/visitor/stmtmodifier/StmtModifier.h"
@@ -120,7 +121,7 @@ void BoolAssign::printCompact(OStream &os) const
 
 SharedStmt BoolAssign::clone() const
 {
-    return std::make_shared<BoolAssign>(*this);
+    return makeNode<BoolAssign>(*this);
 }
 
 
@@ -30,6 +30,7 @@
 #include "boomerang/ssl/type/PointerType.h"
 #include "boomerang/ssl/type/VoidType.h"
 #include "boomerang/util/ArgSourceProvider.h"
+#include "boomerang/util/NodePool.h"
 #include "boomerang/util/log/Log.h"
 #include "boomerang/visitor/expmodifier/ImplicitConverter.h"
 #include "boomerang/visitor/expmodifier/Localiser.h"
@@ -107,7 +108,7 @@ CallStatement &CallStatement::operator=(const CallStatement &other)
 
 SharedStmt CallStatement::clone() const
 {
-    return std::make_shared<CallStatement>(*this);
+    return makeNode<CallStatement>(*this);
 }
 
 
@@ -524,8 +525,8 @@ void CallStatement::setSigArguments()
             l->setProc(m_proc); // Needed?
         }
 
-        std::shared_ptr<Assign> asgn = std::make_shared<Assign>(
-            m_signature->getParamType(i)->clone(), e->clone(), e->clone());
+        std::shared_ptr<Assign> asgn = makeNode<Assign>(m_signature->getParamType(i)->clone(),
+                                                        e->clone(), e->clone());
 
         asgn->setProc(m_proc);
         asgn->setFragment(m_fragment);
@@ -857,7 +858,7 @@ std::unique_ptr<StatementList> CallStatement::calcResults() const
                 continue; // Ignore the stack pointer
             }
 
-            result->append(std::make_shared<ImplicitAssign>(loc));
+            result->append(makeNode<ImplicitAssign>(loc));
         }
 
         result->sort([sig](const SharedConstStmt &left, const SharedConstStmt &right) {
@@ -85,6 +85,16 @@ public:
     /// \returns true if this type is already in the union.
     bool hasType(SharedType ty);
 
+    /// \returns the types and names of all members of this union.
+    const UnionEntries &getEntries() const { return m_entries; }
+
+    /**
+     * Add a new type to this union.
+     * \param type the type of the new member
+     * \param name the name of the new member
+     */
+    void addType(SharedType type, const QString &name = "");
+
     /// If this union contains only 1 type, return the one and only member type.
     /// If this union has no types, return VoidType.
     /// Otherwise, return this.
@@ -94,14 +104,6 @@ protected:
     /// \copydoc Type::isCompatible
     bool isCompatible(const Type &other, bool all) const override;
 
-private:
-    /**
-     * Add a new type to this union.
-     * \param type the type of the new member
-     * \param name the name of the new member
-     */
-    void addType(SharedType type, const QString &name = "");
-
 private:
     UnionEntries m_entries;
 };
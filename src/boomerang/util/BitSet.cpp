@@ -0,0 +1,153 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BitSet.h"
+
+#include <algorithm>
+#include <bitset>
+
+
+BitSet::BitSet(std::size_t numBits)
+    : m_words((numBits + BITS_PER_WORD - 1) / BITS_PER_WORD, 0)
+{
+}
+
+
+bool BitSet::operator==(const BitSet &other) const
+{
+    const std::size_t common = std::min(m_words.size(), other.m_words.size());
+
+    if (!std::equal(m_words.begin(), m_words.begin() + common, other.m_words.begin())) {
+        return false;
+    }
+
+    // All remaining words of the larger set must be empty
+    const std::vector<Word> &larger = m_words.size() > common ? m_words : other.m_words;
+    return std::all_of(larger.begin() + common, larger.end(), [](Word w) { return w == 0; });
+}
+
+
+void BitSet::clear()
+{
+    std::fill(m_words.begin(), m_words.end(), 0);
+}
+
+
+bool BitSet::none() const
+{
+    return std::all_of(m_words.begin(), m_words.end(), [](Word w) { return w == 0; });
+}
+
+
+std::size_t BitSet::count() const
+{
+    std::size_t n = 0;
+    for (Word w : m_words) {
+        n += std::bitset<BITS_PER_WORD>(w).count();
+    }
+
+    return n;
+}
+
+
+bool BitSet::makeUnion(const BitSet &other)
+{
+    if (other.m_words.size() > m_words.size()) {
+        m_words.resize(other.m_words.size(), 0);
+    }
+
+    Word changed = 0;
+    for (std::size_t i = 0; i < other.m_words.size(); ++i) {
+        const Word old = m_words[i];
+        m_words[i] |= other.m_words[i];
+        changed |= old ^ m_words[i];
+    }
+
+    return changed != 0;
+}
+
+
+bool BitSet::makeIsect(const BitSet &other)
+{
+    Word changed = 0;
+    for (std::size_t i = 0; i < m_words.size(); ++i) {
+        const Word old = m_words[i];
+        m_words[i] &= i < other.m_words.size() ? other.m_words[i] : 0;
+        changed |= old ^ m_words[i];
+    }
+
+    return changed != 0;
+}
+
+
+bool BitSet::makeDiff(const BitSet &other)
+{
+    const std::size_t common = std::min(m_words.size(), other.m_words.size());
+
+    Word changed = 0;
+    for (std::size_t i = 0; i < common; ++i) {
+        const Word old = m_words[i];
+        m_words[i] &= ~other.m_words[i];
+        changed |= old ^ m_words[i];
+    }
+
+    return changed != 0;
+}
+
+
+bool BitSet::intersects(const BitSet &other) const
+{
+    const std::size_t common = std::min(m_words.size(), other.m_words.size());
+
+    for (std::size_t i = 0; i < common; ++i) {
+        if ((m_words[i] & other.m_words[i]) != 0) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+std::size_t BitSet::lowestBit(Word bits)
+{
+#if defined(__GNUC__) || defined(__clang__)
+    return static_cast<std::size_t>(__builtin_ctzll(bits));
+#else
+    std::size_t idx = 0;
+    while ((bits & 1) == 0) {
+        bits >>= 1;
+        idx++;
+    }
+
+    return idx;
+#endif
+}
+
+
+std::size_t BitSet::findFrom(std::size_t idx) const
+{
+    std::size_t word = idx / BITS_PER_WORD;
+    if (word >= m_words.size()) {
+        return npos;
+    }
+
+    // mask out all bits below idx in the first word
+    Word bits = m_words[word] & (~Word(0) << (idx % BITS_PER_WORD));
+
+    while (bits == 0) {
+        if (++word >= m_words.size()) {
+            return npos;
+        }
+
+        bits = m_words[word];
+    }
+
+    return word * BITS_PER_WORD + lowestBit(bits);
+}
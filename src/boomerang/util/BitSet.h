@@ -0,0 +1,138 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Types.h"
+
+#include <cstddef>
+#include <vector>
+
+
+/**
+ * A dense set of small non-negative integers, stored as a bit vector.
+ * Used for dataflow analyses, where locations or fragments are numbered densely
+ * (see \ref LocationNumbering), so that set operations become word-wide bitwise operations.
+ *
+ * The set grows automatically when adding elements. Bits beyond the current size
+ * are treated as not set, so sets of different sizes can be combined and compared.
+ */
+class BOOMERANG_API BitSet
+{
+    typedef uint64 Word;
+    static constexpr const std::size_t BITS_PER_WORD = 64;
+
+public:
+    /// Returned by \ref findFirst and \ref findNext if there are no more elements.
+    static constexpr const std::size_t npos = static_cast<std::size_t>(-1);
+
+public:
+    BitSet() = default;
+
+    /// Create an empty set with space for the elements [0, numBits)
+    explicit BitSet(std::size_t numBits);
+
+    BitSet(const BitSet &other) = default;
+    BitSet(BitSet &&other)      = default;
+
+    ~BitSet() = default;
+
+    BitSet &operator=(const BitSet &other) = default;
+    BitSet &operator=(BitSet &&other) = default;
+
+public:
+    bool operator==(const BitSet &other) const;
+    bool operator!=(const BitSet &other) const { return !(*this == other); }
+
+public:
+    /// \returns true if \p idx is an element of this set.
+    bool test(std::size_t idx) const
+    {
+        const std::size_t word = idx / BITS_PER_WORD;
+        return word < m_words.size() && (m_words[word] & bit(idx)) != 0;
+    }
+
+    /// Add \p idx to this set.
+    void set(std::size_t idx)
+    {
+        const std::size_t word = idx / BITS_PER_WORD;
+        if (word >= m_words.size()) {
+            m_words.resize(word + 1, 0);
+        }
+
+        m_words[word] |= bit(idx);
+    }
+
+    /// Remove \p idx from this set.
+    void reset(std::size_t idx)
+    {
+        const std::size_t word = idx / BITS_PER_WORD;
+        if (word < m_words.size()) {
+            m_words[word] &= ~bit(idx);
+        }
+    }
+
+    /// Remove all elements from this set.
+    void clear();
+
+    /// \returns true if this set does not contain any elements.
+    bool none() const;
+    bool any() const { return !none(); }
+
+    /// \returns the number of elements in this set.
+    std::size_t count() const;
+
+    /// Add all elements of \p other to this set.
+    /// \returns true if this set was changed.
+    bool makeUnion(const BitSet &other);
+
+    /// Remove all elements from this set that are not in \p other.
+    /// \returns true if this set was changed.
+    bool makeIsect(const BitSet &other);
+
+    /// Remove all elements of \p other from this set.
+    /// \returns true if this set was changed.
+    bool makeDiff(const BitSet &other);
+
+    /// \returns true if this set and \p other have at least one element in common.
+    bool intersects(const BitSet &other) const;
+
+    /// \returns the smallest element of this set, or \ref npos if the set is empty.
+    std::size_t findFirst() const { return findFrom(0); }
+
+    /// \returns the smallest element of this set larger than \p idx, or \ref npos
+    std::size_t findNext(std::size_t idx) const { return findFrom(idx + 1); }
+
+    /// Call \p func for every element of this set, in ascending order.
+    template<typename Func>
+    void forEach(Func func) const
+    {
+        for (std::size_t word = 0; word < m_words.size(); ++word) {
+            Word bits = m_words[word];
+
+            while (bits != 0) {
+                func(word * BITS_PER_WORD + lowestBit(bits));
+                bits &= bits - 1; // clear lowest set bit
+            }
+        }
+    }
+
+private:
+    static Word bit(std::size_t idx) { return Word(1) << (idx % BITS_PER_WORD); }
+
+    static std::size_t lowestBit(Word bits);
+
+    /// \returns the smallest element >= \p idx, or \ref npos
+    std::size_t findFrom(std::size_t idx) const;
+
+private:
+    std::vector<Word> m_words;
+};
@@ -30,10 +30,7 @@ void DFGWriter::printDFG(const UserProc *proc, const QString &fname)
     OStream out(&file);
     out << "digraph " << proc->getName() << " {\n";
     proc->numberStatements();
-    StatementList stmts;
-    proc->getStatements(stmts);
-
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : proc->getStatementRange()) {
         if (s->isPhi()) {
             out << s->getNumber() << " [shape=\"triangle\"];\n";
         }
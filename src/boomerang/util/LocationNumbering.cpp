@@ -0,0 +1,36 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LocationNumbering.h"
+
+
+void LocationNumbering::clear()
+{
+    m_indices.clear();
+    m_locations.clear();
+}
+
+
+std::size_t LocationNumbering::insert(const SharedExp &loc)
+{
+    auto [it, inserted] = m_indices.insert({ loc, m_locations.size() });
+
+    if (inserted) {
+        m_locations.push_back(loc);
+    }
+
+    return it->second;
+}
+
+
+std::size_t LocationNumbering::find(const SharedExp &loc) const
+{
+    auto it = m_indices.find(loc);
+    return it != m_indices.end() ? it->second : INVALID;
+}
@@ -0,0 +1,63 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/ssl/exp/ExpHelp.h"
+
+#include <map>
+#include <vector>
+
+
+/**
+ * Assigns a dense index to each distinct location (e.g. of a UserProc), so that sets of
+ * locations can be represented as a \ref BitSet. Indices are assigned in insertion order,
+ * starting from 0. Locations are compared by value (see \ref lessExpStar);
+ * only the first instance of equal locations is stored.
+ */
+class BOOMERANG_API LocationNumbering
+{
+    typedef std::map<SharedExp, std::size_t, lessExpStar> IndexMap;
+
+public:
+    /// Returned by \ref find if the location was not numbered yet.
+    static constexpr const std::size_t INVALID = static_cast<std::size_t>(-1);
+
+    /// Iterates over (location, index) pairs, sorted by location (not by index).
+    typedef IndexMap::const_iterator const_iterator;
+
+public:
+    const_iterator begin() const { return m_indices.begin(); }
+    const_iterator end() const { return m_indices.end(); }
+
+public:
+    /// \returns the number of distinct locations numbered so far.
+    std::size_t size() const { return m_locations.size(); }
+
+    bool isEmpty() const { return m_locations.empty(); }
+
+    void clear();
+
+    /**
+     * Number the location \p loc, if it was not numbered before.
+     * \returns the index of \p loc.
+     */
+    std::size_t insert(const SharedExp &loc);
+
+    /// \returns the index of \p loc, or \ref INVALID if \p loc was not numbered yet.
+    std::size_t find(const SharedExp &loc) const;
+
+    /// \returns the location with index \p idx.
+    const SharedExp &getLocation(std::size_t idx) const { return m_locations[idx]; }
+
+private:
+    IndexMap m_indices;                 ///< Maps location -> index
+    std::vector<SharedExp> m_locations; ///< Maps index -> location
+};
@@ -0,0 +1,233 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "NodePool.h"
+
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+
+
+/// Size classes are multiples of this. Also the alignment of all nodes.
+static constexpr const std::size_t GRANULARITY = alignof(std::max_align_t);
+
+static constexpr const std::size_t NUM_SIZE_CLASSES = NodePool::MAX_NODE_SIZE / GRANULARITY;
+
+/// Size of the chunks allocated from the system
+static constexpr const std::size_t CHUNK_SIZE = 64 * 1024;
+
+/// Number of nodes moved between a thread cache and the global free lists at once
+static constexpr const std::size_t BATCH_SIZE = 64;
+
+
+namespace
+{
+/// Intrusive free list node, stored in the free memory itself
+struct FreeNode
+{
+    FreeNode *next;
+};
+
+
+struct FreeList
+{
+    FreeNode *head    = nullptr;
+    std::size_t count = 0;
+
+    void push(FreeNode *node)
+    {
+        node->next = head;
+        head       = node;
+        count++;
+    }
+
+    FreeNode *pop()
+    {
+        FreeNode *node = head;
+        head           = node->next;
+        count--;
+        return node;
+    }
+};
+
+
+/// Free nodes shared by all threads
+class GlobalPool
+{
+public:
+    /// Move up to BATCH_SIZE free nodes of \p sizeClass to \p list.
+    void fetch(std::size_t sizeClass, FreeList &list)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FreeList &free = m_free[sizeClass];
+
+        if (free.count == 0) {
+            carveChunk(sizeClass);
+        }
+
+        while (free.count > 0 && list.count < BATCH_SIZE) {
+            list.push(free.pop());
+        }
+    }
+
+    /// Move up to \p numNodes nodes from \p list to the global free list of \p sizeClass
+    void release(std::size_t sizeClass, FreeList &list, std::size_t numNodes)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        FreeList &free = m_free[sizeClass];
+
+        while (list.count > 0 && numNodes-- > 0) {
+            free.push(list.pop());
+        }
+    }
+
+    std::size_t getNumBytesReserved() const { return m_bytesReserved.load(); }
+
+private:
+    void carveChunk(std::size_t sizeClass)
+    {
+        const std::size_t nodeSize = (sizeClass + 1) * GRANULARITY;
+        char *chunk                = static_cast<char *>(::operator new(CHUNK_SIZE));
+
+        m_chunks.push_back(chunk);
+        m_bytesReserved += CHUNK_SIZE;
+
+        for (std::size_t offset = 0; offset + nodeSize <= CHUNK_SIZE; offset += nodeSize) {
+            m_free[sizeClass].push(reinterpret_cast<FreeNode *>(chunk + offset));
+        }
+    }
+
+private:
+    std::mutex m_mutex;
+    FreeList m_free[NUM_SIZE_CLASSES];
+    std::vector<char *> m_chunks; ///< All chunks; nodes may be in use until program exit
+    std::atomic<std::size_t> m_bytesReserved{ 0 };
+};
+
+
+GlobalPool &getGlobalPool()
+{
+    // Never destroyed, since nodes may be freed by static destructors.
+    static GlobalPool *pool = new GlobalPool;
+    return *pool;
+}
+
+
+/// Free nodes of the current thread. Trivially destructible, so it can still be used
+/// (by forwarding to the global pool) after the thread cache was flushed at thread exit.
+struct ThreadCache
+{
+    FreeList free[NUM_SIZE_CLASSES];
+    bool flushed = false;
+};
+
+
+thread_local ThreadCache g_threadCache;
+
+
+/// Returns the nodes of the thread cache to the global pool when the thread exits.
+struct ThreadCacheFlusher
+{
+    ~ThreadCacheFlusher()
+    {
+        for (std::size_t i = 0; i < NUM_SIZE_CLASSES; ++i) {
+            getGlobalPool().release(i, g_threadCache.free[i], g_threadCache.free[i].count);
+        }
+
+        g_threadCache.flushed = true;
+    }
+};
+
+
+/// Make sure the thread cache is flushed when the current thread exits.
+/// Must not be called after the cache was flushed.
+void registerThreadCacheFlusher()
+{
+    static thread_local ThreadCacheFlusher flusher;
+    (void)flusher;
+}
+
+
+void *allocateFromThreadCache(std::size_t sizeClass)
+{
+    FreeList &list = g_threadCache.free[sizeClass];
+
+    if (list.count == 0) {
+        if (g_threadCache.flushed) {
+            // Thread is exiting; do not cache nodes that nobody would return.
+            FreeList single;
+            getGlobalPool().fetch(sizeClass, single);
+            void *node = single.pop();
+            getGlobalPool().release(sizeClass, single, single.count);
+            return node;
+        }
+
+        registerThreadCacheFlusher();
+        getGlobalPool().fetch(sizeClass, list);
+    }
+
+    return list.pop();
+}
+
+
+void deallocateToThreadCache(void *ptr, std::size_t sizeClass)
+{
+    FreeList &list = g_threadCache.free[sizeClass];
+    list.push(static_cast<FreeNode *>(ptr));
+
+    if (g_threadCache.flushed) {
+        getGlobalPool().release(sizeClass, list, list.count);
+    }
+    else if (list.count == 1) {
+        // The thread may only ever free nodes, e.g. when it destroys IR built by other threads.
+        registerThreadCacheFlusher();
+    }
+    else if (list.count >= 2 * BATCH_SIZE) {
+        // Do not hoard nodes that were allocated by other threads.
+        getGlobalPool().release(sizeClass, list, BATCH_SIZE);
+    }
+}
+
+
+std::size_t getSizeClass(std::size_t size)
+{
+    return (size + GRANULARITY - 1) / GRANULARITY - 1;
+}
+}
+
+
+void *NodePool::allocate(std::size_t size)
+{
+    if (size == 0 || size > MAX_NODE_SIZE) {
+        return ::operator new(size);
+    }
+
+    return allocateFromThreadCache(getSizeClass(size));
+}
+
+
+void NodePool::deallocate(void *ptr, std::size_t size) noexcept
+{
+    if (!ptr) {
+        return;
+    }
+    else if (size == 0 || size > MAX_NODE_SIZE) {
+        ::operator delete(ptr);
+        return;
+    }
+
+    deallocateToThreadCache(ptr, getSizeClass(size));
+}
+
+
+std::size_t NodePool::getNumBytesReserved()
+{
+    return getGlobalPool().getNumBytesReserved();
+}
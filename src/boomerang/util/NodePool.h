@@ -0,0 +1,88 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <cstddef>
+#include <memory>
+
+
+/**
+ * Allocator for small, short-lived IR nodes (expressions and statements) and their
+ * shared_ptr control blocks. Memory is carved from large chunks and handed out in
+ * fixed size classes, so allocating and freeing a node is usually a push or pop on a
+ * thread local free list instead of a call to malloc.
+ *
+ * Freed nodes are kept for reuse and never returned to the operating system.
+ * Free lists of exiting threads are handed back to a global list.
+ *
+ * IR nodes are only allocated from the pool (by \ref makeNode) if Boomerang was configured
+ * with BOOMERANG_ENABLE_NODE_POOL.
+ */
+class BOOMERANG_API NodePool
+{
+public:
+    /// Requests larger than this are forwarded to the global operator new.
+    static constexpr const std::size_t MAX_NODE_SIZE = 256;
+
+public:
+    static void *allocate(std::size_t size);
+    static void deallocate(void *ptr, std::size_t size) noexcept;
+
+    /// \returns the number of bytes allocated from the system for nodes so far
+    static std::size_t getNumBytesReserved();
+};
+
+
+/// Standard allocator using the NodePool. Use with std::allocate_shared.
+template<typename T>
+class NodeAllocator
+{
+public:
+    typedef T value_type;
+
+public:
+    NodeAllocator() noexcept = default;
+
+    template<typename U>
+    NodeAllocator(const NodeAllocator<U> &) noexcept
+    {
+    }
+
+public:
+    T *allocate(std::size_t n) { return static_cast<T *>(NodePool::allocate(n * sizeof(T))); }
+    void deallocate(T *ptr, std::size_t n) noexcept { NodePool::deallocate(ptr, n * sizeof(T)); }
+
+    template<typename U>
+    bool operator==(const NodeAllocator<U> &) const noexcept
+    {
+        return true;
+    }
+
+    template<typename U>
+    bool operator!=(const NodeAllocator<U> &) const noexcept
+    {
+        return false;
+    }
+};
+
+
+/// Like std::make_shared, but allocates the node and its control block from the NodePool.
+template<typename T, typename... Args>
+std::shared_ptr<T> makeNode(Args &&... args)
+{
+#if BOOMERANG_NODE_POOL
+    return std::allocate_shared<T>(NodeAllocator<T>(), std::forward<Args>(args)...);
+#else
+    return std::make_shared<T>(std::forward<Args>(args)...);
+#endif
+}
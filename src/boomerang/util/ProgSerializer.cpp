@@ -0,0 +1,1094 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProgSerializer.h"
+
+#include "boomerang/db/BasicBlock.h"
+#include "boomerang/db/LowLevelCFG.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Class.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/module/ModuleFactory.h"
+#include "boomerang/db/proc/LibProc.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/db/signature/CustomSignature.h"
+#include "boomerang/db/signature/PPCSignature.h"
+#include "boomerang/db/signature/Parameter.h"
+#include "boomerang/db/signature/ST20Signature.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/db/signature/Win32Signature.h"
+#include "boomerang/db/signature/X86Signature.h"
+#include "boomerang/frontend/MachineInstruction.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/Terminal.h"
+#include "boomerang/ssl/exp/Ternary.h"
+#include "boomerang/ssl/exp/TypedExp.h"
+#include "boomerang/ssl/type/ArrayType.h"
+#include "boomerang/ssl/type/BooleanType.h"
+#include "boomerang/ssl/type/CharType.h"
+#include "boomerang/ssl/type/CompoundType.h"
+#include "boomerang/ssl/type/FloatType.h"
+#include "boomerang/ssl/type/FuncType.h"
+#include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/ssl/type/NamedType.h"
+#include "boomerang/ssl/type/PointerType.h"
+#include "boomerang/ssl/type/SizeType.h"
+#include "boomerang/ssl/type/UnionType.h"
+#include "boomerang/ssl/type/VoidType.h"
+#include "boomerang/util/Util.h"
+#include "boomerang/util/log/Log.h"
+
+#include <QDataStream>
+#include <QIODevice>
+
+#include <algorithm>
+#include <cstring>
+
+
+/// Class of an expression in the serialized data
+enum class ExpClass : quint8
+{
+    Null = 0,
+    Const,
+    Terminal,
+    Unary,
+    Location,
+    Binary,
+    Ternary,
+    TypedExp
+};
+
+
+/// Class of a signature in the serialized data
+enum class SigClass : quint8
+{
+    Null = 0,
+    Plain,
+    X86,
+    Win32,
+    Win32Tc,
+    PPC,
+    ST20,
+    Custom
+};
+
+
+/// Marks a null type in the serialized data. Other types are identified by their TypeClass.
+static constexpr const quint8 NULL_TYPE = 0xFF;
+
+
+ProgSerializer::ProgSerializer(QDataStream &stream)
+    : m_stream(stream)
+{
+    // Pin the stream version so the data does not depend on the Qt version used to write it.
+    m_stream.setVersion(QDataStream::Qt_5_0);
+    m_stream.setByteOrder(QDataStream::LittleEndian);
+}
+
+
+bool ProgSerializer::writeHeader(const QString &binaryFilePath, const QByteArray &binaryChecksum)
+{
+    m_stream << MAGIC << FORMAT_VERSION << QString(BOOMERANG_VERSION);
+    m_stream << binaryFilePath << binaryChecksum;
+
+    return m_stream.status() == QDataStream::Ok;
+}
+
+
+bool ProgSerializer::readHeader(QString &binaryFilePath, QByteArray &binaryChecksum)
+{
+    quint32 magic = 0, version = 0;
+    QString writerVersion;
+
+    m_stream >> magic >> version;
+    if (!check(magic == MAGIC)) {
+        LOG_ERROR("Not a Boomerang decode cache");
+        return false;
+    }
+    else if (!check(version == FORMAT_VERSION)) {
+        LOG_ERROR("Unsupported decode cache version %1 (expected version %2)", version,
+                  FORMAT_VERSION);
+        return false;
+    }
+
+    m_stream >> writerVersion >> binaryFilePath >> binaryChecksum;
+    return m_stream.status() == QDataStream::Ok;
+}
+
+
+bool ProgSerializer::writeDecodedProg(const Prog *prog)
+{
+    m_stream << prog->getName();
+
+    // modules
+    std::map<const Module *, qint32> moduleIndex;
+    m_stream << static_cast<quint32>(prog->getModuleList().size());
+
+    for (const auto &module : prog->getModuleList()) {
+        const Module *parent = module->getParentModule();
+        auto parentIt        = moduleIndex.find(parent);
+
+        m_stream << module->getName() << module->isAggregate();
+        m_stream << (parentIt != moduleIndex.end() ? parentIt->second : qint32(-1));
+
+        const qint32 idx          = static_cast<qint32>(moduleIndex.size());
+        moduleIndex[module.get()] = idx;
+    }
+
+    // functions
+    quint32 numFunctions = 0;
+    for (const auto &module : prog->getModuleList()) {
+        numFunctions += module->size();
+    }
+
+    m_stream << numFunctions;
+
+    for (const auto &module : prog->getModuleList()) {
+        for (Function *func : *module) {
+            m_stream << moduleIndex[module.get()] << func->isLib() << func->getName();
+            m_stream << static_cast<quint64>(func->getEntryAddress().value());
+
+            if (func->isLib()) {
+                m_stream << static_cast<quint8>(ProcStatus::Undecoded);
+                writeSignature(func->getSignature());
+                continue;
+            }
+
+            const UserProc *proc = static_cast<const UserProc *>(func);
+
+            // The high level IR is not written, so the proc must be decompiled again.
+            // Signatures found by decompilation are discarded unless they are forced.
+            const ProcStatus status = std::min(proc->getStatus(), ProcStatus::Decoded);
+            m_stream << static_cast<quint8>(status);
+
+            if (proc->getStatus() > ProcStatus::Decoded && !proc->getSignature()->isForced()) {
+                writeSignature(std::make_shared<Signature>(proc->getName()));
+            }
+            else {
+                writeSignature(proc->getSignature());
+            }
+        }
+    }
+
+    // entry points
+    m_stream << static_cast<quint32>(prog->getEntryProcs().size());
+    for (const UserProc *proc : prog->getEntryProcs()) {
+        m_stream << static_cast<quint64>(proc->getEntryAddress().value());
+    }
+
+    // globals
+    m_stream << static_cast<quint32>(prog->getGlobals().size());
+    for (const std::shared_ptr<Global> &global : prog->getGlobals()) {
+        m_stream << static_cast<quint64>(global->getAddress().value()) << global->getName();
+        writeType(global->getType());
+    }
+
+    // low level CFG
+    m_stream << static_cast<quint32>(prog->getCFG()->getNumBBs());
+    for (const BasicBlock *bb : *prog->getCFG()) {
+        writeBB(bb);
+    }
+
+    return m_stream.status() == QDataStream::Ok;
+}
+
+
+bool ProgSerializer::readDecodedProg(Prog *prog)
+{
+    m_prog = prog;
+
+    QString progName;
+    m_stream >> progName;
+    prog->setName(progName);
+
+    // modules
+    quint32 numModules = 0;
+    if (!readCount(numModules)) {
+        return false;
+    }
+
+    DefaultModFactory defaultFactory;
+    ClassModFactory classFactory;
+
+    std::vector<Module *> modules;
+    for (quint32 i = 0; i < numModules && m_stream.status() == QDataStream::Ok; ++i) {
+        QString name;
+        bool isClass  = false;
+        qint32 parent = -1;
+
+        m_stream >> name >> isClass >> parent;
+        if (!check(parent < static_cast<qint32>(modules.size()))) {
+            return false;
+        }
+
+        if (i == 0) {
+            modules.push_back(prog->getRootModule());
+            continue;
+        }
+
+        const IModuleFactory &factory = isClass ? static_cast<const IModuleFactory &>(classFactory)
+                                                : defaultFactory;
+
+        Module *module = nullptr;
+        if (parent >= 0) {
+            module = prog->createModule(name, modules[parent], factory);
+        }
+
+        if (!module) {
+            module = prog->findModule(name);
+        }
+
+        if (!module) {
+            module = prog->getOrInsertModule(name, factory);
+        }
+
+        modules.push_back(module);
+    }
+
+    // functions
+    quint32 numFunctions = 0;
+    if (!readCount(numFunctions)) {
+        return false;
+    }
+
+    std::vector<std::pair<UserProc *, ProcStatus>> procStatus;
+
+    for (quint32 i = 0; i < numFunctions && m_stream.status() == QDataStream::Ok; ++i) {
+        qint32 moduleIdx = 0;
+        bool isLib       = false;
+        QString name;
+        quint64 entryAddr = 0;
+        quint8 status     = 0;
+
+        m_stream >> moduleIdx >> isLib >> name >> entryAddr >> status;
+        std::shared_ptr<Signature> sig = readSignature();
+
+        if (!check(Util::inRange(moduleIdx, 0, static_cast<qint32>(modules.size())) &&
+                   status <= static_cast<quint8>(ProcStatus::Decoded) && sig != nullptr)) {
+            return false;
+        }
+
+        const Address addr = Address(entryAddr);
+        Function *func     = isLib ? prog->getFunctionByName(name) : prog->getFunctionByAddr(addr);
+
+        if (func && func->isLib() != isLib) {
+            LOG_ERROR("Cannot restore function '%1': A function with the same name or address "
+                      "already exists",
+                      name);
+            return check(false);
+        }
+        else if (!func) {
+            func = modules[moduleIdx]->createFunction(name, addr, isLib);
+        }
+        else {
+            func->setModule(modules[moduleIdx]);
+        }
+
+        func->setSignature(sig);
+
+        if (!isLib) {
+            procStatus.push_back({ static_cast<UserProc *>(func), ProcStatus(status) });
+        }
+    }
+
+    // entry points
+    quint32 numEntryPoints = 0;
+    if (!readCount(numEntryPoints, sizeof(quint64))) {
+        return false;
+    }
+
+    for (quint32 i = 0; i < numEntryPoints && m_stream.status() == QDataStream::Ok; ++i) {
+        quint64 entryAddr = 0;
+        m_stream >> entryAddr;
+        prog->addEntryPoint(Address(entryAddr));
+    }
+
+    // globals
+    quint32 numGlobals = 0;
+    if (!readCount(numGlobals, sizeof(quint64))) {
+        return false;
+    }
+
+    for (quint32 i = 0; i < numGlobals && m_stream.status() == QDataStream::Ok; ++i) {
+        quint64 addr = 0;
+        QString name;
+
+        m_stream >> addr >> name;
+        SharedType ty = readType();
+
+        if (!check(ty != nullptr)) {
+            return false;
+        }
+
+        if (Global *existing = prog->getGlobalByName(name)) {
+            existing->setType(ty);
+        }
+        else {
+            prog->createGlobal(Address(addr), ty, name);
+        }
+    }
+
+    // low level CFG
+    struct BBInfo
+    {
+        BasicBlock *bb;
+        BBType type;
+        Address procAddr;
+        std::vector<Address> successors;
+    };
+
+    LowLevelCFG *cfg = prog->getCFG();
+    quint32 numBBs   = 0;
+    if (!readCount(numBBs, sizeof(quint64) + sizeof(bool))) {
+        return false;
+    }
+
+    std::vector<BBInfo> bbs;
+    bbs.reserve(numBBs);
+
+    for (quint32 i = 0; i < numBBs && m_stream.status() == QDataStream::Ok; ++i) {
+        quint64 lowAddr = 0;
+        bool complete   = false;
+        m_stream >> lowAddr >> complete;
+
+        BBInfo info{ nullptr, BBType::Invalid, Address::INVALID, {} };
+
+        if (complete) {
+            qint32 type      = 0;
+            quint32 numInsns = 0;
+            m_stream >> type;
+
+            if (!readCount(numInsns, sizeof(quint64))) {
+                return false;
+            }
+
+            std::vector<MachineInstruction> insns(numInsns);
+            for (MachineInstruction &insn : insns) {
+                if (!readInsn(insn)) {
+                    return false;
+                }
+            }
+
+            quint64 procAddr = 0;
+            m_stream >> procAddr;
+
+            if (!check(!insns.empty() && insns.front().m_addr == Address(lowAddr))) {
+                return false;
+            }
+
+            info.type     = static_cast<BBType>(type);
+            info.procAddr = Address(procAddr);
+            info.bb       = cfg->createBB(info.type, insns);
+        }
+        else if (cfg->isStartOfBB(Address(lowAddr))) {
+            info.bb = cfg->getBBStartingAt(Address(lowAddr));
+        }
+        else {
+            info.bb = cfg->createIncompleteBB(Address(lowAddr));
+        }
+
+        quint32 numSuccessors = 0;
+        if (!readCount(numSuccessors, sizeof(quint64))) {
+            return false;
+        }
+
+        for (quint32 j = 0; j < numSuccessors && m_stream.status() == QDataStream::Ok; ++j) {
+            quint64 succAddr = 0;
+            m_stream >> succAddr;
+            info.successors.push_back(Address(succAddr));
+        }
+
+        if (!check(info.bb != nullptr)) {
+            LOG_ERROR("Cannot restore BB at address %1", Address(lowAddr));
+            return false;
+        }
+
+        bbs.push_back(info);
+    }
+
+    if (m_stream.status() != QDataStream::Ok) {
+        return false;
+    }
+
+    for (const BBInfo &info : bbs) {
+        for (Address succAddr : info.successors) {
+            BasicBlock *succ = cfg->getBBStartingAt(succAddr);
+            if (!check(succ != nullptr)) {
+                return false;
+            }
+
+            cfg->addEdge(info.bb, succ);
+        }
+
+        if (info.bb->isComplete()) {
+            // addEdge might have changed the type
+            info.bb->setType(info.type);
+
+            Function *proc = prog->getFunctionByAddr(info.procAddr);
+            if (proc && !proc->isLib()) {
+                info.bb->setProc(static_cast<UserProc *>(proc));
+            }
+        }
+    }
+
+    for (auto &[proc, status] : procStatus) {
+        proc->setStatus(status);
+    }
+
+    return m_stream.status() == QDataStream::Ok;
+}
+
+
+void ProgSerializer::writeExp(const SharedExp &exp)
+{
+    if (exp == nullptr) {
+        m_stream << static_cast<quint8>(ExpClass::Null);
+        return;
+    }
+
+    switch (exp->getOper()) {
+    case opSubscript:
+        // Subscripts only exist in the high level IR, which is not saved.
+        writeExp(exp->getSubExp1());
+        return;
+
+    case opTypedExp:
+        m_stream << static_cast<quint8>(ExpClass::TypedExp);
+        writeType(exp->access<TypedExp>()->getType());
+        writeExp(exp->getSubExp1());
+        return;
+
+    default: break;
+    }
+
+    switch (exp->getArity()) {
+    case 0:
+        if (std::shared_ptr<Const> c = std::dynamic_pointer_cast<Const>(exp)) {
+            m_stream << static_cast<quint8>(ExpClass::Const) << static_cast<qint32>(c->getOper());
+            writeConstValue(*c);
+            writeType(c->getType());
+        }
+        else {
+            m_stream << static_cast<quint8>(ExpClass::Terminal)
+                     << static_cast<qint32>(exp->getOper());
+        }
+        break;
+
+    case 1:
+        if (std::shared_ptr<Location> loc = std::dynamic_pointer_cast<Location>(exp)) {
+            m_stream << static_cast<quint8>(ExpClass::Location)
+                     << static_cast<qint32>(exp->getOper());
+            m_stream << (loc->getProc() ? loc->getProc()->getName() : QString(""));
+        }
+        else {
+            m_stream << static_cast<quint8>(ExpClass::Unary)
+                     << static_cast<qint32>(exp->getOper());
+        }
+
+        writeExp(exp->getSubExp1());
+        break;
+
+    case 2:
+        m_stream << static_cast<quint8>(ExpClass::Binary) << static_cast<qint32>(exp->getOper());
+        writeExp(exp->getSubExp1());
+        writeExp(exp->getSubExp2());
+        break;
+
+    case 3:
+        m_stream << static_cast<quint8>(ExpClass::Ternary) << static_cast<qint32>(exp->getOper());
+        writeExp(exp->getSubExp1());
+        writeExp(exp->getSubExp2());
+        writeExp(exp->getSubExp3());
+        break;
+
+    default: assert(false); break;
+    }
+}
+
+
+SharedExp ProgSerializer::readExp()
+{
+    quint8 expClass = 0;
+    m_stream >> expClass;
+
+    if (m_stream.status() != QDataStream::Ok ||
+        expClass == static_cast<quint8>(ExpClass::Null)) {
+        return nullptr;
+    }
+    else if (expClass == static_cast<quint8>(ExpClass::TypedExp)) {
+        SharedType ty = readType();
+        SharedExp sub = readExp();
+
+        return check(ty && sub) ? TypedExp::get(ty, sub) : nullptr;
+    }
+
+    qint32 op = opInvalid;
+    m_stream >> op;
+
+    if (!check(Util::inRange(op, static_cast<qint32>(opInvalid) + 1,
+                             static_cast<qint32>(opFLF) + 1))) {
+        return nullptr;
+    }
+
+    const OPER oper = static_cast<OPER>(op);
+
+    switch (static_cast<ExpClass>(expClass)) {
+    case ExpClass::Const: {
+        std::shared_ptr<Const> c = readConstValue(oper);
+        if (!c) {
+            return nullptr;
+        }
+
+        SharedType ty = readType();
+        if (!check(ty != nullptr)) {
+            return nullptr;
+        }
+
+        c->setType(ty);
+        return c;
+    }
+
+    case ExpClass::Terminal: return Terminal::get(oper);
+
+    case ExpClass::Location: {
+        QString procName;
+        m_stream >> procName;
+
+        UserProc *proc = nullptr;
+        if (!procName.isEmpty() && m_prog) {
+            Function *func = m_prog->getFunctionByName(procName);
+            proc           = (func && !func->isLib()) ? static_cast<UserProc *>(func) : nullptr;
+        }
+
+        SharedExp sub = readExp();
+        return check(sub != nullptr) ? Location::get(oper, sub, proc) : nullptr;
+    }
+
+    case ExpClass::Unary: {
+        SharedExp sub = readExp();
+        return check(sub != nullptr) ? Unary::get(oper, sub) : nullptr;
+    }
+
+    case ExpClass::Binary: {
+        SharedExp sub1 = readExp();
+        SharedExp sub2 = readExp();
+        return check(sub1 && sub2) ? Binary::get(oper, sub1, sub2) : nullptr;
+    }
+
+    case ExpClass::Ternary: {
+        SharedExp sub1 = readExp();
+        SharedExp sub2 = readExp();
+        SharedExp sub3 = readExp();
+        return check(sub1 && sub2 && sub3) ? Ternary::get(oper, sub1, sub2, sub3) : nullptr;
+    }
+
+    default: check(false); return nullptr;
+    }
+}
+
+
+void ProgSerializer::writeConstValue(const Const &c)
+{
+    // Save the value as it is stored in the constant, since the printed form
+    // of a constant depends on e.g. whether it is stored as an int or as a QWord.
+    m_stream << static_cast<quint8>(c.getValueKind());
+
+    switch (c.getValueKind()) {
+    case Const::ValueKind::Int: m_stream << static_cast<qint32>(c.getInt()); break;
+    case Const::ValueKind::Long: m_stream << static_cast<quint64>(c.getLong()); break;
+    case Const::ValueKind::Flt: m_stream << c.getFlt(); break;
+    case Const::ValueKind::Func: m_stream << c.getFuncName(); break;
+    case Const::ValueKind::Str:
+    case Const::ValueKind::RawStr: m_stream << c.getStr(); break;
+    }
+}
+
+
+std::shared_ptr<Const> ProgSerializer::readConstValue(OPER oper)
+{
+    quint8 valueIndex = 0;
+    m_stream >> valueIndex;
+
+    std::shared_ptr<Const> c;
+
+    switch (static_cast<Const::ValueKind>(valueIndex)) {
+    case Const::ValueKind::Int: {
+        qint32 value = 0;
+        m_stream >> value;
+        c = Const::get(static_cast<int>(value));
+        break;
+    }
+    case Const::ValueKind::Long: {
+        quint64 value = 0;
+        m_stream >> value;
+        c = Const::get(static_cast<QWord>(value));
+        break;
+    }
+    case Const::ValueKind::Flt: {
+        double value = 0.0;
+        m_stream >> value;
+        c = Const::get(value);
+        break;
+    }
+    case Const::ValueKind::Func: {
+        QString funcName;
+        m_stream >> funcName;
+
+        Function *func = m_prog ? m_prog->getFunctionByName(funcName) : nullptr;
+        if (!check(func != nullptr)) {
+            LOG_ERROR("Cannot restore pointer to unknown function '%1'", funcName);
+            return nullptr;
+        }
+
+        c = Const::get(func);
+        break;
+    }
+    case Const::ValueKind::Str:
+    case Const::ValueKind::RawStr: {
+        // Raw strings point into the binary image and are restored as normal strings.
+        QString value;
+        m_stream >> value;
+        c = Const::get(value);
+        break;
+    }
+    default: check(false); return nullptr;
+    }
+
+    // The constructors of Const only set the default operator for the value type.
+    c->setOper(oper);
+    return c;
+}
+
+
+void ProgSerializer::writeType(const SharedType &type)
+{
+    if (type == nullptr) {
+        m_stream << NULL_TYPE;
+        return;
+    }
+    else if (std::find(m_typesInProgress.begin(), m_typesInProgress.end(), type.get()) !=
+             m_typesInProgress.end()) {
+        // Recursive types can only be expressed via named types. Break the cycle here.
+        LOG_WARN("Cannot save recursive type '%1', saving as void", type->getCtype());
+        m_stream << static_cast<quint8>(TypeClass::Void);
+        return;
+    }
+
+    m_typesInProgress.push_back(type.get());
+    m_stream << static_cast<quint8>(type->getId());
+
+    switch (type->getId()) {
+    case TypeClass::Void:
+    case TypeClass::Boolean:
+    case TypeClass::Char: break;
+
+    case TypeClass::Func: {
+        Signature *sig = std::static_pointer_cast<FuncType>(type)->getSignature();
+        writeSignature(sig ? sig->shared_from_this() : nullptr);
+        break;
+    }
+
+    case TypeClass::Integer: {
+        auto intTy = std::static_pointer_cast<IntegerType>(type);
+        m_stream << static_cast<quint64>(intTy->getSize())
+                 << static_cast<qint8>(intTy->getSign());
+        break;
+    }
+
+    case TypeClass::Float:
+    case TypeClass::Size: m_stream << static_cast<quint64>(type->getSize()); break;
+
+    case TypeClass::Pointer:
+        writeType(std::static_pointer_cast<PointerType>(type)->getPointsTo());
+        break;
+
+    case TypeClass::Array: {
+        auto arrTy = std::static_pointer_cast<ArrayType>(type);
+        writeType(arrTy->getBaseType());
+        m_stream << static_cast<quint64>(arrTy->getLength());
+        break;
+    }
+
+    case TypeClass::Named:
+        m_stream << std::static_pointer_cast<NamedType>(type)->getName();
+        break;
+
+    case TypeClass::Compound: {
+        auto compTy = std::static_pointer_cast<CompoundType>(type);
+        m_stream << static_cast<quint32>(compTy->getNumMembers());
+
+        for (int i = 0; i < compTy->getNumMembers(); ++i) {
+            writeType(compTy->getMemberTypeByIdx(i));
+            m_stream << compTy->getMemberNameByIdx(i);
+        }
+        break;
+    }
+
+    case TypeClass::Union: {
+        auto unionTy = std::static_pointer_cast<UnionType>(type);
+        m_stream << static_cast<quint32>(unionTy->getEntries().size());
+
+        for (const auto &[memberTy, memberName] : unionTy->getEntries()) {
+            writeType(memberTy);
+            m_stream << memberName;
+        }
+        break;
+    }
+    }
+
+    m_typesInProgress.pop_back();
+}
+
+
+SharedType ProgSerializer::readType()
+{
+    quint8 typeClass = NULL_TYPE;
+    m_stream >> typeClass;
+
+    if (m_stream.status() != QDataStream::Ok || typeClass == NULL_TYPE) {
+        return nullptr;
+    }
+
+    switch (static_cast<TypeClass>(typeClass)) {
+    case TypeClass::Void: return VoidType::get();
+    case TypeClass::Boolean: return BooleanType::get();
+    case TypeClass::Char: return CharType::get();
+    case TypeClass::Func: return FuncType::get(readSignature());
+
+    case TypeClass::Integer: {
+        quint64 size = 0;
+        qint8 sign   = 0;
+        m_stream >> size >> sign;
+        return IntegerType::get(size, static_cast<Sign>(sign));
+    }
+
+    case TypeClass::Float: {
+        quint64 size = 0;
+        m_stream >> size;
+        return FloatType::get(size);
+    }
+
+    case TypeClass::Size: {
+        quint64 size = 0;
+        m_stream >> size;
+        return SizeType::get(size);
+    }
+
+    case TypeClass::Pointer: {
+        SharedType pointsTo = readType();
+        return check(pointsTo != nullptr) ? PointerType::get(pointsTo) : nullptr;
+    }
+
+    case TypeClass::Array: {
+        SharedType baseType = readType();
+        quint64 length      = 0;
+        m_stream >> length;
+        return check(baseType != nullptr) ? ArrayType::get(baseType, length) : nullptr;
+    }
+
+    case TypeClass::Named: {
+        QString name;
+        m_stream >> name;
+        return NamedType::get(name);
+    }
+
+    case TypeClass::Compound: {
+        quint32 numMembers = 0;
+        if (!readCount(numMembers)) {
+            return nullptr;
+        }
+
+        std::shared_ptr<CompoundType> compTy = CompoundType::get();
+        for (quint32 i = 0; i < numMembers && m_stream.status() == QDataStream::Ok; ++i) {
+            SharedType memberTy = readType();
+            QString memberName;
+            m_stream >> memberName;
+
+            if (!check(memberTy != nullptr)) {
+                return nullptr;
+            }
+
+            compTy->addMember(memberTy, memberName);
+        }
+
+        return compTy;
+    }
+
+    case TypeClass::Union: {
+        quint32 numMembers = 0;
+        if (!readCount(numMembers)) {
+            return nullptr;
+        }
+
+        std::shared_ptr<UnionType> unionTy = UnionType::get();
+        for (quint32 i = 0; i < numMembers && m_stream.status() == QDataStream::Ok; ++i) {
+            SharedType memberTy = readType();
+            QString memberName;
+            m_stream >> memberName;
+
+            if (!check(memberTy != nullptr)) {
+                return nullptr;
+            }
+
+            unionTy->addType(memberTy, memberName);
+        }
+
+        return unionTy;
+    }
+    }
+
+    check(false);
+    return nullptr;
+}
+
+
+void ProgSerializer::writeSignature(const std::shared_ptr<Signature> &sig)
+{
+    if (sig == nullptr) {
+        m_stream << static_cast<quint8>(SigClass::Null);
+        return;
+    }
+
+    using namespace CallingConvention;
+
+    SigClass sigClass = SigClass::Plain;
+    if (std::dynamic_pointer_cast<Win32TcSignature>(sig)) {
+        sigClass = SigClass::Win32Tc;
+    }
+    else if (std::dynamic_pointer_cast<Win32Signature>(sig)) {
+        sigClass = SigClass::Win32;
+    }
+    else if (std::dynamic_pointer_cast<StdC::X86Signature>(sig)) {
+        sigClass = SigClass::X86;
+    }
+    else if (std::dynamic_pointer_cast<StdC::PPCSignature>(sig)) {
+        sigClass = SigClass::PPC;
+    }
+    else if (std::dynamic_pointer_cast<StdC::ST20Signature>(sig)) {
+        sigClass = SigClass::ST20;
+    }
+    else if (std::dynamic_pointer_cast<CustomSignature>(sig)) {
+        sigClass = SigClass::Custom;
+    }
+
+    m_stream << static_cast<quint8>(sigClass);
+    m_stream << sig->getName() << sig->getSigFilePath() << sig->getPreferredName();
+    m_stream << sig->isUnknown() << sig->isForced() << sig->hasEllipsis();
+    m_stream << static_cast<quint16>(sig->getStackRegister());
+
+    m_stream << static_cast<quint32>(sig->getParameters().size());
+    for (const std::shared_ptr<Parameter> &param : sig->getParameters()) {
+        m_stream << param->getName() << param->getBoundMax();
+        writeType(param->getType());
+        writeExp(param->getExp());
+    }
+
+    m_stream << static_cast<quint32>(sig->getNumReturns());
+    for (int i = 0; i < sig->getNumReturns(); ++i) {
+        writeType(sig->getReturnType(i));
+        writeExp(sig->getReturnExp(i));
+    }
+}
+
+
+std::shared_ptr<Signature> ProgSerializer::readSignature()
+{
+    quint8 sigClass = static_cast<quint8>(SigClass::Null);
+    m_stream >> sigClass;
+
+    if (m_stream.status() != QDataStream::Ok ||
+        sigClass == static_cast<quint8>(SigClass::Null)) {
+        return nullptr;
+    }
+    else if (!check(sigClass <= static_cast<quint8>(SigClass::Custom))) {
+        return nullptr;
+    }
+
+    QString name, sigFile, preferredName;
+    bool unknown = false, forced = false, ellipsis = false;
+    quint16 spReg = 0;
+
+    m_stream >> name >> sigFile >> preferredName;
+    m_stream >> unknown >> forced >> ellipsis >> spReg;
+
+    // Read parameters and returns into a plain signature first, since the constructors
+    // of the calling convention specific signatures may add parameters or returns.
+    Signature sig(name);
+
+    quint32 numParams = 0;
+    if (!readCount(numParams)) {
+        return nullptr;
+    }
+
+    for (quint32 i = 0; i < numParams && m_stream.status() == QDataStream::Ok; ++i) {
+        QString paramName, boundMax;
+        m_stream >> paramName >> boundMax;
+
+        SharedType ty = readType();
+        SharedExp exp = readExp();
+
+        if (!check(ty != nullptr)) {
+            return nullptr;
+        }
+
+        sig.addParameter(std::make_shared<Parameter>(ty, paramName, exp, boundMax));
+    }
+
+    quint32 numReturns = 0;
+    if (!readCount(numReturns)) {
+        return nullptr;
+    }
+
+    for (quint32 i = 0; i < numReturns && m_stream.status() == QDataStream::Ok; ++i) {
+        SharedType ty = readType();
+        SharedExp exp = readExp();
+
+        if (!check(ty && exp)) {
+            return nullptr;
+        }
+
+        sig.Signature::addReturn(ty, exp);
+    }
+
+    if (m_stream.status() != QDataStream::Ok) {
+        return nullptr;
+    }
+
+    using namespace CallingConvention;
+    std::shared_ptr<Signature> result;
+
+    switch (static_cast<SigClass>(sigClass)) {
+    case SigClass::Plain: result = std::make_shared<Signature>(sig); break;
+    case SigClass::X86: result = std::make_shared<StdC::X86Signature>(sig); break;
+    case SigClass::Win32: result = std::make_shared<Win32Signature>(sig); break;
+    case SigClass::Win32Tc: result = std::make_shared<Win32TcSignature>(sig); break;
+    case SigClass::PPC: result = std::make_shared<StdC::PPCSignature>(sig); break;
+    case SigClass::ST20: result = std::make_shared<StdC::ST20Signature>(sig); break;
+    case SigClass::Custom: {
+        std::shared_ptr<CustomSignature> custom = std::make_shared<CustomSignature>(name);
+        custom->setSP(spReg);
+
+        // overwrite the return added by setSP
+        static_cast<Signature &>(*custom) = sig;
+        result                            = custom;
+        break;
+    }
+    case SigClass::Null: assert(false); return nullptr;
+    }
+
+    result->setSigFilePath(sigFile);
+    result->setPreferredName(preferredName);
+    result->setUnknown(unknown);
+    result->setForced(forced);
+    result->setHasEllipsis(ellipsis);
+
+    return result;
+}
+
+
+void ProgSerializer::writeInsn(const MachineInstruction &insn)
+{
+    m_stream << static_cast<quint64>(insn.m_addr.value()) << insn.m_id << insn.m_size
+             << insn.m_groups;
+    m_stream << QByteArray(insn.m_mnem.data()) << QByteArray(insn.m_opstr.data());
+    m_stream << insn.m_templateName;
+
+    m_stream << static_cast<quint32>(insn.m_operands.size());
+    for (const SharedExp &operand : insn.m_operands) {
+        writeExp(operand);
+    }
+}
+
+
+bool ProgSerializer::readInsn(MachineInstruction &insn)
+{
+    quint64 addr = 0;
+    QByteArray mnem, opstr;
+
+    m_stream >> addr >> insn.m_id >> insn.m_size >> insn.m_groups;
+    m_stream >> mnem >> opstr >> insn.m_templateName;
+
+    insn.m_addr = Address(addr);
+    std::strncpy(insn.m_mnem.data(), mnem.constData(), MNEM_SIZE);
+    std::strncpy(insn.m_opstr.data(), opstr.constData(), OPSTR_SIZE);
+    insn.m_mnem[MNEM_SIZE - 1]   = '\0';
+    insn.m_opstr[OPSTR_SIZE - 1] = '\0';
+
+    // The template ID depends on the SSL file loaded by the decoder, so it is looked up again
+    insn.m_templateID = -1;
+
+    quint32 numOperands = 0;
+    if (!readCount(numOperands)) {
+        return false;
+    }
+
+    insn.m_operands.clear();
+    for (quint32 i = 0; i < numOperands && m_stream.status() == QDataStream::Ok; ++i) {
+        SharedExp operand = readExp();
+        if (!check(operand != nullptr)) {
+            return false;
+        }
+
+        insn.m_operands.push_back(operand);
+    }
+
+    return m_stream.status() == QDataStream::Ok;
+}
+
+
+void ProgSerializer::writeBB(const BasicBlock *bb)
+{
+    m_stream << static_cast<quint64>(bb->getLowAddr().value()) << bb->isComplete();
+
+    if (bb->isComplete()) {
+        m_stream << static_cast<qint32>(bb->getType());
+        m_stream << static_cast<quint32>(bb->getInsns().size());
+
+        for (const MachineInstruction &insn : bb->getInsns()) {
+            writeInsn(insn);
+        }
+
+        const Address procAddr = bb->getProc() ? bb->getProc()->getEntryAddress()
+                                               : Address::INVALID;
+        m_stream << static_cast<quint64>(procAddr.value());
+    }
+
+    m_stream << static_cast<quint32>(bb->getNumSuccessors());
+    for (const BasicBlock *succ : bb->getSuccessors()) {
+        m_stream << static_cast<quint64>(succ->getLowAddr().value());
+    }
+}
+
+
+bool ProgSerializer::readCount(quint32 &count, std::size_t minElementSize)
+{
+    m_stream >> count;
+
+    // Make sure a corrupt count cannot make us allocate more memory than the size of the file
+    // warrants. Sequential devices do not know how much data is left.
+    const QIODevice *device = m_stream.device();
+    if (!check(device != nullptr && !device->isSequential())) {
+        return false;
+    }
+
+    const quint64 remaining = static_cast<quint64>(std::max<qint64>(device->bytesAvailable(), 0));
+    return check(static_cast<quint64>(count) * minElementSize <= remaining);
+}
+
+
+bool ProgSerializer::check(bool condition)
+{
+    if (!condition && m_stream.status() == QDataStream::Ok) {
+        m_stream.setStatus(QDataStream::ReadCorruptData);
+    }
+
+    return condition && m_stream.status() == QDataStream::Ok;
+}
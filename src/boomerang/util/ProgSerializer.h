@@ -0,0 +1,132 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/ssl/exp/ExpHelp.h"
+#include "boomerang/ssl/exp/Operator.h"
+#include "boomerang/ssl/type/Type.h"
+
+#include <QByteArray>
+#include <QString>
+
+#include <memory>
+#include <vector>
+
+
+class BasicBlock;
+class Const;
+class MachineInstruction;
+class Prog;
+class Signature;
+
+class QDataStream;
+
+
+/**
+ * Reads and writes decode caches, as well as the expressions, types and signatures
+ * they consist of.
+ *
+ * A decode cache starts with a header that identifies the binary file the program was
+ * loaded from. It is followed by the decoded program: Modules, functions and their signatures,
+ * entry points, global variables and the low level CFG including all machine instructions.
+ * This is everything that is needed to start decompilation without disassembling
+ * the binary file again.
+ *
+ * \note A decode cache is not a save file: The high level IR of UserProcs is not written.
+ * Procedures that were decompiled partially or completely are written in decoded state,
+ * i.e. they will be decompiled again after loading the decode cache.
+ *
+ * Errors are reported via the status of the underlying QDataStream.
+ * Decode caches can only be read from random access devices (e.g. files),
+ * so that corrupt element counts can be detected before allocating memory.
+ */
+class BOOMERANG_API ProgSerializer
+{
+public:
+    /// Identifies Boomerang decode caches ("BMDC")
+    static constexpr const quint32 MAGIC = 0x424D4443;
+
+    /// Increment this every time the serialization format changes.
+    static constexpr const quint32 FORMAT_VERSION = 2;
+
+public:
+    ProgSerializer(QDataStream &stream);
+
+public:
+    /**
+     * Write the decode cache header.
+     * \param binaryFilePath path to the binary file the program was loaded from,
+     *                       relative to the directory of the decode cache
+     * \param binaryChecksum checksum of the contents of the binary file
+     */
+    bool writeHeader(const QString &binaryFilePath, const QByteArray &binaryChecksum);
+
+    /**
+     * Read the decode cache header.
+     * \returns false if the stream does not contain a decode cache with a supported version.
+     */
+    bool readHeader(QString &binaryFilePath, QByteArray &binaryChecksum);
+
+    /// Write the decoded state of \p prog.
+    bool writeDecodedProg(const Prog *prog);
+
+    /**
+     * Restore the decoded state of \p prog. \p prog must have been created from the same
+     * binary file as the program that was written. Existing functions are reused.
+     */
+    bool readDecodedProg(Prog *prog);
+
+public:
+    void writeExp(const SharedExp &exp);
+
+    /// \returns the expression read, or nullptr on error or if a null expression was written.
+    SharedExp readExp();
+
+    void writeType(const SharedType &type);
+
+    /// \returns the type read, or nullptr on error or if a null type was written.
+    SharedType readType();
+
+    void writeSignature(const std::shared_ptr<Signature> &sig);
+
+    /// \returns the signature read, or nullptr on error or if a null signature was written.
+    std::shared_ptr<Signature> readSignature();
+
+private:
+    void writeConstValue(const Const &c);
+    std::shared_ptr<Const> readConstValue(OPER oper);
+
+    void writeInsn(const MachineInstruction &insn);
+    bool readInsn(MachineInstruction &insn);
+
+    void writeBB(const BasicBlock *bb);
+
+    /**
+     * Read the number of elements of a list into \p count.
+     * Each element must take at least \p minElementSize bytes in the stream.
+     * \returns false and marks the stream as corrupt if there are not enough bytes left
+     * for \p count elements.
+     */
+    bool readCount(quint32 &count, std::size_t minElementSize = 1);
+
+    /// \returns true if the stream is still valid; marks the stream as corrupt otherwise.
+    bool check(bool condition);
+
+private:
+    QDataStream &m_stream;
+
+    /// The program being read, for looking up functions referenced by expressions.
+    Prog *m_prog = nullptr;
+
+    /// Types currently being written, to break reference cycles
+    std::vector<const Type *> m_typesInProgress;
+};
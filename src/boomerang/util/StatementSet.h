@@ -142,8 +142,8 @@ public:
             return nullptr;
         }
 
-        std::shared_ptr<Assign> as(new Assign(loc, Terminal::get(opWild)));
-        iterator ff = m_set.find(as);
+        // Sorter must support lookup by location without creating a temporary assignment
+        iterator ff = m_set.find(loc);
 
         return (ff != end()) ? *ff : nullptr;
     }
@@ -155,7 +155,12 @@ private:
 
 struct BOOMERANG_API lessAssign
 {
+    /// Allows looking up assignments by their left hand side
+    typedef void is_transparent;
+
     bool operator()(const std::shared_ptr<Assign> &as1, const std::shared_ptr<Assign> &as2) const;
+    bool operator()(const std::shared_ptr<Assign> &as, const SharedExp &loc) const;
+    bool operator()(const SharedExp &loc, const std::shared_ptr<Assign> &as) const;
 };
 
 
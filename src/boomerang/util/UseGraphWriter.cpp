@@ -14,7 +14,6 @@
 #include "boomerang/db/proc/UserProc.h"
 #include "boomerang/ssl/exp/RefExp.h"
 #include "boomerang/util/LocationSet.h"
-#include "boomerang/util/StatementList.h"
 #include "boomerang/util/log/Log.h"
 
 #include <QFile>
@@ -32,10 +31,8 @@ void UseGraphWriter::writeUseGraph(const UserProc *proc, const QString &filePath
 
     OStream out(&file);
     out << "digraph " << proc->getName() << " {\n";
-    StatementList stmts;
-    proc->getStatements(stmts);
 
-    for (SharedStmt s : stmts) {
+    for (const SharedStmt &s : proc->getStatementRange()) {
         if (s->isPhi()) {
             out << s->getNumber() << " [shape=diamond];\n";
         }
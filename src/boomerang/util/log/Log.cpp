@@ -17,10 +17,13 @@
 #include "boomerang/util/Util.h"
 #include "boomerang/util/log/ConsoleLogSink.h"
 #include "boomerang/util/log/FileLogSink.h"
+#include "boomerang/util/log/LogWriter.h"
 
 #include <QDir>
 #include <QFileInfo>
 
+#include <cstdlib>
+
 
 static Log *g_log = nullptr;
 
@@ -36,11 +39,14 @@ Log::Log(LogLevel level)
         m_fileNameOffset += (p - lastSrc);
         lastSrc = p;
     }
+
+    m_writer = std::make_unique<LogWriter>([this](const QString &msg) { writeToSinks(msg); });
 }
 
 
 Log::~Log()
 {
+    m_writer.reset(); // writes all remaining messages
     flush();
 }
 
@@ -49,6 +55,9 @@ Log &Log::getOrCreateLog()
 {
     if (!g_log) {
         g_log = new Log(LogLevel::Default);
+
+        // The default log is never destroyed, so write all remaining messages on exit.
+        std::atexit([]() { g_log->flush(); });
     }
 
     return *g_log;
@@ -57,6 +66,12 @@ Log &Log::getOrCreateLog()
 
 void Log::flush()
 {
+    if (m_writer) {
+        m_writer->waitForWritten();
+    }
+
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+
     for (std::unique_ptr<ILogSink> &s : m_sinks) {
         s->flush();
     }
@@ -65,19 +80,46 @@ void Log::flush()
 
 void Log::log(LogLevel level, const char *file, int line, const QString &msg)
 {
-    const QStringList msgLines = msg.split('\n');
+    if (!canLog(level)) {
+        return;
+    }
 
-    for (const QString &msgLine : msgLines) {
-        if (canLog(level)) {
-            logDirect(level, file, line, msgLine);
+    // Format all lines first so they are queued as a single message.
+    QString text;
+    int lineStart = 0;
+
+    for (;;) {
+        const int lineEnd = msg.indexOf('\n', lineStart);
+        if (lineEnd < 0) {
+            text += formatLine(level, file, line, msg.mid(lineStart));
+            break;
         }
+
+        text += formatLine(level, file, line, msg.mid(lineStart, lineEnd - lineStart));
+        lineStart = lineEnd + 1;
     }
 
-    flush();
+    write(std::move(text));
+
+    if (level == LogLevel::Fatal) {
+        flush();
+        abort();
+    }
 }
 
 
 void Log::logDirect(LogLevel level, const char *file, int line, const QString &msg)
+{
+    write(formatLine(level, file, line, msg));
+
+    if (level == LogLevel::Fatal) {
+        flush();
+        abort();
+    }
+}
+
+
+QString Log::formatLine(LogLevel level, const char *file, int line, const QString &msg)
 {
     char prettyFile[40]; // truncated file name
     truncateFileName(prettyFile, 40, file);
@@ -88,16 +130,14 @@ void Log::logDirect(LogLevel level, const char *file, int line, const QString &m
 #endif
 
     const QString pattern = "%1 | %2 | %3 | %4\n";
-    this->write(pattern.arg(levelToString(level)).arg(prettyFilePath).arg(line, 4).arg(msg));
-
-    if (level == LogLevel::Fatal) {
-        abort();
-    }
+    return pattern.arg(levelToString(level)).arg(prettyFilePath).arg(line, 4).arg(msg);
 }
 
 
 void Log::addLogSink(std::unique_ptr<ILogSink> s)
 {
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+
     assert(s != nullptr);
 
     if (std::find(m_sinks.begin(), m_sinks.end(), s) == m_sinks.end()) {
@@ -121,6 +161,7 @@ void Log::removeAllSinks()
 {
     flush();
 
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
     m_sinks.clear();
 }
 
@@ -220,8 +261,21 @@ QString Log::collectArg(const QString &msg, const LocationSet *l)
 }
 
 
-void Log::write(const QString &msg)
+void Log::write(QString msg)
+{
+    if (m_writer) {
+        m_writer->write(std::move(msg));
+    }
+    else {
+        writeToSinks(msg); // the log is being destroyed
+    }
+}
+
+
+void Log::writeToSinks(const QString &msg)
 {
+    std::lock_guard<std::mutex> lock(m_sinkMutex);
+
     for (std::unique_ptr<ILogSink> &s : m_sinks) {
         s->write(msg);
     }
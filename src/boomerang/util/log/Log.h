@@ -14,10 +14,12 @@
 #include "boomerang/util/Types.h"
 
 #include <memory>
+#include <mutex>
 #include <vector>
 
 
 class ILogSink;
+class LogWriter;
 class Statement;
 class Exp;
 class LocationSet;
@@ -45,6 +47,11 @@ enum class LogLevel
 /**
  * Class for logging messages, warnings and errors.
  * Logs can have multiple LogSinks to enable writing to multiple targets simultaneously.
+ * Logging is thread safe; multi-line messages are never interleaved with other messages.
+ *
+ * Messages are written to the log sinks asynchronously on a background thread, in batches.
+ * Call \ref flush to make sure all messages logged so far have been written.
+ * Fatal messages are always flushed.
  *
  * Log messages have different levels (see \ref LogLevel).
  * The default behavior is to omit verbose log messages from being logged;
@@ -104,6 +111,8 @@ public:
         log(level, file, line, collectArgs(msg, args...));
     }
 
+    /// Wait until all messages logged so far have been written to the log sinks,
+    /// and flush the log sinks.
     void flush();
 
     /// Add a log sink / target. Takes ownership of the pointer.
@@ -175,8 +184,14 @@ private:
         return collectArgs(collectArg(msg, arg), args...);
     }
 
-    /// Write the raw string \p msg to all log sinks.
-    void write(const QString &msg);
+    /// Format a single line of a log message.
+    QString formatLine(LogLevel level, const char *file, int line, const QString &msg);
+
+    /// Queue the raw string \p msg for writing to all log sinks.
+    void write(QString msg);
+
+    /// Write the raw string \p msg to all log sinks. Called by the log writer.
+    void writeToSinks(const QString &msg);
 
     /// Given a log level, get the name of the log level as a string.
     QString levelToString(LogLevel level);
@@ -189,6 +204,9 @@ private:
     size_t m_fileNameOffset;
     LogLevel m_level = LogLevel::Default;
     std::vector<std::unique_ptr<ILogSink>> m_sinks;
+    std::mutex m_sinkMutex; ///< Serializes access to the log sinks
+
+    std::unique_ptr<LogWriter> m_writer; ///< Writes messages in the background
 };
 
 template<>
@@ -0,0 +1,97 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LogQueue.h"
+
+#include <cstdint>
+
+
+// This is the bounded MPMC queue by D. Vyukov: Each slot has a sequence number telling whether
+// it is ready to be written to (seq == pos) or to be read from (seq == pos + 1) at position pos.
+
+LogQueue::LogQueue(std::size_t capacity)
+    : m_pushPos(0)
+    , m_popPos(0)
+{
+    std::size_t cap = 2;
+    while (cap < capacity) {
+        cap *= 2;
+    }
+
+    m_slots.reset(new Slot[cap]);
+    m_mask = cap - 1;
+
+    for (std::size_t i = 0; i < cap; ++i) {
+        m_slots[i].seq.store(i, std::memory_order_relaxed);
+    }
+}
+
+
+LogQueue::~LogQueue()
+{
+}
+
+
+bool LogQueue::tryPush(QString &msg)
+{
+    std::size_t pos = m_pushPos.load(std::memory_order_relaxed);
+    Slot *slot      = nullptr;
+
+    for (;;) {
+        slot                  = &m_slots[pos & m_mask];
+        const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+        const intptr_t diff   = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos);
+
+        if (diff == 0) {
+            if (m_pushPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            return false; // full
+        }
+        else {
+            pos = m_pushPos.load(std::memory_order_relaxed);
+        }
+    }
+
+    slot->msg = std::move(msg);
+    slot->seq.store(pos + 1, std::memory_order_release);
+    return true;
+}
+
+
+bool LogQueue::tryPop(QString &msg)
+{
+    std::size_t pos = m_popPos.load(std::memory_order_relaxed);
+    Slot *slot      = nullptr;
+
+    for (;;) {
+        slot                  = &m_slots[pos & m_mask];
+        const std::size_t seq = slot->seq.load(std::memory_order_acquire);
+        const intptr_t diff   = static_cast<intptr_t>(seq) - static_cast<intptr_t>(pos + 1);
+
+        if (diff == 0) {
+            if (m_popPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (diff < 0) {
+            return false; // empty
+        }
+        else {
+            pos = m_popPos.load(std::memory_order_relaxed);
+        }
+    }
+
+    msg = std::move(slot->msg);
+    slot->msg.clear();
+    slot->seq.store(pos + m_mask + 1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,64 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+
+#include <QString>
+
+#include <atomic>
+#include <memory>
+
+
+/**
+ * Bounded lock-free queue of log messages (a ring buffer).
+ * Any number of threads may push and pop messages concurrently.
+ * Messages are popped in the order in which they were pushed.
+ */
+class BOOMERANG_API LogQueue
+{
+public:
+    /// \param capacity Maximum number of messages in the queue.
+    /// Rounded up to the next power of 2.
+    explicit LogQueue(std::size_t capacity);
+    LogQueue(const LogQueue &other) = delete;
+    LogQueue(LogQueue &&other)      = delete;
+
+    ~LogQueue();
+
+    LogQueue &operator=(const LogQueue &other) = delete;
+    LogQueue &operator=(LogQueue &&other) = delete;
+
+public:
+    std::size_t getCapacity() const { return m_mask + 1; }
+
+    /// Append \p msg to the queue.
+    /// \returns false if the queue is full. In this case, \p msg is not modified.
+    bool tryPush(QString &msg);
+
+    /// Remove the oldest message from the queue and store it in \p msg.
+    /// \returns false if the queue is empty.
+    bool tryPop(QString &msg);
+
+private:
+    struct Slot
+    {
+        std::atomic<std::size_t> seq; ///< Position this slot is ready for
+        QString msg;
+    };
+
+    std::unique_ptr<Slot[]> m_slots;
+    std::size_t m_mask;
+
+    // Keep producers and consumers on different cache lines
+    alignas(64) std::atomic<std::size_t> m_pushPos;
+    alignas(64) std::atomic<std::size_t> m_popPos;
+};
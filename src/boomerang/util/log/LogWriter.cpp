@@ -0,0 +1,127 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LogWriter.h"
+
+#include <chrono>
+
+
+/// Number of messages the queue can hold before logging threads have to wait
+static constexpr const std::size_t QUEUE_CAPACITY = 8192;
+
+/// Maximum number of messages written to the log sinks at once
+static constexpr const std::size_t MAX_BATCH_SIZE = 512;
+
+/// If nobody asks for the messages to be written, the writer thread writes them in this interval.
+static constexpr const std::chrono::milliseconds WRITE_INTERVAL(50);
+
+
+LogWriter::LogWriter(WriteFunc write)
+    : m_write(std::move(write))
+    , m_queue(QUEUE_CAPACITY)
+{
+    m_thread = std::thread(&LogWriter::run, this);
+}
+
+
+LogWriter::~LogWriter()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+
+    m_wakeWriter.notify_one();
+    m_thread.join();
+
+    // Write messages that were queued while the writer thread was shutting down.
+    writeQueued();
+}
+
+
+void LogWriter::write(QString msg)
+{
+    // Count the message before it can be written. Otherwise the writer thread might write it
+    // first, and waitForWritten would count it in place of a message that is still queued.
+    m_numQueued++;
+
+    while (!m_queue.tryPush(msg)) {
+        // The queue is full; let the writer catch up.
+        m_wakeWriter.notify_one();
+        std::this_thread::yield();
+    }
+}
+
+
+void LogWriter::waitForWritten()
+{
+    if (std::this_thread::get_id() == m_thread.get_id()) {
+        return; // A log sink is logging; waiting for ourselves would deadlock.
+    }
+
+    const uint64 target = m_numQueued.load();
+
+    std::unique_lock<std::mutex> lock(m_mutex);
+
+    // Messages counted by other threads might not be in the queue yet,
+    // so keep waking up the writer until they have been written.
+    while (m_numWritten.load() < target) {
+        m_wakeWriter.notify_one();
+        m_written.wait_for(lock, WRITE_INTERVAL);
+    }
+}
+
+
+void LogWriter::run()
+{
+    for (;;) {
+        if (writeQueued()) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(m_mutex);
+        if (m_stop) {
+            break;
+        }
+
+        m_wakeWriter.wait_for(lock, WRITE_INTERVAL);
+    }
+}
+
+
+bool LogWriter::writeQueued()
+{
+    QString batch;
+    QString msg;
+    bool wroteAny = false;
+
+    for (;;) {
+        std::size_t batchSize = 0;
+        batch.clear();
+
+        while (batchSize < MAX_BATCH_SIZE && m_queue.tryPop(msg)) {
+            batch += msg;
+            batchSize++;
+        }
+
+        if (batchSize == 0) {
+            return wroteAny;
+        }
+
+        m_write(batch);
+        wroteAny = true;
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_numWritten += batchSize;
+        }
+
+        m_written.notify_all();
+    }
+}
@@ -0,0 +1,75 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/core/BoomerangAPI.h"
+#include "boomerang/util/Types.h"
+#include "boomerang/util/log/LogQueue.h"
+
+#include <QString>
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+
+/**
+ * Writes log messages on a background thread, so logging threads do not have to wait for
+ * slow log sinks. Messages are collected in a \ref LogQueue and written in batches.
+ */
+class BOOMERANG_API LogWriter
+{
+public:
+    /// Called on the writer thread with a batch of one or more messages.
+    typedef std::function<void(const QString &)> WriteFunc;
+
+public:
+    explicit LogWriter(WriteFunc write);
+    LogWriter(const LogWriter &other) = delete;
+    LogWriter(LogWriter &&other)      = delete;
+
+    /// Writes all remaining messages and stops the writer thread.
+    ~LogWriter();
+
+    LogWriter &operator=(const LogWriter &other) = delete;
+    LogWriter &operator=(LogWriter &&other) = delete;
+
+public:
+    /// Queue \p msg for writing. Only blocks if the queue is full.
+    void write(QString msg);
+
+    /// Wait until all messages passed to \ref write before this call have been written.
+    void waitForWritten();
+
+private:
+    /// Main loop of the writer thread
+    void run();
+
+    /// Write all messages in the queue in batches.
+    /// \returns true if at least one message was written.
+    bool writeQueued();
+
+private:
+    WriteFunc m_write;
+    LogQueue m_queue;
+
+    std::atomic<uint64> m_numQueued{ 0 };  ///< Number of messages passed to write() so far
+    std::atomic<uint64> m_numWritten{ 0 }; ///< Number of messages written so far
+    std::atomic<bool> m_stop{ false };
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeWriter; ///< Notified when there is something to write
+    std::condition_variable m_written;    ///< Notified when a batch was written
+
+    std::thread m_thread;
+};
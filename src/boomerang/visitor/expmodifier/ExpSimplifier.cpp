@@ -213,12 +213,12 @@ SharedExp ExpSimplifier::postModify(const std::shared_ptr<Binary> &exp)
     if (exp->getOper() == opEquals && *exp->getSubExp1() == *exp->getSubExp2()) {
         // x == x: result is true
         changed = true;
-        return std::make_shared<Terminal>(opTrue);
+        return Terminal::get(opTrue);
     }
     else if (exp->getOper() == opNotEqual && *exp->getSubExp1() == *exp->getSubExp2()) {
         // x != x: result is false
         changed = true;
-        return std::make_shared<Terminal>(opFalse);
+        return Terminal::get(opFalse);
     }
 
     // Might want to commute to put an integer constant on the RHS
@@ -0,0 +1,314 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "Benchmark.h"
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/passes/PassProfiler.h"
+
+#include <QDir>
+#include <QFileInfo>
+
+#include <algorithm>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#if defined(__unix__) || defined(__APPLE__)
+#    include <sys/resource.h>
+#endif
+
+
+/// Differences in wall time below this are considered noise.
+static constexpr const double MIN_TIME_DIFF_MS = 1.0;
+
+
+/// Reset the peak RSS of the process to the current RSS, if supported by the OS.
+static void resetPeakRSS()
+{
+#if defined(__linux__)
+    std::ofstream clearRefs("/proc/self/clear_refs");
+    if (clearRefs) {
+        clearRefs << "5";
+    }
+#endif
+}
+
+
+/// \returns the peak RSS of the process in KiB since the last call to resetPeakRSS,
+/// or since the start of the process if the peak RSS cannot be reset.
+static uint64 getPeakRSSKiB()
+{
+#if defined(__linux__)
+    std::ifstream status("/proc/self/status");
+    std::string line;
+
+    while (std::getline(status, line)) {
+        if (line.compare(0, 6, "VmHWM:") == 0) {
+            std::istringstream ist(line.substr(6));
+            uint64 peakKiB = 0;
+            ist >> peakKiB;
+            return peakKiB;
+        }
+    }
+
+    return 0;
+#elif defined(__APPLE__)
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<uint64>(usage.ru_maxrss) / 1024 : 0;
+#elif defined(__unix__)
+    struct rusage usage;
+    return getrusage(RUSAGE_SELF, &usage) == 0 ? static_cast<uint64>(usage.ru_maxrss) : 0;
+#else
+    return 0;
+#endif
+}
+
+
+template<typename Func>
+static bool measurePhase(PhaseResult &result, Func func)
+{
+    typedef std::chrono::steady_clock Clock;
+
+    resetPeakRSS();
+    const uint64 allocsBefore     = PassProfiler::getTotalNumAllocations();
+    const Clock::time_point start = Clock::now();
+
+    const bool ok = func();
+
+    result.wallTimeMs = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+    result.numAllocs  = PassProfiler::getTotalNumAllocations() - allocsBefore;
+    result.peakRSSKiB = getPeakRSSKiB();
+    return ok;
+}
+
+
+template<typename T>
+static T median(std::vector<T> values)
+{
+    std::sort(values.begin(), values.end());
+    return values[values.size() / 2];
+}
+
+
+Benchmark::Benchmark(const QString &samplesDir, const QString &outputDir)
+    : m_samplesDir(samplesDir)
+    , m_outputDir(outputDir)
+{
+}
+
+
+const char *Benchmark::getPhaseName(BenchmarkPhase phase)
+{
+    switch (phase) {
+    case BenchmarkPhase::Load: return "load";
+    case BenchmarkPhase::Decode: return "decode";
+    case BenchmarkPhase::Decompile: return "decompile";
+    case BenchmarkPhase::GenerateCode: return "generateCode";
+    case BenchmarkPhase::NUM_PHASES: break;
+    }
+
+    return "unknown";
+}
+
+
+bool Benchmark::run(const QStringList &sampleNames)
+{
+    bool allOk = true;
+    m_results.clear();
+
+    for (const QString &sampleName : sampleNames) {
+        SampleResult result;
+        result.name = sampleName;
+        result.ok   = true;
+
+        const QString samplePath = QDir(m_samplesDir).absoluteFilePath(sampleName);
+        std::vector<std::vector<PhaseResult>> runs;
+
+        std::cout << sampleName.toStdString() << " " << std::flush;
+
+        for (int i = 0; i < m_numRuns; ++i) {
+            std::vector<PhaseResult> phases;
+
+            if (!runOnce(samplePath, phases)) {
+                result.ok = false;
+                break;
+            }
+
+            runs.push_back(phases);
+            std::cout << "." << std::flush;
+        }
+
+        std::cout << (result.ok ? " ok" : " failed") << std::endl;
+
+        if (!result.ok) {
+            allOk = false;
+            m_results.push_back(result);
+            continue;
+        }
+
+        for (int p = 0; p < static_cast<int>(BenchmarkPhase::NUM_PHASES); ++p) {
+            std::vector<double> wallTimes;
+            std::vector<uint64> numAllocs;
+            PhaseResult &phase = result.phases[p];
+
+            for (const std::vector<PhaseResult> &run : runs) {
+                wallTimes.push_back(run[p].wallTimeMs);
+                numAllocs.push_back(run[p].numAllocs);
+                phase.peakRSSKiB = std::max(phase.peakRSSKiB, run[p].peakRSSKiB);
+            }
+
+            phase.wallTimeMs = median(wallTimes);
+            phase.numAllocs  = median(numAllocs);
+        }
+
+        m_results.push_back(result);
+    }
+
+    return allOk;
+}
+
+
+bool Benchmark::runOnce(const QString &samplePath, std::vector<PhaseResult> &phases) const
+{
+    phases.resize(static_cast<int>(BenchmarkPhase::NUM_PHASES));
+
+    const QString sampleName = QDir(m_samplesDir).relativeFilePath(samplePath);
+    const QString outputDir  = QDir(m_outputDir).absoluteFilePath(sampleName);
+
+    Project project;
+    project.getSettings()->setOutputDirectory(outputDir + "/");
+    project.getSettings()->numThreads = m_numThreads;
+    project.loadPlugins();
+
+    const bool ok = measurePhase(phases[static_cast<int>(BenchmarkPhase::Load)], [&]() {
+        return project.loadBinaryFile(samplePath);
+    });
+
+    if (!ok) {
+        return false;
+    }
+
+    project.getProg()->setName(QFileInfo(samplePath).baseName());
+
+    return measurePhase(phases[static_cast<int>(BenchmarkPhase::Decode)],
+                        [&]() { return project.decodeBinaryFile(); }) &&
+           measurePhase(phases[static_cast<int>(BenchmarkPhase::Decompile)],
+                        [&]() { return project.decompileBinaryFile(); }) &&
+           measurePhase(phases[static_cast<int>(BenchmarkPhase::GenerateCode)],
+                        [&]() { return project.generateCode(); });
+}
+
+
+QJsonObject Benchmark::toJson() const
+{
+    QJsonObject samples;
+
+    for (const SampleResult &result : m_results) {
+        QJsonObject sample;
+        sample["ok"] = result.ok;
+
+        if (result.ok) {
+            for (int p = 0; p < static_cast<int>(BenchmarkPhase::NUM_PHASES); ++p) {
+                const PhaseResult &phase = result.phases[p];
+
+                QJsonObject phaseObj;
+                phaseObj["wallTimeMs"] = phase.wallTimeMs;
+                phaseObj["peakRSSKiB"] = static_cast<double>(phase.peakRSSKiB);
+                phaseObj["numAllocs"]  = static_cast<double>(phase.numAllocs);
+
+                sample[getPhaseName(static_cast<BenchmarkPhase>(p))] = phaseObj;
+            }
+        }
+
+        samples[result.name] = sample;
+    }
+
+    QJsonObject root;
+    root["numRuns"]    = m_numRuns;
+    root["numThreads"] = m_numThreads;
+    root["samples"]    = samples;
+    return root;
+}
+
+
+/// \returns true if \p current is worse than \p base by more than \p tolerance.
+static bool isRegression(double current, double base, double tolerance, double minDiff)
+{
+    return base > 0.0 && current > base * (1.0 + tolerance) && current - base > minDiff;
+}
+
+
+static void printRegression(const SampleResult &result, BenchmarkPhase phase, const char *metric,
+                            double current, double base)
+{
+    std::cout << "  " << result.name.toStdString() << " " << Benchmark::getPhaseName(phase) << ": "
+              << metric << " " << std::fixed << std::setprecision(1) << base << " -> " << current
+              << " (+" << std::setprecision(0) << (current / base - 1.0) * 100.0 << "%)"
+              << std::endl;
+}
+
+
+bool Benchmark::compareToBaseline(const QJsonObject &baseline, double tolerance) const
+{
+    const QJsonObject baseSamples = baseline["samples"].toObject();
+    int numRegressions            = 0;
+
+    std::cout << "Comparing against baseline (tolerance " << tolerance * 100.0 << "%)"
+              << std::endl;
+
+    for (const SampleResult &result : m_results) {
+        const QJsonObject baseSample = baseSamples[result.name].toObject();
+
+        if (baseSample.isEmpty() || !baseSample["ok"].toBool()) {
+            std::cout << "  " << result.name.toStdString() << ": no baseline" << std::endl;
+            continue;
+        }
+        else if (!result.ok) {
+            std::cout << "  " << result.name.toStdString() << ": failed" << std::endl;
+            numRegressions++;
+            continue;
+        }
+
+        for (int p = 0; p < static_cast<int>(BenchmarkPhase::NUM_PHASES); ++p) {
+            const BenchmarkPhase phase  = static_cast<BenchmarkPhase>(p);
+            const QJsonObject basePhase = baseSample[getPhaseName(phase)].toObject();
+            const PhaseResult &current  = result.phases[p];
+
+            const double baseTime   = basePhase["wallTimeMs"].toDouble();
+            const double baseRSS    = basePhase["peakRSSKiB"].toDouble();
+            const double baseAllocs = basePhase["numAllocs"].toDouble();
+
+            if (isRegression(current.wallTimeMs, baseTime, tolerance, MIN_TIME_DIFF_MS)) {
+                printRegression(result, phase, "wall time (ms)", current.wallTimeMs, baseTime);
+                numRegressions++;
+            }
+
+            if (isRegression(static_cast<double>(current.peakRSSKiB), baseRSS, tolerance, 0.0)) {
+                printRegression(result, phase, "peak RSS (KiB)",
+                                static_cast<double>(current.peakRSSKiB), baseRSS);
+                numRegressions++;
+            }
+
+            if (isRegression(static_cast<double>(current.numAllocs), baseAllocs, tolerance, 0.0)) {
+                printRegression(result, phase, "allocations",
+                                static_cast<double>(current.numAllocs), baseAllocs);
+                numRegressions++;
+            }
+        }
+    }
+
+    std::cout << numRegressions << " regression(s) found." << std::endl;
+    return numRegressions == 0;
+}
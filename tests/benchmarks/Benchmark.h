@@ -0,0 +1,99 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "boomerang/util/Types.h"
+
+#include <QJsonObject>
+#include <QString>
+#include <QStringList>
+
+#include <array>
+#include <vector>
+
+
+/// The phases of a decompilation that are measured separately.
+enum class BenchmarkPhase
+{
+    Load = 0,
+    Decode,
+    Decompile,
+    GenerateCode,
+    NUM_PHASES
+};
+
+
+/// Measurements of a single phase
+struct PhaseResult
+{
+    double wallTimeMs = 0.0; ///< Wall clock time in milliseconds
+    uint64 peakRSSKiB = 0;   ///< Peak resident set size in KiB (0 if not available)
+    uint64 numAllocs  = 0;   ///< Number of heap allocations (0 if not counted)
+};
+
+
+/// Measurements of all phases for a single sample binary, aggregated over all runs.
+struct SampleResult
+{
+    QString name; ///< path relative to the samples directory, e.g. "x86/hello"
+    bool ok = false;
+    std::array<PhaseResult, static_cast<int>(BenchmarkPhase::NUM_PHASES)> phases;
+};
+
+
+/**
+ * Runs the decompilation phases of Boomerang on a corpus of sample binaries
+ * and compares the results against a stored baseline.
+ *
+ * Each sample is decompiled \ref setNumRuns times in a fresh Project.
+ * Wall time and allocation counts are reported as the median over all runs,
+ * the peak RSS as the maximum over all runs.
+ */
+class Benchmark
+{
+public:
+    Benchmark(const QString &samplesDir, const QString &outputDir);
+
+public:
+    void setNumRuns(int numRuns) { m_numRuns = numRuns; }
+    void setNumThreads(int numThreads) { m_numThreads = numThreads; }
+
+    /// Benchmark all samples in \p sampleNames. \returns false if any sample failed.
+    bool run(const QStringList &sampleNames);
+
+    const std::vector<SampleResult> &getResults() const { return m_results; }
+
+    /// \returns the results in JSON format, suitable for use as a baseline.
+    QJsonObject toJson() const;
+
+    /**
+     * Compare the results against \p baseline (as returned by \ref toJson)
+     * and print all phases that are more than \p tolerance (e.g. 0.1 for 10%) slower
+     * or use more memory or allocations than the baseline.
+     * \returns false if there are regressions.
+     */
+    bool compareToBaseline(const QJsonObject &baseline, double tolerance) const;
+
+public:
+    static const char *getPhaseName(BenchmarkPhase phase);
+
+private:
+    /// Decompile \p samplePath once. \returns false on failure.
+    bool runOnce(const QString &samplePath, std::vector<PhaseResult> &phases) const;
+
+private:
+    QString m_samplesDir;
+    QString m_outputDir;
+    int m_numRuns    = 5;
+    int m_numThreads = 1;
+
+    std::vector<SampleResult> m_results;
+};
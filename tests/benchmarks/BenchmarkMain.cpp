@@ -0,0 +1,183 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "Benchmark.h"
+
+#include <QCoreApplication>
+#include <QFile>
+#include <QJsonDocument>
+#include <QSaveFile>
+#include <QTemporaryDir>
+#include <QTextStream>
+
+#include <iostream>
+
+
+static void help()
+{
+    // clang-format off
+    std::cout <<
+"Usage:\n"
+"  boomerang-benchmark [ options ] [ sample ... ]\n"
+"\n"
+"Decompiles each sample (a path relative to the samples directory, e.g. x86/hello)\n"
+"and measures wall time, peak RSS and heap allocations of the load, decode, decompile\n"
+"and code generation phases. Allocations are only counted if Boomerang was built with\n"
+"BOOMERANG_ENABLE_ALLOC_PROFILING.\n"
+"\n"
+"Options\n"
+"  --corpus <file>    : Read sample names from <file> (one per line, '#' starts a comment)\n"
+"  --samples <dir>    : Directory containing the samples (default: <data dir>/samples)\n"
+"  --runs <n>         : Decompile each sample <n> times (default 5)\n"
+"  --threads <n>      : Use <n> threads for procedure local analyses (default 1)\n"
+"  --output <file>    : Write the results in JSON format to <file>\n"
+"  --baseline <file>  : Compare the results to the JSON results in <file>;\n"
+"                       exit with code 1 if there are any regressions\n"
+"  --tolerance <pct>  : Allowed slowdown compared to the baseline in percent (default 10)\n"
+"  -h, --help         : Show this help and exit\n";
+    // clang-format on
+}
+
+
+static bool readCorpus(const QString &fileName, QStringList &sampleNames)
+{
+    QFile file(fileName);
+    if (!file.open(QFile::ReadOnly | QFile::Text)) {
+        std::cerr << "Cannot open corpus file '" << fileName.toStdString() << "'" << std::endl;
+        return false;
+    }
+
+    QTextStream ist(&file);
+    while (!ist.atEnd()) {
+        const QString line = ist.readLine().section('#', 0, 0).trimmed();
+
+        if (!line.isEmpty()) {
+            sampleNames.push_back(line);
+        }
+    }
+
+    return true;
+}
+
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    const QStringList args = app.arguments();
+
+    QStringList sampleNames;
+    QString samplesDir = QCoreApplication::applicationDirPath() + "/../share/boomerang/samples/";
+    QString outputFile;
+    QString baselineFile;
+    int numRuns      = 5;
+    int numThreads   = 1;
+    double tolerance = 10.0;
+
+    for (int i = 1; i < args.size(); ++i) {
+        const QString &arg = args[i];
+        bool converted     = true;
+
+        if (arg == "-h" || arg == "--help") {
+            help();
+            return 0;
+        }
+        else if (!arg.startsWith("-")) {
+            sampleNames.push_back(arg);
+            continue;
+        }
+        else if (i + 1 == args.size()) {
+            help();
+            return 2;
+        }
+
+        const QString &value = args[++i];
+
+        if (arg == "--corpus") {
+            converted = readCorpus(value, sampleNames);
+        }
+        else if (arg == "--samples") {
+            samplesDir = value;
+        }
+        else if (arg == "--runs") {
+            numRuns = value.toInt(&converted);
+            converted &= numRuns > 0;
+        }
+        else if (arg == "--threads") {
+            numThreads = value.toInt(&converted);
+            converted &= numThreads > 0;
+        }
+        else if (arg == "--output") {
+            outputFile = value;
+        }
+        else if (arg == "--baseline") {
+            baselineFile = value;
+        }
+        else if (arg == "--tolerance") {
+            tolerance = value.toDouble(&converted);
+            converted &= tolerance >= 0.0;
+        }
+        else {
+            help();
+            return 2;
+        }
+
+        if (!converted) {
+            std::cerr << "'" << arg.toStdString() << "': Bad argument '" << value.toStdString()
+                      << "' (try --help)." << std::endl;
+            return 2;
+        }
+    }
+
+    if (sampleNames.isEmpty()) {
+        help();
+        return 2;
+    }
+
+    QJsonObject baseline;
+    if (!baselineFile.isEmpty()) {
+        QFile file(baselineFile);
+        if (!file.open(QFile::ReadOnly)) {
+            std::cerr << "Cannot open baseline '" << baselineFile.toStdString() << "'" << std::endl;
+            return 2;
+        }
+
+        baseline = QJsonDocument::fromJson(file.readAll()).object();
+    }
+
+    QTemporaryDir outputDir;
+    if (!outputDir.isValid()) {
+        std::cerr << "Cannot create temporary output directory" << std::endl;
+        return 2;
+    }
+
+    Benchmark benchmark(samplesDir, outputDir.path());
+    benchmark.setNumRuns(numRuns);
+    benchmark.setNumThreads(numThreads);
+
+    const bool allOk = benchmark.run(sampleNames);
+
+    if (!outputFile.isEmpty()) {
+        QSaveFile file(outputFile);
+        if (!file.open(QFile::WriteOnly) ||
+            file.write(QJsonDocument(benchmark.toJson()).toJson()) == -1 || !file.commit()) {
+            std::cerr << "Cannot write results to '" << outputFile.toStdString() << "'"
+                      << std::endl;
+            return 2;
+        }
+    }
+    else {
+        std::cout << QJsonDocument(benchmark.toJson()).toJson().toStdString();
+    }
+
+    if (!baselineFile.isEmpty() && !benchmark.compareToBaseline(baseline, tolerance / 100.0)) {
+        return 1;
+    }
+
+    return allOk ? 0 : 1;
+}
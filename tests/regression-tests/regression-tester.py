@@ -348,8 +348,16 @@ def test_single_input(cli_path, input_file, output_path, expected_output_path, a
 
 
 
-""" Perform regression tests on inputs in test_list. Returns true on success (no regressions). """
-def perform_regression_tests(base_dir, test_input_base, test_list):
+""" Replace the expected outputs of a test by its actual outputs, without the captured stdout/stderr. """
+def update_expected_output(expected_output_dir, output_dir):
+    if os.path.isdir(expected_output_dir): shutil.rmtree(expected_output_dir)
+    shutil.copytree(output_dir, expected_output_dir, ignore=shutil.ignore_patterns("*.stdout", "*.stderr"))
+
+
+
+""" Perform regression tests on inputs in test_list. Returns true on success (no regressions).
+    If update_expected is True, the expected outputs of regressed tests are replaced by their actual outputs. """
+def perform_regression_tests(base_dir, test_input_base, test_list, update_expected):
     test_results = defaultdict();
 
     sys.stdout.write("Testing for regressions ")
@@ -362,6 +370,9 @@ def perform_regression_tests(base_dir, test_input_base, test_list):
         test_result = test_single_input(sys.argv[1], input_file, output_dir, expected_output_dir, sys.argv[2:])
         test_results[test_file] = test_result
 
+        if update_expected and test_result[0] == 'r':
+            update_expected_output(expected_output_dir, output_dir)
+
         sys.stdout.write(test_result[0]) # print status
         sys.stdout.flush()
 
@@ -376,6 +387,9 @@ def perform_regression_tests(base_dir, test_input_base, test_list):
                 sys.stdout.flush()
         print("")
 
+        if update_expected:
+            print("Expected outputs of regressed ('r') tests were updated. Review them before committing.\n")
+
     sys.stdout.flush()
     return num_failed == 0
 
@@ -424,10 +438,15 @@ def main():
     base_dir = os.getcwd()
     tests_input_base = os.path.abspath(os.path.join(os.getcwd(), "../../out/share/boomerang/samples/"))
 
+    # Not passed on to boomerang-cli
+    update_expected = "--update-expected" in sys.argv[2:]
+    if update_expected:
+        sys.argv.remove("--update-expected")
+
     all_ok = True
 
     clean_old_outputs(base_dir)
-    all_ok &= perform_regression_tests(base_dir, tests_input_base, regression_tests)
+    all_ok &= perform_regression_tests(base_dir, tests_input_base, regression_tests, update_expected)
     all_ok &= perform_smoke_tests(base_dir, tests_input_base, smoke_tests)
 
     print("Testing finished.\n")
@@ -20,6 +20,7 @@ TestProject::TestProject()
 {
     getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
     getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    getSettings()->setCacheDirectory(BOOMERANG_TEST_BASE "cache/boomerang/");
 }
 
 
@@ -158,6 +158,20 @@ void CommandLineDriverTest::testApplyCommandline()
         QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--ssl" }), 1);
     }
 
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.getProject()->getSettings()->numThreads, 1);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--threads", "0", "test.exe" }), 1);
+        QCOMPARE(drv.getProject()->getSettings()->numThreads, 1);
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--threads", "4", "test.exe" }), 0);
+        QCOMPARE(drv.getProject()->getSettings()->numThreads, 4);
+    }
+
+    {
+        CommandlineDriver drv;
+        QCOMPARE(drv.applyCommandline({ "boomerang-cli", "--threads" }), 1);
+    }
+
     {
         CommandlineDriver drv;
         QCOMPARE(drv.getProject()->getSettings()->getOutputDirectory(), QDir("./output"));
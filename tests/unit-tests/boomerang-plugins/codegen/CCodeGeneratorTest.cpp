@@ -0,0 +1,72 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "CCodeGeneratorTest.h"
+
+#include "boomerang/core/Settings.h"
+
+#include <QDirIterator>
+#include <QTemporaryDir>
+
+
+#define RECURSION_X86 getFullSamplePath("x86/recursion")
+
+
+/// Decompile \p samplePath using \p numThreads threads into \p outputDir.
+/// \returns the generated code of all files, or an empty string on failure.
+static QString generateCode(const QString &samplePath, int numThreads, const QString &outputDir)
+{
+    TestProject project;
+    project.getSettings()->numThreads = numThreads;
+    project.getSettings()->setOutputDirectory(outputDir);
+    project.loadPlugins();
+
+    if (!project.loadBinaryFile(samplePath) || !project.decodeBinaryFile() ||
+        !project.decompileBinaryFile() || !project.generateCode()) {
+        return "";
+    }
+
+    QStringList files;
+    QDirIterator it(outputDir, { "*.c", "*.h" }, QDir::Files, QDirIterator::Subdirectories);
+    while (it.hasNext()) {
+        files.push_back(it.next());
+    }
+
+    files.sort();
+
+    QString code;
+    for (const QString &fileName : files) {
+        QFile file(fileName);
+        if (!file.open(QFile::ReadOnly | QFile::Text)) {
+            return "";
+        }
+
+        code += "// " + QDir(outputDir).relativeFilePath(fileName) + "\n";
+        code += QString::fromUtf8(file.readAll());
+    }
+
+    return code;
+}
+
+
+void CCodeGeneratorTest::testParallelGeneration()
+{
+    QTemporaryDir serialDir;
+    QTemporaryDir parallelDir;
+    QVERIFY(serialDir.isValid() && parallelDir.isValid());
+
+    const QString serialCode   = generateCode(RECURSION_X86, 1, serialDir.path());
+    const QString parallelCode = generateCode(RECURSION_X86, 4, parallelDir.path());
+
+    QVERIFY(!serialCode.isEmpty());
+    compareLongStrings(parallelCode, serialCode);
+}
+
+
+QTEST_GUILESS_MAIN(CCodeGeneratorTest)
@@ -11,6 +11,7 @@
 
 #include "boomerang-plugins/frontend/x86/X86FrontEnd.h"
 
+#include "boomerang/core/Settings.h"
 #include "boomerang/db/Prog.h"
 #include "boomerang/ifc/IDecoder.h"
 #include "boomerang/ssl/RTL.h"
@@ -22,6 +23,7 @@
 
 #define HELLO_X86         getFullSamplePath("x86/hello")
 #define BRANCH_X86        getFullSamplePath("x86/branch")
+#define PARAMCHAIN_X86    getFullSamplePath("x86/paramchain")
 #define FEDORA2_TRUE_X86  getFullSamplePath("x86/fedora2_true")
 #define FEDORA3_TRUE_X86  getFullSamplePath("x86/fedora3_true")
 #define SUSE_TRUE_X86     getFullSamplePath("x86/suse_true")
@@ -252,4 +254,52 @@ void X86FrontEndTest::testFindMain()
 }
 
 
+void X86FrontEndTest::testTemplateID()
+{
+    QVERIFY(m_project.loadBinaryFile(HELLO_X86));
+    Prog *prog = m_project.getProg();
+    X86FrontEnd *fe = dynamic_cast<X86FrontEnd *>(prog->getFrontEnd());
+    QVERIFY(fe != nullptr);
+
+    MachineInstruction pushReg1, pushReg2, pushImm;
+    LiftedInstruction lifted;
+
+    QVERIFY(fe->decodeInstruction(Address(0x08048328), pushReg1, lifted));
+    lifted.reset();
+    QVERIFY(fe->decodeInstruction(Address(0x08048328), pushReg2, lifted));
+    lifted.reset();
+    QVERIFY(fe->decodeInstruction(Address(0x0804833b), pushImm, lifted));
+
+    QCOMPARE(pushReg1.m_templateName, QString("PUSH.reg32"));
+    QCOMPARE(pushImm.m_templateName, QString("PUSH.imm32"));
+
+    QVERIFY(pushReg1.m_templateID != -1);
+    QVERIFY(pushImm.m_templateID != -1);
+    QCOMPARE(pushReg2.m_templateName, pushReg1.m_templateName);
+    QCOMPARE(pushReg2.m_templateID, pushReg1.m_templateID);
+    QVERIFY(pushImm.m_templateID != pushReg1.m_templateID);
+}
+
+
+void X86FrontEndTest::testPredisassemble()
+{
+    QVERIFY(m_project.loadBinaryFile(PARAMCHAIN_X86));
+    Prog *prog = m_project.getProg();
+    X86FrontEnd *fe = dynamic_cast<X86FrontEnd *>(prog->getFrontEnd());
+    QVERIFY(fe != nullptr);
+
+    // main -> passem -> addem. Only passem is known when disassembling children of main starts,
+    // so addem is only disassembled ahead of time if the prepass follows calls.
+    const int oldNumThreads = m_project.getSettings()->numThreads;
+    m_project.getSettings()->numThreads = 4;
+    const bool decoded = m_project.decodeBinaryFile();
+    m_project.getSettings()->numThreads = oldNumThreads;
+
+    QVERIFY(decoded);
+    QVERIFY(prog->getFunctionByName("addem") != nullptr);
+    QVERIFY(fe->getNumPredisassembledHits() > 0);
+    QCOMPARE(fe->getNumPredisassembledMisses(), 0);
+}
+
+
 QTEST_GUILESS_MAIN(X86FrontEndTest)
@@ -23,4 +23,10 @@ private slots:
     void test3();
     void testFindMain();
     void testBranch();
+
+    /// Test that instructions of the same kind share the same SSL template ID
+    void testTemplateID();
+
+    /// Test that all procedures are disassembled ahead of time when using multiple threads
+    void testPredisassemble();
 };
@@ -0,0 +1,160 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "SignatureDatabaseTest.h"
+
+#include "boomerang-plugins/symbol/c/SignatureDatabase.h"
+
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/ssl/type/PointerType.h"
+#include "boomerang/ssl/type/VoidType.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+
+static bool writeFile(const QString &path, const QByteArray &contents)
+{
+    QFile file(path);
+    return file.open(QFile::WriteOnly) && file.write(contents) == contents.size();
+}
+
+
+/// Write a small catalog consisting of two headers to \p dir. \returns the path of the catalog.
+static QString writeCatalog(const QTemporaryDir &dir)
+{
+    writeFile(dir.filePath("first.h"), "typedef unsigned int mysize_t;\n"
+                                       "int foo(int a, char *b);\n"
+                                       "int bar(mysize_t n, ...);\n");
+    writeFile(dir.filePath("second.h"), "char *foo(void *p);\n"
+                                        "void baz(void);\n");
+    writeFile(dir.filePath("test.hs"), "first.h\n"
+                                       "second.h\n");
+
+    return dir.filePath("test.hs");
+}
+
+
+void SignatureDatabaseTest::testCompile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString catalogPath   = writeCatalog(dir);
+    const QByteArray sourceHash = SignatureDatabase::computeSourceHash(catalogPath);
+    QVERIFY(!sourceHash.isEmpty());
+
+    QByteArray data;
+    QVERIFY(SignatureDatabase::compile(catalogPath, Machine::X86, sourceHash, data));
+
+    SignatureDatabase db;
+    QVERIFY(db.open(data, Machine::X86, sourceHash));
+    QCOMPARE(db.getNumSignatures(), 3);
+
+    // later headers override earlier ones
+    std::shared_ptr<Signature> foo = db.getSignatureByName("foo");
+    QVERIFY(foo != nullptr);
+    QCOMPARE(foo->getName(), QString("foo"));
+    QCOMPARE(foo->getNumParams(), 1);
+    QCOMPARE(foo->getSigFilePath(), dir.filePath("second.h"));
+    QVERIFY(*foo->getParamType(0) == *PointerType::get(VoidType::get()));
+
+    std::shared_ptr<Signature> bar = db.getSignatureByName("bar");
+    QVERIFY(bar != nullptr);
+    QCOMPARE(bar->getNumParams(), 1);
+    QVERIFY(bar->hasEllipsis());
+    QCOMPARE(bar->getParamType(0)->getCtype(), QString("mysize_t"));
+
+    QVERIFY(db.getSignatureByName("baz") != nullptr);
+    QVERIFY(db.getSignatureByName("ba") == nullptr);
+    QVERIFY(db.getSignatureByName("qux") == nullptr);
+
+    // Named types are registered when compiling and when opening a database file
+    Type::clearNamedTypes();
+    QVERIFY(db.registerNamedTypes());
+    QVERIFY(Type::getNamedType("mysize_t") != nullptr);
+    QVERIFY(*Type::getNamedType("mysize_t") == *IntegerType::get(32, Sign::Unsigned));
+}
+
+
+void SignatureDatabaseTest::testOpenMapped()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString catalogPath   = writeCatalog(dir);
+    const QByteArray sourceHash = SignatureDatabase::computeSourceHash(catalogPath);
+
+    QByteArray data;
+    QVERIFY(SignatureDatabase::compile(catalogPath, Machine::X86, sourceHash, data));
+    QVERIFY(writeFile(dir.filePath("test.sigdb"), data));
+
+    SignatureDatabase db;
+    QVERIFY(db.open(dir.filePath("test.sigdb"), Machine::X86, sourceHash));
+    QCOMPARE(db.getNumSignatures(), 3);
+
+    std::shared_ptr<Signature> bar = db.getSignatureByName("bar");
+    QVERIFY(bar != nullptr);
+    QCOMPARE(bar->getSigFilePath(), dir.filePath("first.h"));
+
+    db.close();
+    QVERIFY(!db.isOpen());
+    QVERIFY(db.getSignatureByName("bar") == nullptr);
+}
+
+
+void SignatureDatabaseTest::testSourceHash()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString catalogPath   = writeCatalog(dir);
+    const QByteArray sourceHash = SignatureDatabase::computeSourceHash(catalogPath);
+
+    QVERIFY(!sourceHash.isEmpty());
+    QCOMPARE(SignatureDatabase::computeSourceHash(catalogPath), sourceHash);
+
+    // Changing any of the headers changes the hash
+    QVERIFY(writeFile(dir.filePath("second.h"), "char *foo(void *p);\n"));
+    QVERIFY(SignatureDatabase::computeSourceHash(catalogPath) != sourceHash);
+
+    // Missing headers
+    QVERIFY(QFile::remove(dir.filePath("first.h")));
+    QVERIFY(SignatureDatabase::computeSourceHash(catalogPath).isEmpty());
+    QVERIFY(SignatureDatabase::computeSourceHash(dir.filePath("missing.hs")).isEmpty());
+}
+
+
+void SignatureDatabaseTest::testRejectStale()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString catalogPath   = writeCatalog(dir);
+    const QByteArray sourceHash = SignatureDatabase::computeSourceHash(catalogPath);
+
+    QByteArray data;
+    QVERIFY(SignatureDatabase::compile(catalogPath, Machine::X86, sourceHash, data));
+    QVERIFY(writeFile(dir.filePath("test.sigdb"), data));
+
+    SignatureDatabase db;
+    QVERIFY(!db.open(dir.filePath("test.sigdb"), Machine::PPC, sourceHash));
+    QVERIFY(!db.open(dir.filePath("test.sigdb"), Machine::X86, QByteArray(20, '\0')));
+    QVERIFY(!db.open(dir.filePath("missing.sigdb"), Machine::X86, sourceHash));
+
+    // truncated database
+    QVERIFY(!db.open(data.left(16), Machine::X86, sourceHash));
+    QVERIFY(!db.isOpen());
+
+    QVERIFY(db.open(dir.filePath("test.sigdb"), Machine::X86, sourceHash));
+}
+
+
+QTEST_GUILESS_MAIN(SignatureDatabaseTest)
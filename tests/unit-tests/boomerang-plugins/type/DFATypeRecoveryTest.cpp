@@ -0,0 +1,123 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "DFATypeRecoveryTest.h"
+
+
+#define SAMPLE(path)    (m_project.getSettings()->getDataDirectory().absoluteFilePath("samples/" path))
+#define HELLO_X86   SAMPLE("x86/hello")
+
+
+#include "boomerang-plugins/type/dfa/DFATypeRecovery.h"
+
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/LowLevelCFG.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/VoidType.h"
+
+
+/// Number of copies in the chain. Each visit of all statements in order
+/// only propagates the type of a0 by one copy.
+static const int CHAIN_LENGTH = 20;
+
+
+static SharedExp tmp(const QString &name)
+{
+    return Location::tempOf(Const::get(name));
+}
+
+
+/**
+ * Create the following statements in \p proc, in this order:
+ *
+ *   a20 := a19{}
+ *   b20 := a19{}
+ *   ...
+ *   a1  := a0{}
+ *   b1  := a0{}
+ *   a0  := 1.5
+ *
+ * All statements are untyped. Every definition is used twice,
+ * so it is not propagated when propMaxDepth is 0.
+ */
+static void createStatements(UserProc *proc, BasicBlock *bb)
+{
+    RTL::StmtList stmts;
+    auto a0 = std::make_shared<Assign>(VoidType::get(), tmp("a0"), Const::get(1.5));
+    std::shared_ptr<Assign> prev = a0;
+
+    for (int i = 1; i <= CHAIN_LENGTH; ++i) {
+        const SharedExp use = RefExp::get(tmp(QString("a%1").arg(i - 1)), prev);
+        auto a = std::make_shared<Assign>(VoidType::get(), tmp(QString("a%1").arg(i)), use);
+        auto b = std::make_shared<Assign>(VoidType::get(), tmp(QString("b%1").arg(i)),
+                                          use->clone());
+
+        stmts.insert(stmts.begin(), { a, b });
+        prev = a;
+    }
+
+    stmts.push_back(a0);
+
+    std::unique_ptr<RTLList> rtls(new RTLList);
+    rtls->push_back(std::unique_ptr<RTL>(new RTL(bb->getLowAddr(), &stmts)));
+
+    IRFragment *frag = proc->getCFG()->createFragment(FragType::Fall, std::move(rtls), bb);
+    proc->setEntryFragment();
+
+    for (const SharedStmt &s : stmts) {
+        s->setProc(proc);
+        s->setFragment(frag);
+    }
+}
+
+
+void DFATypeRecoveryTest::testSparseIterations()
+{
+    QVERIFY(m_project.loadBinaryFile(HELLO_X86));
+    m_project.getSettings()->propMaxDepth = 0;
+    Prog *prog                            = m_project.getProg();
+
+    BasicBlock *bb = prog->getCFG()->createBB(BBType::Fall, createInsns(Address(0x1000), 1));
+    UserProc proc(Address(0x1000), "test", prog->getRootModule());
+    createStatements(&proc, bb);
+
+    PassManager::get()->executePass(PassID::Dominators, &proc);
+
+    DFATypeRecovery dfa(&m_project);
+    dfa.recoverFunctionTypes(&proc);
+
+    std::vector<SharedStmt> stmts;
+    proc.getStatementSnapshot(stmts);
+
+    const std::size_t numStmts = 2 * CHAIN_LENGTH + 1;
+    QCOMPARE(stmts.size(), numStmts);
+
+    for (const SharedStmt &s : stmts) {
+        QVERIFY(s->isAssign());
+        QVERIFY(s->as<Assign>()->getType()->resolvesToFloat());
+    }
+
+    // Visiting all statements in every iteration needs CHAIN_LENGTH + 1 iterations
+    // to propagate the type, and another one to find that nothing changes any more.
+    const std::size_t roundRobinVisits = (CHAIN_LENGTH + 2) * numStmts;
+
+    const DFATypeRecovery::AnalysisStats stats = dfa.getAnalysisStats(&proc);
+    QVERIFY(stats.numIterations > 2);
+    QVERIFY(stats.numVisits < roundRobinVisits / 4);
+}
+
+
+QTEST_GUILESS_MAIN(DFATypeRecoveryTest)
@@ -0,0 +1,24 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class DFATypeRecoveryTest : public BoomerangTestWithPlugins
+{
+    Q_OBJECT
+
+private slots:
+    /// Test that types are propagated along a long chain of definitions,
+    /// and that only the affected statements are visited again.
+    void testSparseIterations();
+};
@@ -12,7 +12,14 @@
 
 #include "boomerang/core/Project.h"
 #include "boomerang/core/Settings.h"
+#include "boomerang/db/LowLevelCFG.h"
 #include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/db/signature/Signature.h"
+
+#include <QDir>
+#include <QTemporaryDir>
 
 
 void ProjectTest::testLoadBinaryFile()
@@ -52,6 +59,167 @@ void ProjectTest::testWriteSaveFile()
 }
 
 
+void ProjectTest::testLoadDecodeCache()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    QVERIFY(!project.loadDecodeCache("invalid"));
+
+    project.loadPlugins();
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    // not a decode cache
+    QVERIFY(!project.loadDecodeCache(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(!project.isBinaryLoaded());
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.decodeBinaryFile());
+    QVERIFY(project.writeDecodeCache(tempDir.filePath("hello.bmdc")));
+
+    // truncated decode cache
+    QFile cacheFile(tempDir.filePath("hello.bmdc"));
+    QVERIFY(cacheFile.open(QFile::ReadWrite));
+    QVERIFY(cacheFile.resize(cacheFile.size() / 2));
+    cacheFile.close();
+
+    QVERIFY(!project.loadDecodeCache(tempDir.filePath("hello.bmdc")));
+    QVERIFY(!project.isBinaryLoaded());
+}
+
+
+void ProjectTest::testWriteDecodeCache()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    QVERIFY(!project.writeDecodeCache("invalid"));
+}
+
+
+void ProjectTest::testDecodeCacheRoundTrip()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString cacheFilePath = tempDir.filePath("hello.bmdc");
+
+    std::map<QString, Address> procAddrs;
+    std::map<QString, std::shared_ptr<Signature>> procSignatures;
+    int numBBs       = 0;
+    int numFunctions = 0;
+
+    {
+        Project project;
+        project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+        project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+        project.loadPlugins();
+
+        QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+        QVERIFY(project.decodeBinaryFile());
+        QVERIFY(project.writeDecodeCache(cacheFilePath));
+
+        for (const auto &module : project.getProg()->getModuleList()) {
+            for (Function *func : *module) {
+                procAddrs[func->getName()]      = func->getEntryAddress();
+                procSignatures[func->getName()] = func->getSignature()->clone();
+            }
+        }
+
+        numBBs       = project.getProg()->getCFG()->getNumBBs();
+        numFunctions = project.getProg()->getNumFunctions();
+    }
+
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.loadPlugins();
+
+    QVERIFY(project.loadDecodeCache(cacheFilePath));
+    QVERIFY(project.isBinaryLoaded());
+    QCOMPARE(project.getProg()->getNumFunctions(), numFunctions);
+    QCOMPARE(project.getProg()->getCFG()->getNumBBs(), numBBs);
+    QCOMPARE(project.getProg()->getEntryProcs().size(), size_t(1));
+
+    for (const auto &module : project.getProg()->getModuleList()) {
+        for (Function *func : *module) {
+            QVERIFY(procSignatures.find(func->getName()) != procSignatures.end());
+            QCOMPARE(func->getEntryAddress(), procAddrs[func->getName()]);
+            QVERIFY(*func->getSignature() == *procSignatures[func->getName()]);
+
+            if (!func->isLib()) {
+                QCOMPARE(static_cast<UserProc *>(func)->getStatus(), ProcStatus::Decoded);
+            }
+        }
+    }
+
+    // Decompilation starts from the decoded state
+    QVERIFY(project.decompileBinaryFile());
+    QVERIFY(project.generateCode());
+
+    // Decompiled programs are written in decoded state
+    QVERIFY(project.writeDecodeCache(cacheFilePath));
+    QVERIFY(project.loadDecodeCache(cacheFilePath));
+    QCOMPARE(project.getProg()->getNumFunctions(), numFunctions);
+
+    for (const auto &module : project.getProg()->getModuleList()) {
+        for (Function *func : *module) {
+            if (!func->isLib()) {
+                QCOMPARE(static_cast<UserProc *>(func)->getStatus(), ProcStatus::Decoded);
+            }
+        }
+    }
+
+    QVERIFY(project.decompileBinaryFile());
+}
+
+
+void ProjectTest::testDecodeCacheBinaryPath()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.loadPlugins();
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    QDir baseDir(tempDir.path());
+    QVERIFY(baseDir.mkpath("a/cache"));
+    QVERIFY(baseDir.mkpath("other"));
+    QVERIFY(QFile::copy(getFullSamplePath("elf/hello-clang4-dynamic"),
+                        baseDir.filePath("a/hello")));
+
+    QVERIFY(project.loadBinaryFile(baseDir.filePath("a/hello")));
+    QVERIFY(project.decodeBinaryFile());
+    QVERIFY(project.writeDecodeCache(baseDir.filePath("a/cache/hello.bmdc")));
+    project.unloadBinaryFile();
+
+    // The binary file is found relative to the decode cache after moving both.
+    QVERIFY(baseDir.rename("a", "b"));
+    QVERIFY(project.loadDecodeCache(baseDir.filePath("b/cache/hello.bmdc")));
+    QCOMPARE(project.getLoadedBinaryFilePath(),
+             QFileInfo(baseDir.filePath("b/hello")).absoluteFilePath());
+
+    // The binary file was moved without the decode cache.
+    QVERIFY(QFile::rename(baseDir.filePath("b/hello"), baseDir.filePath("other/hello")));
+    QVERIFY(!project.loadDecodeCache(baseDir.filePath("b/cache/hello.bmdc")));
+    QVERIFY(!project.isBinaryLoaded());
+
+    // The caller knows where the binary file is.
+    QVERIFY(project.loadDecodeCache(baseDir.filePath("b/cache/hello.bmdc"),
+                                    baseDir.filePath("other/hello")));
+    QCOMPARE(project.getLoadedBinaryFilePath(),
+             QFileInfo(baseDir.filePath("other/hello")).absoluteFilePath());
+
+    // The decode cache was created from a different binary file.
+    QVERIFY(!project.loadDecodeCache(baseDir.filePath("b/cache/hello.bmdc"),
+                                     getFullSamplePath("elf/hello-clang4-static")));
+    QVERIFY(!project.isBinaryLoaded());
+}
+
+
 void ProjectTest::testIsBinaryLoaded()
 {
     Project project;
@@ -69,8 +237,20 @@ void ProjectTest::testIsBinaryLoaded()
     QVERIFY(!project.isBinaryLoaded());
 
     project.unloadBinaryFile();
-    // test if binary is loaded when loading from save file
-    // TODO
+
+    // test if binary is loaded when loading from a decode cache
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.decodeBinaryFile());
+    QVERIFY(project.writeDecodeCache(tempDir.filePath("hello.bmdc")));
+
+    project.unloadBinaryFile();
+    QVERIFY(!project.isBinaryLoaded());
+
+    QVERIFY(project.loadDecodeCache(tempDir.filePath("hello.bmdc")));
+    QVERIFY(project.isBinaryLoaded());
 }
 
 
@@ -122,4 +302,38 @@ void ProjectTest::testGenerateCode()
 }
 
 
+void ProjectTest::benchLoadDecodeCache()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.loadPlugins();
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.decodeBinaryFile());
+    QVERIFY(project.writeDecodeCache(tempDir.filePath("hello.bmdc")));
+
+    QBENCHMARK {
+        project.loadDecodeCache(tempDir.filePath("hello.bmdc"));
+    }
+}
+
+
+void ProjectTest::benchDecodeBinaryFile()
+{
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.loadPlugins();
+
+    QBENCHMARK {
+        project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic"));
+        project.decodeBinaryFile();
+    }
+}
+
+
 QTEST_GUILESS_MAIN(ProjectTest)
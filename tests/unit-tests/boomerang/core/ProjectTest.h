@@ -28,10 +28,26 @@ private slots:
     void testLoadSaveFile();
     void testWriteSaveFile();
 
+    // test loading/writing to/from a decode cache
+    void testLoadDecodeCache();
+    void testWriteDecodeCache();
+
+    /// Test that a decoded program survives a write/load cycle of a decode cache.
+    void testDecodeCacheRoundTrip();
+
+    /// Test that the binary file is found relative to the decode cache, or at the path
+    /// given by the caller.
+    void testDecodeCacheBinaryPath();
+
     // test whether a binary is loaded after loading unloading
     void testIsBinaryLoaded();
 
     void testDecodeBinaryFile();
     void testDecompileBinaryFile();
     void testGenerateCode();
+
+    /// Compare the time to restore a program from a decode cache
+    /// against the time needed to decode it.
+    void benchLoadDecodeCache();
+    void benchDecodeBinaryFile();
 };
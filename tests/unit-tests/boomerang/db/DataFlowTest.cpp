@@ -197,6 +197,44 @@ void DataFlowTest::testCalculateDominatorsComplex()
 }
 
 
+void DataFlowTest::testCalculateDominatorsDeep()
+{
+    Prog prog("test", nullptr);
+    LowLevelCFG *cfg = prog.getCFG();
+    UserProc proc(Address(0x1000), "test", nullptr);
+    ProcCFG *procCFG = proc.getCFG();
+
+    // A long chain of fragments, with a back edge from the last fragment to the second one.
+    // This must not exhaust the stack.
+    const int numFrags = 50000;
+    std::vector<IRFragment *> frags;
+
+    for (int n = 0; n < numFrags; ++n) {
+        const BBType ty = (n == numFrags - 1) ? BBType::Twoway : BBType::Oneway;
+        frags.push_back(createBBAndFragment(cfg, ty, Address(0x1000 + n), &proc));
+
+        if (n > 0) {
+            procCFG->addEdge(frags[n - 1], frags[n]);
+        }
+    }
+
+    procCFG->addEdge(frags.back(), frags[1]);
+    proc.setEntryFragment();
+
+    DataFlow *df = proc.getDataFlow();
+    QVERIFY(df->calculateDominators());
+
+    for (int n = 1; n < numFrags; ++n) {
+        QCOMPARE(df->getDominator(frags[n]), frags[n - 1]);
+    }
+
+    QCOMPARE(df->getDominanceFrontier(frags[0]), std::set<const IRFragment *>({}));
+    QCOMPARE(df->getDominanceFrontier(frags[1]), std::set<const IRFragment *>({ frags[1] }));
+    QCOMPARE(df->getDominanceFrontier(frags[numFrags / 2]), std::set<const IRFragment *>({ frags[1] }));
+    QCOMPARE(df->getDominanceFrontier(frags.back()), std::set<const IRFragment *>({ frags[1] }));
+}
+
+
 void DataFlowTest::testPlacePhi()
 {
     QVERIFY(m_project.loadBinaryFile(FRONTIER_X86));
@@ -225,7 +263,7 @@ void DataFlowTest::testPlacePhi()
     OStream actual(&actualStr);
 
     // r24 == eax
-    std::set<FragIndex>& A_phi = df->getA_phi(Location::regOf(REG_X86_EAX));
+    const std::set<FragIndex> A_phi = df->getA_phi(Location::regOf(REG_X86_EAX));
 
     for (FragIndex bb : A_phi) {
         actual << (int)bb << " ";
@@ -260,7 +298,7 @@ void DataFlowTest::testPlacePhi2()
     QString     actual_st;
     OStream actual(&actual_st);
     SharedExp            e = Location::regOf(REG_X86_EAX);
-    std::set<FragIndex>& s = df->getA_phi(e);
+    const std::set<FragIndex> s = df->getA_phi(e);
 
     for (auto pp = s.begin(); pp != s.end(); ++pp) {
         actual << (uint64)*pp << " ";
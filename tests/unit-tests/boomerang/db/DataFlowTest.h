@@ -26,6 +26,7 @@ private slots:
     void testCalculateDominators2();
     void testCalculateDominatorsSelfLoop();
     void testCalculateDominatorsComplex();
+    void testCalculateDominatorsDeep();
 
     /// Test the placing of phi functions
     void testPlacePhi();
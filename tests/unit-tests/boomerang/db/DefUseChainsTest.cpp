@@ -0,0 +1,144 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "DefUseChainsTest.h"
+
+
+#include "boomerang/db/DefUseChains.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/IntegerType.h"
+
+
+// helper: create the statements
+//   0: eax := 5
+//   1: ecx := eax{0} + eax{0}
+//   2: edx := ecx{1}
+static std::vector<std::shared_ptr<Assign>> createStatements()
+{
+    std::shared_ptr<Assign> a0(new Assign(IntegerType::get(32), Location::regOf(REG_X86_EAX), Const::get(5)));
+    std::shared_ptr<Assign> a1(new Assign(IntegerType::get(32), Location::regOf(REG_X86_ECX),
+                                          Binary::get(opPlus,
+                                                      RefExp::get(Location::regOf(REG_X86_EAX), a0),
+                                                      RefExp::get(Location::regOf(REG_X86_EAX), a0))));
+    std::shared_ptr<Assign> a2(new Assign(IntegerType::get(32), Location::regOf(REG_X86_EDX),
+                                          RefExp::get(Location::regOf(REG_X86_ECX), a1)));
+
+    return { a0, a1, a2 };
+}
+
+
+void DefUseChainsTest::testGetUsers()
+{
+    {
+        DefUseChains chains(std::vector<SharedStmt>{});
+        QCOMPARE(chains.size(), static_cast<std::size_t>(0));
+        QVERIFY(chains.getDestCounts().empty());
+    }
+
+    {
+        std::vector<std::shared_ptr<Assign>> assigns = createStatements();
+        DefUseChains chains({ assigns[0], assigns[1], assigns[2] });
+
+        QCOMPARE(chains.size(), static_cast<std::size_t>(3));
+        QVERIFY(chains.getStatement(1) == assigns[1]);
+        QCOMPARE(chains.getUsers(0), std::set<std::size_t>({ 1 }));
+        QCOMPARE(chains.getUsers(1), std::set<std::size_t>({ 2 }));
+        QCOMPARE(chains.getUsers(2), std::set<std::size_t>({}));
+    }
+
+    {
+        // the definition is not part of the chains
+        std::vector<std::shared_ptr<Assign>> assigns = createStatements();
+        DefUseChains chains({ assigns[1], assigns[2] });
+
+        QCOMPARE(chains.getUsers(0), std::set<std::size_t>({ 1 }));
+        QCOMPARE(chains.getUsers(1), std::set<std::size_t>({}));
+        QCOMPARE(chains.getDestCounts().size(), static_cast<std::size_t>(2));
+    }
+}
+
+
+void DefUseChainsTest::testGetDestCounts()
+{
+    std::vector<std::shared_ptr<Assign>> assigns = createStatements();
+    DefUseChains chains({ assigns[0], assigns[1], assigns[2] });
+
+    const DefUseChains::ExpCountMap &counts = chains.getDestCounts();
+    QCOMPARE(counts.size(), static_cast<std::size_t>(2));
+
+    auto it = counts.find(RefExp::get(Location::regOf(REG_X86_EAX), assigns[0]));
+    QVERIFY(it != counts.end());
+    QCOMPARE(it->second, 2);
+
+    it = counts.find(RefExp::get(Location::regOf(REG_X86_ECX), assigns[1]));
+    QVERIFY(it != counts.end());
+    QCOMPARE(it->second, 1);
+}
+
+
+void DefUseChainsTest::testGetUsedDefs()
+{
+    std::vector<std::shared_ptr<Assign>> assigns = createStatements();
+
+    {
+        DefUseChains chains({ assigns[0], assigns[1], assigns[2] });
+
+        std::set<std::size_t> defs;
+        chains.getUsedDefs(0, defs);
+        QCOMPARE(defs, std::set<std::size_t>({}));
+
+        chains.getUsedDefs(1, defs);
+        QCOMPARE(defs, std::set<std::size_t>({ 0 }));
+
+        // defs are added to the set
+        chains.getUsedDefs(2, defs);
+        QCOMPARE(defs, std::set<std::size_t>({ 0, 1 }));
+    }
+
+    {
+        // the definition is not part of the chains
+        DefUseChains chains({ assigns[1], assigns[2] });
+
+        std::set<std::size_t> defs;
+        chains.getUsedDefs(0, defs);
+        QCOMPARE(defs, std::set<std::size_t>({}));
+    }
+}
+
+
+void DefUseChainsTest::testUpdateUses()
+{
+    std::vector<std::shared_ptr<Assign>> assigns = createStatements();
+    DefUseChains chains({ assigns[0], assigns[1], assigns[2] });
+
+    // propagate eax{0} into 1: ecx := 5 + 5
+    assigns[1]->setRight(Binary::get(opPlus, Const::get(5), Const::get(5)));
+    chains.updateUses(1);
+
+    QCOMPARE(chains.getUsers(0), std::set<std::size_t>({}));
+    QCOMPARE(chains.getUsers(1), std::set<std::size_t>({ 2 }));
+    QCOMPARE(chains.getDestCounts().size(), static_cast<std::size_t>(1));
+    QVERIFY(chains.getDestCounts().find(RefExp::get(Location::regOf(REG_X86_EAX), assigns[0])) ==
+            chains.getDestCounts().end());
+
+    // make 2 use eax{0} again
+    assigns[2]->setRight(RefExp::get(Location::regOf(REG_X86_EAX), assigns[0]));
+    chains.updateUses(2);
+
+    QCOMPARE(chains.getUsers(0), std::set<std::size_t>({ 2 }));
+    QCOMPARE(chains.getUsers(1), std::set<std::size_t>({}));
+    QCOMPARE(chains.getDestCounts().size(), static_cast<std::size_t>(1));
+}
+
+
+QTEST_GUILESS_MAIN(DefUseChainsTest)
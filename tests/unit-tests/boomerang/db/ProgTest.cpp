@@ -191,6 +191,10 @@ void ProgTest::testGetFunctionByAddr()
 
     Function *func = prog.getOrCreateFunction(Address(0x1000));
     QVERIFY(prog.getFunctionByAddr(Address(0x1000)) == func);
+
+    func->setEntryAddress(Address(0x2000));
+    QVERIFY(prog.getFunctionByAddr(Address(0x1000)) == nullptr);
+    QVERIFY(prog.getFunctionByAddr(Address(0x2000)) == func);
 }
 
 
@@ -202,6 +206,20 @@ void ProgTest::testGetFunctionByName()
     Function *func = prog.getOrCreateFunction(Address(0x1000));
     func->setName("testFunc");
     QVERIFY(prog.getFunctionByName("testFunc") == func);
+
+    func->setName("renamedFunc");
+    QVERIFY(prog.getFunctionByName("testFunc") == nullptr);
+    QVERIFY(prog.getFunctionByName("renamedFunc") == func);
+
+    // rename by replacing the signature
+    func->setSignature(std::make_shared<Signature>("signatureFunc"));
+    QVERIFY(prog.getFunctionByName("renamedFunc") == nullptr);
+    QVERIFY(prog.getFunctionByName("signatureFunc") == func);
+
+    // moving the function to another module keeps it indexed
+    func->setModule(prog.getOrInsertModule("otherModule"));
+    QVERIFY(prog.getFunctionByName("signatureFunc") == func);
+    QVERIFY(prog.getFunctionByAddr(Address(0x1000)) == func);
 }
 
 
@@ -219,6 +237,7 @@ void ProgTest::testRemoveFunction()
     QVERIFY(func != nullptr);
     func->setName("testFunc");
     QVERIFY(prog.removeFunction(func->getName()) == true);
+    QVERIFY(prog.getFunctionByName("testFunc") == nullptr);
 }
 
 
@@ -470,6 +489,67 @@ void ProgTest::testGetGlobalNameByAddr()
 
     prog.createGlobal(Address(0x08000000), IntegerType::get(32), "foo");
     QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000000)), QString("foo"));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000003)), QString("foo"));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000004)), QString(""));
+
+    // overlapping globals
+    prog.createGlobal(Address(0x08000010), ArrayType::get(CharType::get(), 64), "bar");
+    prog.createGlobal(Address(0x08000020), IntegerType::get(32), "baz");
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000024)), QString("bar"));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000050)), QString(""));
+
+    // shrinking bar uncovers baz
+    prog.getGlobalByName("bar")->setType(IntegerType::get(32));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000013)), QString("bar"));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000014)), QString(""));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000024)), QString(""));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000023)), QString("baz"));
+
+    // growing foo covers bar and baz
+    prog.getGlobalByName("foo")->setType(ArrayType::get(CharType::get(), 0x30));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000010)), QString("foo"));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000020)), QString("foo"));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x0800002F)), QString("foo"));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000030)), QString(""));
+
+    // a global without a size still contains its own address
+    prog.createGlobal(Address(0x08000040), VoidType::get(), "qux");
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000040)), QString("qux"));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000041)), QString(""));
+}
+
+
+void ProgTest::testSetGlobals()
+{
+    Prog prog("test", nullptr);
+    prog.createGlobal(Address(0x08000000), IntegerType::get(32), "foo");
+
+    Prog::GlobalSet globals;
+    globals.insert(std::make_shared<Global>(ArrayType::get(CharType::get(), 16),
+                                            Address(0x08000010), "bar", &prog));
+    globals.insert(std::make_shared<Global>(IntegerType::get(32), Address(0x08000014), "baz",
+                                            &prog));
+    globals.insert(std::make_shared<Global>(IntegerType::get(32), Address(0x08000018), "bar",
+                                            &prog));
+
+    prog.setGlobals(globals);
+    QCOMPARE(prog.getGlobals().size(), static_cast<std::size_t>(3));
+    QVERIFY(prog.getGlobalByName("foo") == nullptr);
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000000)), QString(""));
+
+    // lookup by name prefers the global with the lowest address
+    QCOMPARE(prog.getGlobalAddrByName("bar"), Address(0x08000010));
+    QCOMPARE(prog.getGlobalAddrByName("baz"), Address(0x08000014));
+
+    // baz and the second bar are hidden by the first bar
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000014)), QString("bar"));
+    QVERIFY(prog.getGlobalByName("baz")->containsAddress(Address(0x08000014)));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x0800001F)), QString("bar"));
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000020)), QString(""));
+
+    prog.setGlobals({});
+    QVERIFY(prog.getGlobals().empty());
+    QCOMPARE(prog.getGlobalNameByAddr(Address(0x08000010)), QString(""));
 }
 
 
@@ -64,6 +64,7 @@ private slots:
     void testGetGlobalNameByAddr();
     void testGetGlobalAddrByName();
     void testGetGlobalByName();
+    void testSetGlobals();
     void testNewGlobalName();
     void testGuessGlobalType();
     void testMakeArrayType();
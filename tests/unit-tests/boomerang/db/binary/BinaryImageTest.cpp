@@ -15,6 +15,8 @@
 #include "boomerang/db/proc/UserProc.h"
 
 #include <QByteArray>
+#include <QFile>
+#include <QTemporaryDir>
 
 
 void BinaryImageTest::testGetNumSections()
@@ -101,6 +103,37 @@ void BinaryImageTest::testGetSectionByAddr()
     QVERIFY(img.getSectionByAddr(Address(0x1000)) == sect1);
     QVERIFY(img.getSectionByAddr(Address(0x1800)) == sect1);
     QVERIFY(img.getSectionByAddr(Address(0x2000)) == nullptr);
+
+    BinarySection *sect2 = img.createSection("sect2", Address(0x3000), Address(0x4000));
+    QVERIFY(img.getSectionByAddr(Address(0x0FFF)) == nullptr);
+    QVERIFY(img.getSectionByAddr(Address(0x2800)) == nullptr);
+    QVERIFY(img.getSectionByAddr(Address(0x3000)) == sect2);
+    QVERIFY(img.getSectionByAddr(Address(0x1000)) == sect1);
+    QVERIFY(img.getSectionByAddr(Address(0x3FFF)) == sect2);
+    QVERIFY(img.getSectionByAddr(Address(0x4000)) == nullptr);
+
+    img.reset();
+    QVERIFY(img.getSectionByAddr(Address(0x1000)) == nullptr);
+}
+
+
+void BinaryImageTest::testGetSectionByAddrOverlap()
+{
+    BinaryImage img(QByteArray{});
+
+    // overlapping parts belong to the section that starts first
+    BinarySection *sect2 = img.createSection("sect2", Address(0x1800), Address(0x2800));
+    BinarySection *sect1 = img.createSection("sect1", Address(0x1000), Address(0x2000));
+    BinarySection *sect3 = img.createSection("sect3", Address(0x1400), Address(0x1600));
+
+    QVERIFY(img.getSectionByAddr(Address(0x1000)) == sect1);
+    QVERIFY(img.getSectionByAddr(Address(0x1500)) == sect1);
+    QVERIFY(img.getSectionByAddr(Address(0x1800)) == sect1);
+    QVERIFY(img.getSectionByAddr(Address(0x1FFF)) == sect1);
+    QVERIFY(img.getSectionByAddr(Address(0x2000)) == sect2);
+    QVERIFY(img.getSectionByAddr(Address(0x27FF)) == sect2);
+    QVERIFY(img.getSectionByAddr(Address(0x2800)) == nullptr);
+    QVERIFY(sect3 != nullptr);
 }
 
 
@@ -192,6 +225,71 @@ void BinaryImageTest::testRead()
 }
 
 
+void BinaryImageTest::testReadNativeArray()
+{
+    char sectionData[16] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+                             0x08, 0x19, 0x2A, 0x3B, 0x4C, 0x5D, 0x6E, 0x7F };
+
+    Byte bytes[16]  = { 0 };
+    SWord words[8]  = { 0 };
+    DWord dwords[4] = { 0 };
+    QWord qwords[2] = { 0 };
+
+    BinaryImage img(QByteArray{});
+    QVERIFY(!img.readNativeArray1(Address(0x1000), bytes, 16));
+
+    // section not mapped to data
+    BinarySection *sect1 = img.createSection("sect1", Address(0x1000), Address(0x1010));
+    QVERIFY(!img.readNativeArray4(Address(0x1000), dwords, 4));
+    QVERIFY(img.getHostBytes(Address(0x1000), 4) == nullptr);
+
+    // section mapped to data, but not initialized (BSS)
+    sect1->setHostAddr(HostAddress(sectionData));
+    QVERIFY(!img.readNativeArray4(Address(0x1000), dwords, 4));
+
+    // partially initialized
+    sect1->addDefinedArea(Address(0x1000), Address(0x1008));
+    QVERIFY(img.readNativeArray4(Address(0x1000), dwords, 2));
+    QVERIFY(!img.readNativeArray4(Address(0x1000), dwords, 3));
+    QVERIFY(!img.readNativeArray4(Address(0x1008), dwords, 1));
+
+    sect1->addDefinedArea(Address(0x1008), Address(0x1010));
+    QVERIFY(img.readNativeArray1(Address(0x1000), bytes, 16));
+    QVERIFY(memcmp(bytes, sectionData, 16) == 0);
+
+    QVERIFY(img.readNativeArray2(Address(0x1000), words, 8));
+    QCOMPARE(words[0], static_cast<SWord>(0x1100));
+    QCOMPARE(words[7], static_cast<SWord>(0x7F6E));
+
+    QVERIFY(img.readNativeArray4(Address(0x1000), dwords, 4));
+    QCOMPARE(dwords[0], static_cast<DWord>(0x33221100));
+    QCOMPARE(dwords[3], static_cast<DWord>(0x7F6E5D4C));
+
+    QVERIFY(img.readNativeArray8(Address(0x1000), qwords, 2));
+    QCOMPARE(qwords[0], static_cast<QWord>(0x7766554433221100));
+    QCOMPARE(qwords[1], static_cast<QWord>(0x7F6E5D4C3B2A1908));
+
+    // big endian
+    sect1->setEndian(Endian::Big);
+    QVERIFY(img.readNativeArray4(Address(0x1004), dwords, 1));
+    QCOMPARE(dwords[0], static_cast<DWord>(0x44556677));
+    sect1->setEndian(Endian::Little);
+
+    // reads must not cross the section boundary
+    dwords[0] = 0;
+    QVERIFY(!img.readNativeArray4(Address(0x1004), dwords, 4));
+    QCOMPARE(dwords[0], static_cast<DWord>(0));
+    QVERIFY(!img.readNativeArray8(Address(0x1001), qwords, 2));
+
+    // empty reads always succeed
+    QVERIFY(img.readNativeArray4(Address(0x5000), dwords, 0));
+
+    QVERIFY(img.getHostBytes(Address(0x1004), 12) ==
+            reinterpret_cast<const Byte *>(sectionData + 4));
+    QVERIFY(img.getHostBytes(Address(0x1004), 13) == nullptr);
+}
+
+
 void BinaryImageTest::testWrite()
 {
     char sectionData[8] = { 0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77 };
@@ -236,4 +334,118 @@ void BinaryImageTest::testIsReadOnly()
 }
 
 
+void BinaryImageTest::testMappedFile()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    const QByteArray contents("\x01\x02\x03\x04\x05\x06\x07\x08", 8);
+    const QString filePath = tempDir.filePath("image.bin");
+
+    {
+        QFile file(filePath);
+        QVERIFY(file.open(QFile::WriteOnly));
+        QCOMPARE(file.write(contents), qint64(contents.size()));
+    }
+
+    {
+        std::unique_ptr<QFile> file(new QFile(filePath));
+        QVERIFY(file->open(QFile::ReadOnly));
+
+        BinaryImage img(std::move(file));
+        QVERIFY(img.isMapped());
+        QCOMPARE(img.getRawSize(), size_t(8));
+        QCOMPARE(img.getRawData(), contents);
+
+        // modifications must not be written back to the file
+        img.getRawBytes()[0] = 0xFF;
+        QVERIFY(img.isMapped());
+        QCOMPARE(img.getRawBytes()[0], Byte(0xFF));
+    }
+
+    {
+        QFile file(filePath);
+        QVERIFY(file.open(QFile::ReadOnly));
+        QCOMPARE(file.readAll(), contents);
+    }
+
+    // empty files cannot be mapped
+    {
+        QFile emptyFile(tempDir.filePath("empty.bin"));
+        QVERIFY(emptyFile.open(QFile::WriteOnly));
+    }
+
+    std::unique_ptr<QFile> file(new QFile(tempDir.filePath("empty.bin")));
+    QVERIFY(file->open(QFile::ReadOnly));
+
+    BinaryImage img(std::move(file));
+    QVERIFY(!img.isMapped());
+    QCOMPARE(img.getRawSize(), size_t(0));
+}
+
+
+/// Create an image with a single initialized section of \p numEntries 32 bit entries
+static void createTableImage(BinaryImage &img, std::vector<DWord> &table, int numEntries)
+{
+    table.resize(numEntries);
+    for (int i = 0; i < numEntries; ++i) {
+        table[i] = 0x1000 + 4 * i;
+    }
+
+    // a few unrelated sections so that the section lookup is not trivial
+    for (int i = 0; i < 16; ++i) {
+        img.createSection(QString("sect%1").arg(i), Address(0x100000 * (i + 2)),
+                          Address(0x100000 * (i + 2) + 0x1000));
+    }
+
+    const Address tableStart = Address(0x10000);
+    BinarySection *sect = img.createSection(".rodata", tableStart, tableStart + 4 * numEntries);
+    sect->setHostAddr(HostAddress(table.data()));
+    sect->addDefinedArea(tableStart, tableStart + 4 * numEntries);
+}
+
+
+void BinaryImageTest::benchReadNative4()
+{
+    const int numEntries = 4096;
+    std::vector<DWord> table;
+
+    BinaryImage img(QByteArray{});
+    createTableImage(img, table, numEntries);
+
+    DWord sum = 0;
+    QBENCHMARK {
+        for (int i = 0; i < numEntries; ++i) {
+            DWord value = 0;
+            img.readNative4(Address(0x10000 + 4 * i), value);
+            sum += value;
+        }
+    }
+
+    QVERIFY(sum != 0);
+}
+
+
+void BinaryImageTest::benchReadNativeArray4()
+{
+    const int numEntries = 4096;
+    std::vector<DWord> table;
+
+    BinaryImage img(QByteArray{});
+    createTableImage(img, table, numEntries);
+
+    std::vector<DWord> values(numEntries);
+    DWord sum = 0;
+
+    QBENCHMARK {
+        img.readNativeArray4(Address(0x10000), values.data(), numEntries);
+        for (int i = 0; i < numEntries; ++i) {
+            sum += values[i];
+        }
+    }
+
+    QVERIFY(sum != 0);
+}
+
+
 QTEST_GUILESS_MAIN(BinaryImageTest)
@@ -24,11 +24,20 @@ private slots:
     void testGetSectionByIndex();
     void testGetSectionByName();
     void testGetSectionByAddr();
+    void testGetSectionByAddrOverlap();
 
     void testUpdateTextLimits();
 
     void testRead();
+    void testReadNativeArray();
     void testWrite();
 
     void testIsReadOnly();
+
+    /// Test creating an image from a memory mapped file.
+    void testMappedFile();
+
+    /// Benchmark reading a table element by element vs. reading it at once.
+    void benchReadNative4();
+    void benchReadNativeArray4();
 };
@@ -0,0 +1,88 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProofCacheTest.h"
+
+
+#include "boomerang/db/proc/ProofCache.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+
+
+void ProofCacheTest::testLookup()
+{
+    ProofCache cache;
+    UserProc proc(Address(0x1000), "test", nullptr);
+
+    const SharedExp esp     = Location::regOf(REG_X86_ESP);
+    const SharedExp espPlus = Binary::get(opPlus, Location::regOf(REG_X86_ESP), Const::get(4));
+    bool result             = true;
+
+    QVERIFY(!cache.lookup(&proc, esp, esp, result));
+    QCOMPARE(cache.getNumMisses(), uint64(1));
+
+    cache.insert(&proc, esp, esp, false);
+    QVERIFY(cache.lookup(&proc, esp, esp, result));
+    QVERIFY(!result);
+
+    // lookup by value, not by identity
+    QVERIFY(cache.lookup(&proc, Location::regOf(REG_X86_ESP), esp->clone(), result));
+    QVERIFY(!result);
+
+    QVERIFY(!cache.lookup(&proc, esp, espPlus, result));
+
+    cache.insert(&proc, esp, espPlus, true);
+    QVERIFY(cache.lookup(&proc, esp, espPlus, result));
+    QVERIFY(result);
+
+    QCOMPARE(cache.getNumHits(), uint64(3));
+    QCOMPARE(cache.getNumMisses(), uint64(2));
+}
+
+
+void ProofCacheTest::testInvalidate()
+{
+    ProofCache cache;
+    UserProc proc1(Address(0x1000), "test1", nullptr);
+    UserProc proc2(Address(0x2000), "test2", nullptr);
+
+    const SharedExp ebp = Location::regOf(REG_X86_EBP);
+    bool result         = true;
+
+    cache.insert(&proc1, ebp, ebp, false);
+    cache.insert(&proc2, ebp, ebp, false);
+
+    cache.invalidate(&proc1);
+    QVERIFY(!cache.lookup(&proc1, ebp, ebp, result));
+    QVERIFY(cache.lookup(&proc2, ebp, ebp, result));
+    QVERIFY(!result);
+}
+
+
+void ProofCacheTest::testClear()
+{
+    ProofCache cache;
+    UserProc proc1(Address(0x1000), "test1", nullptr);
+    UserProc proc2(Address(0x2000), "test2", nullptr);
+
+    const SharedExp ebp = Location::regOf(REG_X86_EBP);
+    bool result         = true;
+
+    cache.insert(&proc1, ebp, ebp, false);
+    cache.insert(&proc2, ebp, ebp, false);
+
+    cache.clear();
+    QVERIFY(!cache.lookup(&proc1, ebp, ebp, result));
+    QVERIFY(!cache.lookup(&proc2, ebp, ebp, result));
+}
+
+
+QTEST_GUILESS_MAIN(ProofCacheTest)
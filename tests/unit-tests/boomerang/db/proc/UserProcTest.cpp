@@ -132,6 +132,76 @@ void UserProcTest::testRemoveStatement()
 }
 
 
+void UserProcTest::testGetStatementRange()
+{
+    Prog prog("test", nullptr);
+    BasicBlock *bb1 = prog.getCFG()->createBB(BBType::Oneway, createInsns(Address(0x1000), 1));
+    BasicBlock *bb2 = prog.getCFG()->createBB(BBType::Ret, createInsns(Address(0x1001), 1));
+
+    {
+        UserProc proc(Address(0x1000), "test", nullptr);
+        QVERIFY(proc.getStatementRange().empty());
+
+        std::vector<SharedStmt> snapshot;
+        proc.getStatementSnapshot(snapshot);
+        QVERIFY(snapshot.empty());
+    }
+
+    {
+        UserProc proc(Address(0x1000), "test", nullptr);
+
+        std::shared_ptr<Assign> as1(new Assign(VoidType::get(), Location::regOf(REG_X86_EAX), Location::regOf(REG_X86_ECX)));
+        std::shared_ptr<Assign> as2(new Assign(VoidType::get(), Location::regOf(REG_X86_EDX), Location::regOf(REG_X86_EBX)));
+        std::shared_ptr<Assign> as3(new Assign(VoidType::get(), Location::regOf(REG_X86_ESI), Location::regOf(REG_X86_EDI)));
+
+        // empty RTLs must be skipped
+        std::unique_ptr<RTLList> rtls1(new RTLList);
+        rtls1->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1000), { })));
+        rtls1->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1000), { as1, as2 })));
+        rtls1->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1000), { })));
+
+        std::unique_ptr<RTLList> rtls2(new RTLList);
+        rtls2->push_back(std::unique_ptr<RTL>(new RTL(Address(0x1001), { as3 })));
+
+        IRFragment *frag1 = proc.getCFG()->createFragment(FragType::Oneway, std::move(rtls1), bb1);
+        IRFragment *frag2 = proc.getCFG()->createFragment(FragType::Ret, std::move(rtls2), bb2);
+        as1->setFragment(frag1);
+        as2->setFragment(frag1);
+        as3->setFragment(frag2);
+
+        std::vector<SharedStmt> snapshot;
+        proc.getStatementSnapshot(snapshot);
+        QCOMPARE(snapshot.size(), static_cast<std::size_t>(3));
+
+        // neither the view nor the snapshot change the owning proc
+        QVERIFY(as1->getProc() == nullptr);
+        QVERIFY(as3->getProc() == nullptr);
+
+        proc.adoptStatements();
+        QVERIFY(as1->getProc() == &proc);
+        QVERIFY(as2->getProc() == &proc);
+        QVERIFY(as3->getProc() == &proc);
+
+        StatementList stmts;
+        proc.getStatements(stmts);
+        QCOMPARE(stmts.size(), static_cast<std::size_t>(3));
+
+        auto stmtIt = stmts.begin();
+        auto snapIt = snapshot.begin();
+        int numStmts = 0;
+
+        for (const SharedStmt &s : proc.getStatementRange()) {
+            QVERIFY(stmtIt != stmts.end());
+            QVERIFY(s == *stmtIt++);
+            QVERIFY(s == *snapIt++);
+            numStmts++;
+        }
+
+        QCOMPARE(numStmts, 3);
+    }
+}
+
+
 void UserProcTest::testInsertAssignAfter()
 {
     Prog prog("test", nullptr);
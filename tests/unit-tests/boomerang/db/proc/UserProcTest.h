@@ -20,6 +20,7 @@ class UserProcTest : public BoomerangTestWithPlugins
 private slots:
     void testIsNoReturn();
     void testRemoveStatement();
+    void testGetStatementRange();
     void testInsertAssignAfter();
     void testInsertStatementAfter();
     void testReplacePhiByAssign();
@@ -0,0 +1,85 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "InterprocTypeSolverTest.h"
+
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/decomp/InterprocTypeSolver.h"
+#include "boomerang/ssl/statements/Assignment.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+
+
+#define CALLCHAIN_X86 getFullSamplePath("x86/callchain")
+
+
+void InterprocTypeSolverTest::testSolveDecodedProcs()
+{
+    Prog prog("test", &m_project);
+
+    UserProc *caller = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x1000)));
+    UserProc *callee = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x2000)));
+    UserProc *other  = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x3000)));
+    QVERIFY(caller && callee && other);
+
+    caller->addCallee(callee);
+    caller->setDecoded();
+    callee->setDecoded();
+
+    // procedures that are not decoded are not analysed
+    InterprocTypeSolver solver(&prog);
+    solver.solve(ProcSet{ caller, callee, other });
+
+    QCOMPARE(solver.getNumLocalAnalyses(), 2);
+    QCOMPARE(solver.getNumChangedTypes(), 0);
+}
+
+
+void InterprocTypeSolverTest::testCallChain()
+{
+    QVERIFY(m_project.loadBinaryFile(CALLCHAIN_X86));
+    QVERIFY(m_project.decodeBinaryFile());
+    QVERIFY(m_project.decompileBinaryFile());
+
+    Prog *prog         = m_project.getProg();
+    UserProc *mainProc = static_cast<UserProc *>(prog->getFunctionByName("main"));
+    UserProc *printarg = static_cast<UserProc *>(prog->getFunctionByAddr(Address(0x080489B0)));
+    QVERIFY(mainProc != nullptr && printarg != nullptr);
+    QVERIFY(!mainProc->isLib() && !printarg->isLib());
+
+    // printarg passes its parameter to printf as %d,
+    // so the argument of the call in main must be an integer as well
+    const SharedType paramType = printarg->getSignature()->getParamType(0);
+    QVERIFY(paramType != nullptr);
+    QVERIFY(paramType->resolvesToInteger());
+
+    std::vector<SharedStmt> stmts;
+    mainProc->getStatementSnapshot(stmts);
+
+    int numCalls = 0;
+    for (const SharedStmt &s : stmts) {
+        if (!s->isCall() || s->as<CallStatement>()->getDestProc() != printarg) {
+            continue;
+        }
+
+        numCalls++;
+        const StatementList &args = s->as<CallStatement>()->getArguments();
+        QCOMPARE(args.size(), static_cast<std::size_t>(1));
+
+        const SharedType argType = args.front()->as<Assignment>()->getType();
+        QVERIFY(argType != nullptr);
+        QCOMPARE(argType->getCtype(), paramType->getCtype());
+    }
+
+    QCOMPARE(numCalls, 1);
+}
+
+
+QTEST_GUILESS_MAIN(InterprocTypeSolverTest)
@@ -0,0 +1,167 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProcSchedulerTest.h"
+
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/decomp/ProcScheduler.h"
+
+#include <atomic>
+#include <map>
+#include <memory>
+
+
+void ProcSchedulerTest::testCallChain()
+{
+    UserProc a(Address(0x1000), "a", nullptr);
+    UserProc b(Address(0x2000), "b", nullptr);
+    UserProc c(Address(0x3000), "c", nullptr);
+
+    a.addCallee(&b);
+    b.addCallee(&c);
+
+    ProcScheduler scheduler(nullptr);
+    scheduler.computeWaves({ &a, &b, &c });
+
+    QCOMPARE(scheduler.getNumProcs(), 3);
+    QCOMPARE(scheduler.getWaves().size(), size_t(3));
+    QCOMPARE(scheduler.getWaves()[0], ProcScheduler::Wave({ { &c } }));
+    QCOMPARE(scheduler.getWaves()[1], ProcScheduler::Wave({ { &b } }));
+    QCOMPARE(scheduler.getWaves()[2], ProcScheduler::Wave({ { &a } }));
+}
+
+
+void ProcSchedulerTest::testRecursion()
+{
+    UserProc a(Address(0x1000), "a", nullptr);
+    UserProc b(Address(0x2000), "b", nullptr);
+    UserProc c(Address(0x3000), "c", nullptr);
+    UserProc d(Address(0x4000), "d", nullptr);
+
+    // a and b are mutually recursive; c is a leaf; d is recursive and calls a
+    a.addCallee(&b);
+    b.addCallee(&a);
+    b.addCallee(&c);
+    d.addCallee(&d);
+    d.addCallee(&a);
+
+    ProcScheduler scheduler(nullptr);
+    scheduler.computeWaves({ &d, &c, &b, &a });
+
+    QCOMPARE(scheduler.getNumProcs(), 4);
+    QCOMPARE(scheduler.getWaves().size(), size_t(3));
+    QCOMPARE(scheduler.getWaves()[0], ProcScheduler::Wave({ { &c } }));
+    QCOMPARE(scheduler.getWaves()[1], ProcScheduler::Wave({ { &a, &b } }));
+    QCOMPARE(scheduler.getWaves()[2], ProcScheduler::Wave({ { &d } }));
+}
+
+
+void ProcSchedulerTest::testLowerAddressCallee()
+{
+    UserProc callee(Address(0x1000), "callee", nullptr);
+    UserProc caller(Address(0x2000), "caller", nullptr);
+    UserProc leaf(Address(0x3000), "leaf", nullptr);
+
+    caller.addCallee(&callee);
+
+    ProcScheduler scheduler(nullptr);
+    scheduler.computeWaves({ &caller, &callee, &leaf });
+
+    // independent components of a wave are sorted by address
+    QCOMPARE(scheduler.getWaves().size(), size_t(2));
+    QCOMPARE(scheduler.getWaves()[0], ProcScheduler::Wave({ { &callee }, { &leaf } }));
+    QCOMPARE(scheduler.getWaves()[1], ProcScheduler::Wave({ { &caller } }));
+}
+
+
+void ProcSchedulerTest::testIgnoredProcs()
+{
+    UserProc a(Address(0x1000), "a", nullptr);
+    UserProc b(Address(0x2000), "b", nullptr);
+    UserProc c(Address(0x3000), "c", nullptr);
+
+    a.addCallee(&b);
+    b.addCallee(&c);
+
+    // b is not scheduled, so a does not depend on c
+    ProcScheduler scheduler(nullptr);
+    scheduler.computeWaves({ &a, &c });
+
+    QCOMPARE(scheduler.getNumProcs(), 2);
+    QCOMPARE(scheduler.getWaves().size(), size_t(1));
+    QCOMPARE(scheduler.getWaves()[0], ProcScheduler::Wave({ { &a }, { &c } }));
+}
+
+
+void ProcSchedulerTest::testComputeWavesProg()
+{
+    Prog prog("test", &m_project);
+
+    UserProc *mainProc = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x2000)));
+    UserProc *foo      = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x1000)));
+    UserProc *bar      = static_cast<UserProc *>(prog.getOrCreateFunction(Address(0x3000)));
+    LibProc *lib       = prog.getOrCreateLibraryProc("printf");
+
+    QVERIFY(mainProc && foo && bar && lib);
+
+    // callees as recorded when lifting
+    mainProc->addCallee(foo);
+    mainProc->addCallee(lib);
+    foo->addCallee(bar);
+
+    ProcScheduler scheduler(&prog);
+    scheduler.computeWaves();
+
+    QCOMPARE(scheduler.getNumProcs(), 3);
+    QCOMPARE(scheduler.getWaves().size(), size_t(3));
+    QCOMPARE(scheduler.getWaves()[0], ProcScheduler::Wave({ { bar } }));
+    QCOMPARE(scheduler.getWaves()[1], ProcScheduler::Wave({ { foo } }));
+    QCOMPARE(scheduler.getWaves()[2], ProcScheduler::Wave({ { mainProc } }));
+
+    // decompiled procedures are not scheduled again
+    bar->setStatus(ProcStatus::FinalDone);
+    scheduler.computeWaves();
+
+    QCOMPARE(scheduler.getNumProcs(), 2);
+    QCOMPARE(scheduler.getWaves().size(), size_t(2));
+    QCOMPARE(scheduler.getWaves()[0], ProcScheduler::Wave({ { foo } }));
+}
+
+
+void ProcSchedulerTest::testForEachProc()
+{
+    std::vector<std::unique_ptr<UserProc>> procs;
+    std::vector<UserProc *> procPtrs;
+
+    for (int i = 0; i < 100; ++i) {
+        procs.emplace_back(new UserProc(Address(0x1000 + i), QString("proc%1").arg(i), nullptr));
+        procPtrs.push_back(procs.back().get());
+    }
+
+    for (int numThreads : { 0, 1, 4 }) {
+        std::map<UserProc *, std::atomic<int>> numCalls;
+        for (UserProc *proc : procPtrs) {
+            numCalls[proc] = 0;
+        }
+
+        ProcScheduler::forEachProc(procPtrs, numThreads,
+                                   [&numCalls](UserProc *proc) { numCalls.at(proc)++; });
+
+        for (UserProc *proc : procPtrs) {
+            QCOMPARE(numCalls.at(proc).load(), 1);
+        }
+    }
+
+    // no procedures
+    ProcScheduler::forEachProc({}, 4, [](UserProc *) { QFAIL("Unexpected call"); });
+}
+
+
+QTEST_GUILESS_MAIN(ProcSchedulerTest)
@@ -0,0 +1,30 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Tests the ProcScheduler class.
+ */
+class ProcSchedulerTest : public BoomerangTestWithProject
+{
+    Q_OBJECT
+
+private slots:
+    void testCallChain();
+    void testRecursion();
+    void testLowerAddressCallee();
+    void testIgnoredProcs();
+    void testComputeWavesProg();
+    void testForEachProc();
+};
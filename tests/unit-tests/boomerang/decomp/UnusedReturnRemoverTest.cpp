@@ -0,0 +1,158 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "UnusedReturnRemoverTest.h"
+
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/module/Module.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/db/signature/Signature.h"
+#include "boomerang/decomp/UnusedReturnRemover.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/ssl/statements/CallStatement.h"
+#include "boomerang/ssl/statements/ReturnStatement.h"
+#include "boomerang/util/OStream.h"
+
+#include <map>
+#include <set>
+
+
+#define CALLCHAIN_X86 getFullSamplePath("x86/callchain")
+
+
+/// Decompile all procedures of \p project, but do not remove unused returns yet.
+static bool decompileProcs(Project &project)
+{
+    if (!project.loadBinaryFile(CALLCHAIN_X86) || !project.decodeBinaryFile()) {
+        return false;
+    }
+
+    for (UserProc *proc : project.getProg()->getEntryProcs()) {
+        proc->decompileRecursive();
+    }
+
+    return true;
+}
+
+
+static std::vector<UserProc *> getUserProcs(Prog *prog)
+{
+    std::vector<UserProc *> procs;
+
+    for (const auto &module : prog->getModuleList()) {
+        for (Function *func : *module) {
+            if (!func->isLib()) {
+                procs.push_back(static_cast<UserProc *>(func));
+            }
+        }
+    }
+
+    return procs;
+}
+
+
+static std::size_t getNumReturns(const UserProc *proc)
+{
+    return proc->getRetStmt() ? proc->getRetStmt()->getNumReturns() : 0;
+}
+
+
+static QString getSignatureString(const UserProc *proc)
+{
+    QString tgt;
+    OStream ost(&tgt);
+    proc->getSignature()->print(ost);
+    return tgt;
+}
+
+
+/// Remove unused returns like ProgDecompiler did before it tracked the changed procedures:
+/// Process all procedures in every round, and analyse the branches of all procedures afterwards.
+static void removeBySweeps(Prog *prog)
+{
+    while (UnusedReturnRemover(prog).removeUnusedReturns()) {
+        for (UserProc *proc : getUserProcs(prog)) {
+            PassManager::get()->executePass(PassID::BranchAnalysis, proc);
+        }
+    }
+}
+
+
+void UnusedReturnRemoverTest::testRemoveAllUnusedReturns()
+{
+    QVERIFY(decompileProcs(m_project));
+    Prog *prog = m_project.getProg();
+
+    std::map<UserProc *, std::size_t> numReturnsBefore;
+    for (UserProc *proc : getUserProcs(prog)) {
+        numReturnsBefore[proc] = getNumReturns(proc);
+    }
+
+    PassProfiler *profiler = PassManager::get()->getProfiler();
+    profiler->clear();
+    profiler->setEnabled(true);
+
+    ProcSet changedProcs;
+    const bool changed = UnusedReturnRemover(prog).removeAllUnusedReturns(changedProcs);
+
+    profiler->setEnabled(false);
+    QVERIFY(changed);
+
+    std::set<QString> analysedProcs;
+    for (const PassProfiler::Event &event : profiler->getEvents()) {
+        if (event.passID == PassID::BranchAnalysis) {
+            analysedProcs.insert(event.procName);
+        }
+    }
+
+    profiler->clear();
+
+    // Exactly the changed procedures have their branches analysed again
+    for (UserProc *proc : getUserProcs(prog)) {
+        const bool isChanged  = changedProcs.find(proc) != changedProcs.end();
+        const bool isAnalysed = analysedProcs.find(proc->getName()) != analysedProcs.end();
+        QCOMPARE(isAnalysed, isChanged);
+    }
+
+    // Removing a return from a callee changes the dataflow of its callers,
+    // so their branches are analysed again as well
+    int numProcsWithRemovedReturns = 0;
+
+    for (UserProc *proc : getUserProcs(prog)) {
+        if (getNumReturns(proc) >= numReturnsBefore[proc]) {
+            continue;
+        }
+
+        numProcsWithRemovedReturns++;
+
+        for (const std::shared_ptr<CallStatement> &call : proc->getCallers()) {
+            QVERIFY(analysedProcs.find(call->getProc()->getName()) != analysedProcs.end());
+        }
+    }
+
+    QVERIFY(numProcsWithRemovedReturns > 0);
+
+    // The result is the same as when processing all procedures in every round
+    TestProject sweepProject;
+    sweepProject.loadPlugins();
+    QVERIFY(decompileProcs(sweepProject));
+    removeBySweeps(sweepProject.getProg());
+
+    for (UserProc *proc : getUserProcs(prog)) {
+        const Function *other = sweepProject.getProg()->getFunctionByAddr(proc->getEntryAddress());
+        QVERIFY(other != nullptr && !other->isLib());
+
+        const UserProc *sweepProc = static_cast<const UserProc *>(other);
+        QCOMPARE(getSignatureString(proc), getSignatureString(sweepProc));
+        QCOMPARE(getNumReturns(proc), getNumReturns(sweepProc));
+    }
+}
+
+
+QTEST_GUILESS_MAIN(UnusedReturnRemoverTest)
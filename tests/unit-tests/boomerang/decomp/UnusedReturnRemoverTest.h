@@ -0,0 +1,27 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Tests the UnusedReturnRemover class.
+ */
+class UnusedReturnRemoverTest : public BoomerangTestWithPlugins
+{
+    Q_OBJECT
+
+private slots:
+    /// Test that only changed procedures have their branches analysed again,
+    /// and that the result is the same as when analysing all procedures in every round.
+    void testRemoveAllUnusedReturns();
+};
@@ -0,0 +1,209 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LibraryPatternMatcherTest.h"
+
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/binary/BinaryImage.h"
+#include "boomerang/db/binary/BinarySection.h"
+#include "boomerang/db/binary/BinarySymbol.h"
+#include "boomerang/db/binary/BinarySymbolTable.h"
+#include "boomerang/db/proc/LibProc.h"
+#include "boomerang/frontend/LibraryPatternMatcher.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+
+
+#define HELLO_X86 getFullSamplePath("x86/hello")
+
+
+#define MATCH(matcher, bytes) \
+    (matcher).match(reinterpret_cast<const Byte *>(bytes), sizeof(bytes) - 1)
+
+
+void LibraryPatternMatcherTest::testAddPattern()
+{
+    LibraryPatternMatcher matcher;
+    QCOMPARE(matcher.getNumPatterns(), 0);
+
+    QVERIFY(matcher.addPattern("000102030405060708090A0B0C0D0E0F", "foo"));
+    QVERIFY(matcher.addPattern("00010203 0405060708090a0b0c0d0e0f ....", "bar"));
+    QCOMPARE(matcher.getNumPatterns(), 2);
+
+    QVERIFY(!matcher.addPattern("", "foo"));
+    QVERIFY(!matcher.addPattern("000102030405060708090A0B0C0D0E0F", ""));
+    QVERIFY(!matcher.addPattern("000102030405060708090A0B0C0D0E0", "foo")); // odd length
+    QVERIFY(!matcher.addPattern("000102030405060708090A0B0C0D0E0G", "foo")); // not hex
+    QVERIFY(!matcher.addPattern("000102030405060708090A0B0C0D0E.0", "foo")); // half wildcard
+    QVERIFY(!matcher.addPattern("000102030405060708090A0B0C0D0E", "foo")); // too short
+    QVERIFY(!matcher.addPattern("000102030405060708090A0B0C0D0E....", "foo"));
+    QCOMPARE(matcher.getNumPatterns(), 2);
+}
+
+
+void LibraryPatternMatcherTest::testMatch()
+{
+    LibraryPatternMatcher matcher;
+    QVERIFY(matcher.addPattern("000102030405060708090A0B0C0D0E0F", "foo"));
+    QVERIFY(matcher.addPattern("100102030405060708090A0B0C0D0E0F", "bar"));
+
+    QCOMPARE(MATCH(matcher, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F"),
+             QString("foo"));
+    QCOMPARE(MATCH(matcher, "\x10\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F"
+                            "\xFF\xFF"),
+             QString("bar"));
+
+    // mismatch in the last byte
+    QCOMPARE(MATCH(matcher, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0E"),
+             QString());
+
+    // not enough bytes
+    QCOMPARE(MATCH(matcher, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E"),
+             QString());
+}
+
+
+void LibraryPatternMatcherTest::testWildcards()
+{
+    LibraryPatternMatcher matcher;
+    QVERIFY(matcher.addPattern("00010203 ........ 08090A0B0C0D0E0F1011121314 ..", "foo"));
+
+    QCOMPARE(MATCH(matcher, "\x00\x01\x02\x03\xAA\xBB\xCC\xDD\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F"
+                            "\x10\x11\x12\x13\x14\x99"),
+             QString("foo"));
+    QCOMPARE(MATCH(matcher, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F"
+                            "\x10\x11\x12\x13\x14\x15"),
+             QString("foo"));
+
+    // trailing wildcard must match a byte, too
+    QCOMPARE(MATCH(matcher, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F"
+                            "\x10\x11\x12\x13\x14"),
+             QString());
+}
+
+
+void LibraryPatternMatcherTest::testLongestMatch()
+{
+    LibraryPatternMatcher matcher;
+    QVERIFY(matcher.addPattern("000102030405060708090A0B0C0D0E0F", "short"));
+    QVERIFY(matcher.addPattern("000102030405060708090A0B0C0D0E0F ....1213", "long"));
+    QVERIFY(matcher.addPattern("0001020304050607 .. 090A0B0C0D0E0F10111213", "wild"));
+
+    // The longest pattern wins
+    QCOMPARE(MATCH(matcher, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F"
+                            "\x10\x11\x12\x13"),
+             QString()); // "long" and "wild" are both 20 bytes long
+    QCOMPARE(MATCH(matcher, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F"
+                            "\xFF\xFF\x12\x13"),
+             QString("long"));
+    QCOMPARE(MATCH(matcher, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F"
+                            "\xFF\xFF\xFF\xFF"),
+             QString("short"));
+}
+
+
+void LibraryPatternMatcherTest::testAmbiguous()
+{
+    LibraryPatternMatcher matcher;
+    QVERIFY(matcher.addPattern("000102030405060708090A0B0C0D0E0F", "foo"));
+    QVERIFY(matcher.addPattern("000102030405060708090A0B0C0D0E0F", "foo"));
+    QVERIFY(matcher.addPattern("100102030405060708090A0B0C0D0E0F", "bar"));
+    QVERIFY(matcher.addPattern("100102030405060708090A0B0C0D0E0F", "baz"));
+
+    // the same pattern for the same function is fine
+    QCOMPARE(MATCH(matcher, "\x00\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F"),
+             QString("foo"));
+    QCOMPARE(MATCH(matcher, "\x10\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F"),
+             QString());
+}
+
+
+void LibraryPatternMatcherTest::testReadPatternFile()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString fileName = dir.filePath("test.pat");
+
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QFile::WriteOnly));
+        file.write("# comment\n"
+                   "\n"
+                   "00010203 04050607 08090A0B 0C0D0E0F   foo # trailing comment\n"
+                   "100102030405060708090A0B0C0D0E0F .. bar\n");
+    }
+
+    LibraryPatternMatcher matcher;
+    QVERIFY(matcher.readPatternFile(fileName));
+    QCOMPARE(matcher.getNumPatterns(), 2);
+    QCOMPARE(MATCH(matcher, "\x10\x01\x02\x03\x04\x05\x06\x07\x08\x09\x0A\x0B\x0C\x0D\x0E\x0F"
+                            "\x00"),
+             QString("bar"));
+
+    {
+        QFile file(fileName);
+        QVERIFY(file.open(QFile::WriteOnly | QFile::Truncate));
+        file.write("00010203 foo\n"
+                   "100102030405060708090A0B0C0D0E0F bar\n");
+    }
+
+    LibraryPatternMatcher invalid;
+    QVERIFY(!invalid.readPatternFile(fileName));
+    QCOMPARE(invalid.getNumPatterns(), 1);
+
+    QVERIFY(!invalid.readPatternFile(dir.filePath("missing.pat")));
+}
+
+
+void LibraryPatternMatcherTest::testFindAll()
+{
+    QVERIFY(m_project.loadBinaryFile(HELLO_X86));
+
+    Prog *prog          = m_project.getProg();
+    BinaryImage *image  = prog->getBinaryFile()->getImage();
+    const Address start = Address(0x0A000000);
+    const Address lib   = start + 0x10;
+
+    // a code section containing a statically linked library function at 0x0A000010.
+    // Must outlive the image, which does not own the section data.
+    static QByteArray code(0x100, '\x90');
+    const char libCode[] = "\x55\x89\xE5\x83\xEC\x18\xC7\x04\x24\x11\x22\x33\x44"
+                           "\xE8\xAA\xBB\xCC\xDD\xC9\xC3";
+    code.replace(0x10, sizeof(libCode) - 1, libCode, sizeof(libCode) - 1);
+
+    BinarySection *section = image->createSection("static", start, start + code.size());
+    QVERIFY(section != nullptr);
+    section->setHostAddr(HostAddress(code.constData()));
+    section->setCode(true);
+
+    LibraryPatternMatcher matcher;
+    QVERIFY(matcher.addPattern("5589E5 83EC18 C70424 11223344 E8 ........ C9C3", "static_func"));
+
+    const std::map<Address, QString> found = matcher.findAll(image);
+    QVERIFY(found.find(lib) != found.end());
+    QCOMPARE(found.at(lib), QString("static_func"));
+    QCOMPARE(found.count(start), size_t(0));
+
+    // mark the match like DefaultFrontEnd::recognizeLibraryProcs does
+    BinarySymbol *sym = prog->getBinaryFile()->getSymbols()->createSymbol(lib, found.at(lib));
+    sym->setAttribute("Function", true);
+    sym->setAttribute("StaticFunction", true);
+    QVERIFY(sym->isStaticFunction());
+
+    Function *func = prog->getOrCreateFunction(lib);
+    QVERIFY(func != nullptr);
+    QVERIFY(func->isLib());
+    QCOMPARE(func->getName(), QString("static_func"));
+    QVERIFY(dynamic_cast<LibProc *>(func) != nullptr);
+}
+
+
+QTEST_GUILESS_MAIN(LibraryPatternMatcherTest)
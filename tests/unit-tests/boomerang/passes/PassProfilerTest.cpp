@@ -0,0 +1,127 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "PassProfilerTest.h"
+
+
+#include "boomerang/core/Project.h"
+#include "boomerang/core/Settings.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/passes/PassProfiler.h"
+
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QTemporaryDir>
+
+
+void PassProfilerTest::testAddEvent()
+{
+    PassProfiler profiler;
+    QVERIFY(!profiler.isEnabled());
+    QCOMPARE(profiler.getPassStats(PassID::Dominators).numExecutions, 0);
+
+    PassProfiler::Event event;
+    event.passID         = PassID::Dominators;
+    event.procName       = "foo";
+    event.start          = PassProfiler::Clock::now();
+    event.duration       = std::chrono::milliseconds(2);
+    event.selfDuration   = std::chrono::milliseconds(1);
+    event.changed        = true;
+    event.numStmtsBefore = 10;
+    event.numStmtsAfter  = 12;
+    event.numAllocs      = 5;
+
+    profiler.addEvent(event);
+
+    event.procName = "bar";
+    event.changed  = false;
+    profiler.addEvent(event);
+
+    const PassProfiler::Stats stats = profiler.getPassStats(PassID::Dominators);
+    QCOMPARE(stats.numExecutions, 2);
+    QCOMPARE(stats.numChanged, 1);
+    QCOMPARE(stats.numStmtsBefore, uint64(20));
+    QCOMPARE(stats.numStmtsAfter, uint64(24));
+    QCOMPARE(stats.numAllocs, uint64(10));
+    QVERIFY(stats.totalTime == std::chrono::milliseconds(4));
+    QVERIFY(stats.selfTime == std::chrono::milliseconds(2));
+
+    QCOMPARE(profiler.getPassStats(PassID::PhiPlacement).numExecutions, 0);
+
+    const std::vector<PassProfiler::Event> events = profiler.getEvents();
+    QCOMPARE(events.size(), size_t(2));
+    QCOMPARE(events[0].procName, QString("foo"));
+    QCOMPARE(events[1].procName, QString("bar"));
+    QCOMPARE(events[0].threadIdx, 0);
+    QCOMPARE(events[1].threadIdx, 0);
+}
+
+
+void PassProfilerTest::testClear()
+{
+    PassProfiler profiler;
+
+    PassProfiler::Event event;
+    event.passID = PassID::Dominators;
+    profiler.addEvent(event);
+
+    QCOMPARE(profiler.getEvents().size(), size_t(1));
+    profiler.clear();
+    QVERIFY(profiler.getEvents().empty());
+    QCOMPARE(profiler.getPassStats(PassID::Dominators).numExecutions, 0);
+}
+
+
+void PassProfilerTest::testProfileDecompilation()
+{
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+
+    Project project;
+    project.getSettings()->setDataDirectory(BOOMERANG_TEST_BASE "share/boomerang/");
+    project.getSettings()->setPluginDirectory(BOOMERANG_TEST_BASE "lib/boomerang/plugins/");
+    project.getSettings()->profileFile = tempDir.filePath("profile");
+    project.loadPlugins();
+
+    QVERIFY(project.loadBinaryFile(getFullSamplePath("elf/hello-clang4-dynamic")));
+    QVERIFY(project.decodeBinaryFile());
+    QVERIFY(project.decompileBinaryFile());
+
+    const PassProfiler *profiler = PassManager::get()->getProfiler();
+    QVERIFY(!profiler->isEnabled());
+    QVERIFY(!profiler->getEvents().empty());
+    QVERIFY(profiler->getPassStats(PassID::StatementInit).numExecutions > 0);
+
+    // Local type analysis executes the implicit placement pass,
+    // which must not be counted twice.
+    for (const PassProfiler::Event &event : profiler->getEvents()) {
+        QVERIFY(event.selfDuration <= event.duration);
+    }
+
+    const PassProfiler::Stats typeStats = profiler->getPassStats(PassID::LocalTypeAnalysis);
+    QVERIFY(typeStats.numExecutions > 0);
+    QVERIFY(typeStats.selfTime < typeStats.totalTime);
+
+    QFile summaryFile(tempDir.filePath("profile.json"));
+    QVERIFY(summaryFile.open(QFile::ReadOnly));
+    const QJsonDocument summary = QJsonDocument::fromJson(summaryFile.readAll());
+    QVERIFY(summary.isObject());
+    QVERIFY(!summary.object()["passes"].toArray().isEmpty());
+
+    QFile traceFile(tempDir.filePath("profile.trace.json"));
+    QVERIFY(traceFile.open(QFile::ReadOnly));
+    const QJsonDocument trace = QJsonDocument::fromJson(traceFile.readAll());
+    QVERIFY(trace.isObject());
+    QCOMPARE(trace.object()["traceEvents"].toArray().size(),
+             static_cast<int>(profiler->getEvents().size()));
+}
+
+
+QTEST_GUILESS_MAIN(PassProfilerTest)
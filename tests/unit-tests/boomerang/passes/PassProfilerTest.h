@@ -0,0 +1,29 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Test the PassProfiler class.
+ */
+class PassProfilerTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    void testAddEvent();
+    void testClear();
+
+    /// Test that pass executions are recorded when decompiling with profiling enabled.
+    void testProfileDecompilation();
+};
@@ -0,0 +1,187 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "StatementPropagationPassTest.h"
+
+
+#define SAMPLE(path)    (m_project.getSettings()->getDataDirectory().absoluteFilePath("samples/" path))
+#define HELLO_X86   SAMPLE("x86/hello")
+
+
+#include "boomerang/core/Settings.h"
+#include "boomerang/db/LowLevelCFG.h"
+#include "boomerang/db/Prog.h"
+#include "boomerang/db/proc/UserProc.h"
+#include "boomerang/passes/PassManager.h"
+#include "boomerang/ssl/RTL.h"
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/ssl/type/IntegerType.h"
+#include "boomerang/visitor/expvisitor/ExpDestCounter.h"
+#include "boomerang/visitor/stmtexpvisitor/StmtDestCounter.h"
+
+
+/// Number of assignments in the chain.
+/// Statement::propagateToThis follows at most 10 definitions per visit,
+/// so a single sweep cannot propagate through the whole chain.
+static const int CHAIN_LENGTH = 25;
+
+
+static SharedExp tmp(const QString &name)
+{
+    return Location::tempOf(Const::get(name));
+}
+
+
+static SharedExp ref(const QString &name, const SharedStmt &def)
+{
+    return RefExp::get(tmp(name), def);
+}
+
+
+/**
+ * Create the following statements in \p proc, in this order:
+ *
+ *   c24 := c23{} + 1
+ *   ...
+ *   c1  := c0{} + 1
+ *   c0  := 1
+ *   v   := d{} + 1
+ *   u   := d{} * z{}
+ *   z   := 0
+ *   d   := (x{-} * 3 + 7) * (y{-} - 2)
+ *
+ * Every definition comes after its uses. d is too complex to be propagated while it is used
+ * twice. It can be propagated into v once u does not use it any more.
+ */
+static void createStatements(UserProc *proc, BasicBlock *bb)
+{
+    std::vector<std::shared_ptr<Assign>> chain(CHAIN_LENGTH);
+    chain[0] = std::make_shared<Assign>(IntegerType::get(32), tmp("c0"), Const::get(1));
+
+    for (int i = 1; i < CHAIN_LENGTH; ++i) {
+        chain[i] = std::make_shared<Assign>(
+            IntegerType::get(32), tmp(QString("c%1").arg(i)),
+            Binary::get(opPlus, ref(QString("c%1").arg(i - 1), chain[i - 1]), Const::get(1)));
+    }
+
+    auto d = std::make_shared<Assign>(
+        IntegerType::get(32), tmp("d"),
+        Binary::get(opMult,
+                    Binary::get(opPlus, Binary::get(opMult, ref("x", nullptr), Const::get(3)),
+                                Const::get(7)),
+                    Binary::get(opMinus, ref("y", nullptr), Const::get(2))));
+    auto z = std::make_shared<Assign>(IntegerType::get(32), tmp("z"), Const::get(0));
+    auto u = std::make_shared<Assign>(IntegerType::get(32), tmp("u"),
+                                      Binary::get(opMult, ref("d", d), ref("z", z)));
+    auto v = std::make_shared<Assign>(IntegerType::get(32), tmp("v"),
+                                      Binary::get(opPlus, ref("d", d), Const::get(1)));
+
+    RTL::StmtList stmts(chain.rbegin(), chain.rend());
+    stmts.insert(stmts.end(), { v, u, z, d });
+
+    std::unique_ptr<RTLList> rtls(new RTLList);
+    rtls->push_back(std::unique_ptr<RTL>(new RTL(bb->getLowAddr(), &stmts)));
+
+    IRFragment *frag = proc->getCFG()->createFragment(FragType::Fall, std::move(rtls), bb);
+    proc->setEntryFragment();
+
+    for (const SharedStmt &s : stmts) {
+        s->setProc(proc);
+        s->setFragment(frag);
+    }
+}
+
+
+/// Propagate like StatementPropagationPass did before it used def-use chains:
+/// Sweep over all statements with use counts from the start of the sweep,
+/// until a sweep does not change anything.
+static void propagateBySweeps(UserProc *proc, int propMaxDepth)
+{
+    bool change = true;
+
+    while (change) {
+        change = false;
+
+        StatementList stmts;
+        proc->getStatements(stmts);
+
+        std::map<SharedExp, int, lessExpStar> destCounts;
+
+        for (const SharedStmt &s : stmts) {
+            ExpDestCounter edc(destCounts);
+            StmtDestCounter sdc(&edc);
+            s->accept(&sdc);
+        }
+
+        for (const SharedStmt &s : stmts) {
+            if (!s->isPhi()) {
+                change |= s->propagateFlagsToThis();
+            }
+        }
+
+        for (const SharedStmt &s : stmts) {
+            if (!s->isPhi()) {
+                change |= s->propagateToThis(propMaxDepth, &destCounts);
+            }
+        }
+    }
+
+    PassManager::get()->executePass(PassID::FragSimplify, proc);
+}
+
+
+void StatementPropagationPassTest::testSameFixpointAsSweeps()
+{
+    QVERIFY(m_project.loadBinaryFile(HELLO_X86));
+    Prog *prog = m_project.getProg();
+
+    BasicBlock *bb1 = prog->getCFG()->createBB(BBType::Fall, createInsns(Address(0x1000), 1));
+    BasicBlock *bb2 = prog->getCFG()->createBB(BBType::Fall, createInsns(Address(0x2000), 1));
+
+    UserProc proc(Address(0x1000), "test", prog->getRootModule());
+    UserProc expected(Address(0x2000), "expected", prog->getRootModule());
+
+    createStatements(&proc, bb1);
+    createStatements(&expected, bb2);
+
+    QVERIFY(PassManager::get()->executePass(PassID::StatementPropagation, &proc));
+    propagateBySweeps(&expected, m_project.getSettings()->propMaxDepth);
+
+    // One execution of the pass reaches the fixpoint
+    QVERIFY(!PassManager::get()->executePass(PassID::StatementPropagation, &proc));
+
+    std::vector<SharedStmt> stmts, expectedStmts;
+    proc.getStatementSnapshot(stmts);
+    expected.getStatementSnapshot(expectedStmts);
+    QCOMPARE(stmts.size(), expectedStmts.size());
+
+    proc.numberStatements();
+    expected.numberStatements();
+
+    for (std::size_t i = 0; i < stmts.size(); ++i) {
+        QCOMPARE(stmts[i]->toString(), expectedStmts[i]->toString());
+    }
+
+    // c24 := 25
+    const SharedExp last = stmts.front()->as<Assign>()->getRight();
+    QVERIFY(last->isIntConst());
+    QCOMPARE(last->access<Const>()->getInt(), CHAIN_LENGTH);
+
+    // u := 0, so d can be propagated into v
+    QCOMPARE(stmts[CHAIN_LENGTH + 1]->as<Assign>()->getRight()->toString(), QString("0"));
+    SharedExp found;
+    QVERIFY(!stmts[CHAIN_LENGTH]->as<Assign>()->getRight()->search(*tmp("d"), found));
+}
+
+
+QTEST_GUILESS_MAIN(StatementPropagationPassTest)
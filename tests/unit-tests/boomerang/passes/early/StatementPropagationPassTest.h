@@ -0,0 +1,27 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+/**
+ * Test the StatementPropagationPass class.
+ */
+class StatementPropagationPassTest : public BoomerangTestWithPlugins
+{
+    Q_OBJECT
+
+private slots:
+    /// Test that a single execution reaches the same fixpoint as repeated sweeps
+    /// over all statements.
+    void testSameFixpointAsSweeps();
+};
@@ -10,6 +10,7 @@
 #include "ExpTest.h"
 
 
+#include "boomerang/passes/PassProfiler.h"
 #include "boomerang/ssl/exp/Const.h"
 #include "boomerang/ssl/exp/Location.h"
 #include "boomerang/ssl/exp/RefExp.h"
@@ -25,6 +26,7 @@
 #include "boomerang/util/LocationSet.h"
 
 #include <map>
+#include <set>
 
 
 Q_DECLARE_METATYPE(LocationSet)
@@ -503,6 +505,56 @@ void ExpTest::testMapOfExp()
 }
 
 
+void ExpTest::testSharedTerminals()
+{
+    QVERIFY(Terminal::get(opPC) == Terminal::get(opPC));
+    QVERIFY(Terminal::get(opPC) != Terminal::get(opNil));
+    QVERIFY(Terminal::get(opPC)->clone() != Terminal::get(opPC));
+    QVERIFY(*Terminal::get(opPC)->clone() == *Terminal::get(opPC));
+
+    // comparing an expression to itself must not depend on its subexpressions
+    SharedExp e = Binary::get(opPlus, Location::regOf(REG_X86_ESP), Terminal::get(opWild));
+    QVERIFY(*e == *e);
+    QVERIFY(!(*e < *e));
+    QVERIFY(!lessExpStar()(e, e));
+}
+
+
+void ExpTest::testTerminalAllocations()
+{
+    // Build 1000 copies of "%flags + %pc"
+    Terminal::get(opPC); // make sure the shared terminals exist
+
+    std::vector<SharedExp> exps;
+    exps.reserve(1000);
+
+    const uint64 allocsBefore = PassProfiler::getNumAllocations();
+
+    for (int i = 0; i < 1000; ++i) {
+        exps.push_back(Binary::get(opPlus, Terminal::get(opFlags), Terminal::get(opPC)));
+    }
+
+    const uint64 numAllocs = PassProfiler::getNumAllocations() - allocsBefore;
+
+    std::set<const Exp *> leaves;
+    for (const SharedExp &e : exps) {
+        leaves.insert(e->getSubExp1().get());
+        leaves.insert(e->getSubExp2().get());
+    }
+
+    // Before terminals were shared, there were 2000 leaves.
+    QCOMPARE(leaves.size(), static_cast<size_t>(2));
+
+#if BOOMERANG_ALLOC_PROFILING && !BOOMERANG_NODE_POOL
+    // One allocation for each Binary; before terminals were shared, this was 3000.
+    QCOMPARE(numAllocs, uint64(1000));
+#else
+    // Allocations are not counted, or nodes are carved from pooled chunks.
+    Q_UNUSED(numAllocs);
+#endif
+}
+
+
 void ExpTest::testList()
 {
     QCOMPARE(Binary::get(opList, Terminal::get(opNil), Terminal::get(opNil))->toString(), QString(""));
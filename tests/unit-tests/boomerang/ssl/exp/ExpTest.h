@@ -99,6 +99,12 @@ private slots:
     /// Test maps of Exp*s; exercises some comparison operators
     void testMapOfExp();
 
+    /// Test that terminals with the same operator share a single node
+    void testSharedTerminals();
+
+    /// Test that building expressions does not allocate new terminals
+    void testTerminalAllocations();
+
     /// Test the opList creating and printing
     void testList();
 
@@ -10,7 +10,10 @@
 #include "ParserTest.h"
 
 
+#include "boomerang/ssl/RTL.h"
 #include "boomerang/ssl/RTLInstDict.h"
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/Terminal.h"
 #include "boomerang/ssl/statements/Statement.h"
 #include "boomerang/util/log/Log.h"
 
@@ -27,4 +30,35 @@ void ParserTest::testRead()
 }
 
 
+void ParserTest::testInstantiateRTL()
+{
+    RTLInstDict d(false);
+    QVERIFY(d.readSSLFile(BOOMERANG_TEST_BASE "share/boomerang/ssl/x86.ssl"));
+
+    QCOMPARE(d.getTemplateID("INCREG32", 2), -1);
+    QCOMPARE(d.getTemplateID("NONEXISTENT", 0), -1);
+
+    const int templateID = d.getTemplateID("INCREG32", 1);
+    QVERIFY(templateID != -1);
+
+    const std::vector<SharedExp> args = { Location::regOf(REG_X86_EAX) };
+
+    std::unique_ptr<RTL> byID   = d.instantiateRTL(templateID, Address(0x1000), args);
+    std::unique_ptr<RTL> byName = d.instantiateRTL("INCREG32", Address(0x1000), args);
+
+    QVERIFY(byID != nullptr);
+    QVERIFY(byName != nullptr);
+    QCOMPARE(byID->toString(), byName->toString());
+
+    // all formal parameters must have been replaced
+    const Location param(opParam, Terminal::get(opWild), nullptr);
+    for (const SharedStmt &stmt : *byID) {
+        SharedExp result;
+        QVERIFY(!stmt->search(param, result));
+    }
+
+    QVERIFY(d.instantiateRTL("INCREG32", Address(0x1000), {}) == nullptr);
+}
+
+
 QTEST_GUILESS_MAIN(ParserTest)
@@ -19,4 +19,7 @@ class ParserTest : public BoomerangTest
 
 private slots:
     void testRead();
+
+    /// Test instantiating instruction templates by name and by template ID
+    void testInstantiateRTL();
 };
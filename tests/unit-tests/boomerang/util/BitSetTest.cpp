@@ -0,0 +1,171 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "BitSetTest.h"
+
+
+#include "boomerang/util/BitSet.h"
+
+
+void BitSetTest::testSetReset()
+{
+    BitSet set;
+    QVERIFY(set.none());
+    QVERIFY(!set.test(0));
+    QVERIFY(!set.test(1000));
+
+    set.set(3);
+    set.set(130); // grows the set
+    QVERIFY(set.any());
+    QVERIFY(set.test(3));
+    QVERIFY(set.test(130));
+    QVERIFY(!set.test(4));
+    QVERIFY(!set.test(129));
+
+    set.reset(3);
+    set.reset(5000); // not in the set
+    QVERIFY(!set.test(3));
+    QVERIFY(set.test(130));
+
+    set.clear();
+    QVERIFY(set.none());
+}
+
+
+void BitSetTest::testCompare()
+{
+    BitSet set1, set2(200);
+    QVERIFY(set1 == set2);
+
+    set1.set(5);
+    QVERIFY(set1 != set2);
+
+    set2.set(5);
+    QVERIFY(set1 == set2);
+
+    // sets of different sizes
+    set2.set(150);
+    QVERIFY(set1 != set2);
+    QVERIFY(set2 != set1);
+
+    set2.reset(150);
+    QVERIFY(set1 == set2);
+    QVERIFY(set2 == set1);
+}
+
+
+void BitSetTest::testCount()
+{
+    BitSet set;
+    QCOMPARE(set.count(), size_t(0));
+
+    set.set(0);
+    set.set(63);
+    set.set(64);
+    set.set(300);
+    QCOMPARE(set.count(), size_t(4));
+}
+
+
+void BitSetTest::testMakeUnion()
+{
+    BitSet set1, set2;
+    QVERIFY(!set1.makeUnion(set2));
+
+    set2.set(1);
+    set2.set(100);
+    QVERIFY(set1.makeUnion(set2));
+    QVERIFY(set1.test(1));
+    QVERIFY(set1.test(100));
+    QVERIFY(!set1.makeUnion(set2));
+
+    set1.set(2);
+    QVERIFY(!set1.makeUnion(set2));
+    QCOMPARE(set1.count(), size_t(3));
+}
+
+
+void BitSetTest::testMakeIsect()
+{
+    BitSet set1, set2;
+    set1.set(1);
+    set1.set(2);
+    set1.set(100);
+    set2.set(2);
+
+    QVERIFY(set1.makeIsect(set2));
+    QVERIFY(!set1.test(1));
+    QVERIFY(set1.test(2));
+    QVERIFY(!set1.test(100));
+    QVERIFY(!set1.makeIsect(set2));
+}
+
+
+void BitSetTest::testMakeDiff()
+{
+    BitSet set1, set2;
+    set1.set(1);
+    set1.set(2);
+    set2.set(2);
+    set2.set(200);
+
+    QVERIFY(set1.makeDiff(set2));
+    QVERIFY(set1.test(1));
+    QVERIFY(!set1.test(2));
+    QVERIFY(!set1.makeDiff(set2));
+}
+
+
+void BitSetTest::testIntersects()
+{
+    BitSet set1, set2;
+    QVERIFY(!set1.intersects(set2));
+
+    set1.set(70);
+    set2.set(71);
+    QVERIFY(!set1.intersects(set2));
+
+    set2.set(70);
+    QVERIFY(set1.intersects(set2));
+}
+
+
+void BitSetTest::testFind()
+{
+    BitSet set;
+    QCOMPARE(set.findFirst(), BitSet::npos);
+
+    set.set(5);
+    set.set(64);
+    set.set(200);
+
+    QCOMPARE(set.findFirst(), size_t(5));
+    QCOMPARE(set.findNext(5), size_t(64));
+    QCOMPARE(set.findNext(64), size_t(200));
+    QCOMPARE(set.findNext(200), BitSet::npos);
+    QCOMPARE(set.findNext(1000), BitSet::npos);
+}
+
+
+void BitSetTest::testForEach()
+{
+    BitSet set;
+    set.set(200);
+    set.set(0);
+    set.set(63);
+    set.set(64);
+
+    std::vector<size_t> elements;
+    set.forEach([&elements](size_t idx) { elements.push_back(idx); });
+
+    QCOMPARE(elements, std::vector<size_t>({ 0, 63, 64, 200 }));
+}
+
+
+QTEST_GUILESS_MAIN(BitSetTest)
@@ -0,0 +1,30 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#pragma once
+
+
+#include "TestUtils.h"
+
+
+class BitSetTest : public BoomerangTest
+{
+    Q_OBJECT
+
+private slots:
+    void testSetReset();
+    void testCompare();
+    void testCount();
+    void testMakeUnion();
+    void testMakeIsect();
+    void testMakeDiff();
+    void testIntersects();
+    void testFind();
+    void testForEach();
+};
@@ -0,0 +1,77 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LocationNumberingTest.h"
+
+
+#include "boomerang/ssl/exp/Location.h"
+#include "boomerang/ssl/exp/RefExp.h"
+#include "boomerang/ssl/statements/Assign.h"
+#include "boomerang/util/LocationNumbering.h"
+
+
+void LocationNumberingTest::testInsert()
+{
+    LocationNumbering numbering;
+    QVERIFY(numbering.isEmpty());
+
+    QCOMPARE(numbering.insert(Location::regOf(REG_X86_ECX)), size_t(0));
+    QCOMPARE(numbering.insert(Location::regOf(REG_X86_EAX)), size_t(1));
+
+    // equal locations get the same index
+    QCOMPARE(numbering.insert(Location::regOf(REG_X86_ECX)), size_t(0));
+    QCOMPARE(numbering.size(), size_t(2));
+
+    QCOMPARE(numbering.getLocation(0)->toString(), QString("r25"));
+    QCOMPARE(numbering.getLocation(1)->toString(), QString("r24"));
+
+    numbering.clear();
+    QVERIFY(numbering.isEmpty());
+    QCOMPARE(numbering.find(Location::regOf(REG_X86_ECX)), LocationNumbering::INVALID);
+}
+
+
+void LocationNumberingTest::testFind()
+{
+    LocationNumbering numbering;
+    QCOMPARE(numbering.find(Location::regOf(REG_X86_EAX)), LocationNumbering::INVALID);
+
+    std::shared_ptr<Assign> as1(new Assign(Location::regOf(REG_X86_ECX), Location::regOf(REG_X86_EDX)));
+    std::shared_ptr<Assign> as2(new Assign(Location::regOf(REG_X86_ECX), Location::regOf(REG_X86_EDX)));
+    as1->setNumber(10);
+    as2->setNumber(20);
+
+    numbering.insert(Location::regOf(REG_X86_ECX));
+    numbering.insert(RefExp::get(Location::regOf(REG_X86_ECX), as1));
+
+    QCOMPARE(numbering.find(Location::regOf(REG_X86_ECX)), size_t(0));
+    QCOMPARE(numbering.find(RefExp::get(Location::regOf(REG_X86_ECX), as1)), size_t(1));
+    QCOMPARE(numbering.find(RefExp::get(Location::regOf(REG_X86_ECX), as2)),
+             LocationNumbering::INVALID);
+}
+
+
+void LocationNumberingTest::testIterate()
+{
+    LocationNumbering numbering;
+    numbering.insert(Location::regOf(REG_X86_EDX));
+    numbering.insert(Location::regOf(REG_X86_EAX));
+    numbering.insert(Location::regOf(REG_X86_ECX));
+
+    // iteration is sorted by location
+    QString actual;
+    for (const auto &[loc, idx] : numbering) {
+        actual += QString("%1:%2 ").arg(loc->toString()).arg(idx);
+    }
+
+    QCOMPARE(actual, QString("r24:1 r25:2 r26:0 "));
+}
+
+
+QTEST_GUILESS_MAIN(LocationNumberingTest)
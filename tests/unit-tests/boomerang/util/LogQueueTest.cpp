@@ -0,0 +1,98 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LogQueueTest.h"
+
+
+#include "boomerang/util/log/LogQueue.h"
+
+#include <thread>
+#include <vector>
+
+
+void LogQueueTest::testCapacity()
+{
+    QCOMPARE(LogQueue(1).getCapacity(), std::size_t(2));
+    QCOMPARE(LogQueue(4).getCapacity(), std::size_t(4));
+    QCOMPARE(LogQueue(5).getCapacity(), std::size_t(8));
+}
+
+
+void LogQueueTest::testPushPop()
+{
+    LogQueue queue(4);
+    QString msg;
+    QVERIFY(!queue.tryPop(msg));
+
+    for (int i = 0; i < 4; ++i) {
+        msg = QString::number(i);
+        QVERIFY(queue.tryPush(msg));
+    }
+
+    // full
+    msg = "4";
+    QVERIFY(!queue.tryPush(msg));
+    QCOMPARE(msg, QString("4"));
+
+    QVERIFY(queue.tryPop(msg));
+    QCOMPARE(msg, QString("0"));
+
+    msg = "4";
+    QVERIFY(queue.tryPush(msg));
+
+    for (int i = 1; i <= 4; ++i) {
+        QVERIFY(queue.tryPop(msg));
+        QCOMPARE(msg, QString::number(i));
+    }
+
+    QVERIFY(!queue.tryPop(msg));
+}
+
+
+void LogQueueTest::testConcurrentPush()
+{
+    const int numThreads   = 4;
+    const int msgPerThread = 10000;
+
+    LogQueue queue(numThreads * msgPerThread);
+    std::vector<std::thread> threads;
+
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&queue, t]() {
+            for (int i = 0; i < msgPerThread; ++i) {
+                QString msg = QString("%1 %2").arg(t).arg(i);
+                queue.tryPush(msg);
+            }
+        });
+    }
+
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    // Messages of each thread must be in order
+    std::vector<int> next(numThreads, 0);
+    QString msg;
+
+    while (queue.tryPop(msg)) {
+        const QStringList parts = msg.split(' ');
+        QCOMPARE(parts.size(), 2);
+
+        const int t = parts[0].toInt();
+        QCOMPARE(parts[1].toInt(), next[t]);
+        next[t]++;
+    }
+
+    for (int t = 0; t < numThreads; ++t) {
+        QCOMPARE(next[t], msgPerThread);
+    }
+}
+
+
+QTEST_GUILESS_MAIN(LogQueueTest)
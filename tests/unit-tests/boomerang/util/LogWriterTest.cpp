@@ -0,0 +1,128 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "LogWriterTest.h"
+
+
+#include "boomerang/util/log/LogWriter.h"
+
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+/// Collects everything written by a LogWriter
+class TestSink
+{
+public:
+    LogWriter::WriteFunc getWriteFunc()
+    {
+        return [this](const QString &batch) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_written += batch;
+        };
+    }
+
+    bool contains(const QString &msg)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_written.contains(msg);
+    }
+
+    QString getWritten()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return m_written;
+    }
+
+private:
+    std::mutex m_mutex;
+    QString m_written;
+};
+
+
+void LogWriterTest::testWaitForWritten()
+{
+    TestSink sink;
+    LogWriter writer(sink.getWriteFunc());
+
+    QString expected;
+    for (int i = 0; i < 1000; ++i) {
+        const QString msg = QString("msg %1\n").arg(i);
+        writer.write(msg);
+        expected += msg;
+    }
+
+    writer.waitForWritten();
+    QCOMPARE(sink.getWritten(), expected);
+
+    // nothing to wait for
+    writer.waitForWritten();
+    QCOMPARE(sink.getWritten(), expected);
+}
+
+
+void LogWriterTest::testConcurrentWaitForWritten()
+{
+    const int numThreads   = 4;
+    const int msgPerThread = 2000;
+
+    TestSink sink;
+    LogWriter writer(sink.getWriteFunc());
+
+    std::vector<std::thread> threads;
+    std::vector<int> numMissing(numThreads, 0);
+
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&writer, &sink, &numMissing, t]() {
+            for (int i = 0; i < msgPerThread; ++i) {
+                const QString msg = QString("[%1 %2]").arg(t).arg(i);
+                writer.write(msg);
+
+                // Like Log::flush after a fatal message
+                if (i % 100 == 0) {
+                    writer.waitForWritten();
+                    if (!sink.contains(msg)) {
+                        numMissing[t]++;
+                    }
+                }
+            }
+        });
+    }
+
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    for (int t = 0; t < numThreads; ++t) {
+        QCOMPARE(numMissing[t], 0);
+    }
+
+    writer.waitForWritten();
+    const QString written = sink.getWritten();
+    QCOMPARE(written.count('['), numThreads * msgPerThread);
+}
+
+
+void LogWriterTest::testDestructor()
+{
+    TestSink sink;
+
+    {
+        LogWriter writer(sink.getWriteFunc());
+        for (int i = 0; i < 10000; ++i) {
+            writer.write("x");
+        }
+    }
+
+    QCOMPARE(sink.getWritten(), QString(10000, 'x'));
+}
+
+
+QTEST_GUILESS_MAIN(LogWriterTest)
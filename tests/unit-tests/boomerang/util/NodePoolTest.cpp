@@ -0,0 +1,140 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "NodePoolTest.h"
+
+
+#include "boomerang/ssl/exp/Binary.h"
+#include "boomerang/ssl/exp/Const.h"
+#include "boomerang/util/NodePool.h"
+
+#include <cstdint>
+#include <cstring>
+#include <set>
+#include <thread>
+#include <vector>
+
+
+void NodePoolTest::testAllocate()
+{
+    const std::size_t sizes[] = { 1, 8, 16, 17, 100, NodePool::MAX_NODE_SIZE,
+                                  NodePool::MAX_NODE_SIZE + 1, 4096 };
+
+    for (std::size_t size : sizes) {
+        void *p = NodePool::allocate(size);
+        QVERIFY(p != nullptr);
+        QCOMPARE(reinterpret_cast<std::uintptr_t>(p) % alignof(std::max_align_t), std::uintptr_t(0));
+
+        std::memset(p, 0xAB, size);
+        NodePool::deallocate(p, size);
+    }
+
+    NodePool::deallocate(nullptr, 16);
+}
+
+
+void NodePoolTest::testReuse()
+{
+    void *p1 = NodePool::allocate(48);
+    NodePool::deallocate(p1, 48);
+
+    // same size class
+    void *p2 = NodePool::allocate(40);
+    QVERIFY(p2 == p1);
+    NodePool::deallocate(p2, 40);
+}
+
+
+void NodePoolTest::testMakeNode()
+{
+    std::shared_ptr<Const> c = makeNode<Const>(42);
+    QCOMPARE(c->getInt(), 42);
+
+    SharedExp b = makeNode<Binary>(opPlus, c, Const::get(1));
+    QCOMPARE(b->simplify()->access<Const>()->getInt(), 43);
+
+    // enable_shared_from_this must still work
+    QVERIFY(c->shared_from_this() == c);
+}
+
+
+void NodePoolTest::testConcurrentAllocate()
+{
+    const int numThreads = 4;
+    const int numNodes   = 10000;
+
+    std::vector<std::vector<void *>> nodes(numThreads);
+    for (int i = 0; i < numNodes; ++i) {
+        nodes[i % numThreads].push_back(NodePool::allocate(32));
+    }
+
+    // free nodes on other threads than the one that allocated them,
+    // and allocate new ones while doing so
+    std::vector<std::thread> threads;
+    for (int t = 0; t < numThreads; ++t) {
+        threads.emplace_back([&nodes, t]() {
+            for (void *&p : nodes[t]) {
+                NodePool::deallocate(p, 32);
+                p = NodePool::allocate(24);
+                std::memset(p, t, 24);
+            }
+        });
+    }
+
+    for (std::thread &t : threads) {
+        t.join();
+    }
+
+    for (int t = 0; t < numThreads; ++t) {
+        for (void *p : nodes[t]) {
+            QCOMPARE(static_cast<unsigned char *>(p)[23], static_cast<unsigned char>(t));
+            NodePool::deallocate(p, 24);
+        }
+    }
+}
+
+
+void NodePoolTest::testFreeOnlyThread()
+{
+    // a size class that is not used by the other tests
+    static constexpr const std::size_t NODE_SIZE = 200;
+    const std::size_t numNodes                   = 16;
+
+    std::set<void *> nodes;
+    for (std::size_t i = 0; i < numNodes; ++i) {
+        nodes.insert(NodePool::allocate(NODE_SIZE));
+    }
+
+    // free the nodes on a thread that never allocates any nodes
+    std::thread([&nodes]() {
+        for (void *p : nodes) {
+            NodePool::deallocate(p, NODE_SIZE);
+        }
+    }).join();
+
+    // The nodes must have been returned to the global pool when the thread exited,
+    // so a new thread gets them back with its first batch.
+    std::size_t numReused = 0;
+    std::thread([&nodes, &numReused]() {
+        std::vector<void *> allocated;
+        for (int i = 0; i < 64; ++i) {
+            allocated.push_back(NodePool::allocate(NODE_SIZE));
+        }
+
+        for (void *p : allocated) {
+            numReused += nodes.count(p);
+            NodePool::deallocate(p, NODE_SIZE);
+        }
+    }).join();
+
+    QCOMPARE(numReused, numNodes);
+}
+
+
+QTEST_GUILESS_MAIN(NodePoolTest)
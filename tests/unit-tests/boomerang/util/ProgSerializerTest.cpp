@@ -0,0 +1,62 @@
+#pragma region License
+/*
+ * This file is part of the Boomerang Decompiler.
+ *
+ * See the file "LICENSE.TERMS" for information on usage and
+ * redistribution of this file, and for a DISCLAIMER OF ALL
+ * WARRANTIES.
+ */
+#pragma endregion License
+#include "ProgSerializerTest.h"
+
+
+#include "boomerang/db/Prog.h"
+#include "boomerang/util/ProgSerializer.h"
+
+#include <QBuffer>
+#include <QDataStream>
+
+
+void ProgSerializerTest::testCorruptCounts()
+{
+    const quint32 tooMany = 0xFFFFFFFF;
+
+    // too many BBs
+    {
+        QByteArray data;
+        {
+            QDataStream out(&data, QIODevice::WriteOnly);
+            out << QString("test") << quint32(0) << quint32(0) << quint32(0) << quint32(0);
+            out << tooMany;
+        }
+
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QDataStream in(&buffer);
+
+        Prog prog("test", &m_project);
+        QVERIFY(!ProgSerializer(in).readDecodedProg(&prog));
+        QCOMPARE(in.status(), QDataStream::ReadCorruptData);
+    }
+
+    // too many instructions in a BB
+    {
+        QByteArray data;
+        {
+            QDataStream out(&data, QIODevice::WriteOnly);
+            out << QString("test") << quint32(0) << quint32(0) << quint32(0) << quint32(0);
+            out << quint32(1) << quint64(0x1000) << true << qint32(0) << tooMany;
+        }
+
+        QBuffer buffer(&data);
+        QVERIFY(buffer.open(QIODevice::ReadOnly));
+        QDataStream in(&buffer);
+
+        Prog prog("test", &m_project);
+        QVERIFY(!ProgSerializer(in).readDecodedProg(&prog));
+        QCOMPARE(in.status(), QDataStream::ReadCorruptData);
+    }
+}
+
+
+QTEST_GUILESS_MAIN(ProgSerializerTest)